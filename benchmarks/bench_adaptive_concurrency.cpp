@@ -0,0 +1,152 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: 2026 Zheng-Bote
+//
+// bench_adaptive_concurrency.cpp - AIMD concurrency against a limited server
+//
+// Starts a simulated releases API (HttpServer on the main thread) that
+// serves at most `capacity` requests concurrently, each taking
+// `service-ms`; requests above the capacity are rejected with 429 like
+// GitHub's secondary rate limit. The same set of jobs is then run through
+// BatchChecker with fixed concurrency limits and with the adaptive AIMD
+// limit. For the adaptive run the limit is sampled every 100 ms, showing
+// how it converges on the server's capacity.
+//
+// Usage:
+//   bench_adaptive_concurrency [capacity] [jobs] [service-ms] [max-limit]
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QTimer>
+#include <iomanip>
+#include <iostream>
+#include <utility>
+#include <vector>
+#include "qt_gh-batch-checker.hpp"
+#include "qt_gh-http-server.hpp"
+
+namespace {
+
+struct RunResult {
+    qint64 elapsedMs = 0;
+    int ok = 0;
+    int failed = 0;
+    int rejected = 0;           ///< 429 responses sent by the server
+    std::vector<int> limits;    ///< Adaptive limit sampled every 100 ms
+};
+
+class SimulatedApi {
+public:
+    SimulatedApi(int capacity, int serviceMs)
+        : m_server([this, capacity, serviceMs](const qtgh::HttpRequest&,
+                                               qtgh::HttpServer::Responder respond) {
+              if (m_active >= capacity) {
+                  ++m_rejected;
+                  respond({429, "application/json", {{"Retry-After", "1"}},
+                           R"({"message":"You have exceeded a secondary rate limit."})"});
+                  return;
+              }
+              ++m_active;
+              QTimer::singleShot(serviceMs, [this, respond] {
+                  --m_active;
+                  respond({200, "application/json", {},
+                           R"({"tag_name":"v1.2.3","published_at":"2026-01-01T00:00:00Z"})"});
+              });
+          }) {}
+
+    bool listen() { return m_server.listen(); }
+    QString baseUrl() const {
+        return QStringLiteral("http://127.0.0.1:%1").arg(m_server.serverPort());
+    }
+    int takeRejected() { return std::exchange(m_rejected, 0); }
+
+private:
+    qtgh::HttpServer m_server;
+    int m_active = 0;
+    int m_rejected = 0;
+};
+
+RunResult run(SimulatedApi& api, int jobs, int fixedLimit,
+              const qtgh::AimdLimiter::Config* adaptive) {
+    RunResult out;
+    qtgh::BatchChecker checker(fixedLimit);
+    qtgh::CheckOptions options;
+    options.apiBaseUrl = api.baseUrl();
+    checker.setOptions(options);
+    if (adaptive)
+        checker.setAdaptiveConcurrency(*adaptive);
+    checker.setResultHandler([&](const qtgh::BatchResult& r) {
+        (r.status == qtgh::BatchStatus::Ok ? out.ok : out.failed) += 1;
+    });
+
+    QTimer sampler;
+    if (adaptive) {
+        QObject::connect(&sampler, &QTimer::timeout, [&] {
+            out.limits.push_back(checker.concurrencyLimit());
+        });
+        sampler.start(100);
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < jobs; ++i)
+        checker.enqueue({QStringLiteral("https://github.com/owner/repo-%1").arg(i), "1.0.0", {}});
+    checker.closeInput();
+    checker.waitForFinished();
+    out.elapsedMs = std::max<qint64>(1, timer.elapsed());
+    out.rejected = api.takeRejected();
+    return out;
+}
+
+void report(const char* name, const RunResult& r, int jobs) {
+    std::cout << std::left << std::setw(14) << name << std::right
+              << std::setw(9) << r.elapsedMs << " ms"
+              << std::setw(9) << jobs * 1000LL / r.elapsedMs << " checks/s"
+              << std::setw(8) << r.ok << " ok"
+              << std::setw(7) << r.failed << " failed"
+              << std::setw(8) << r.rejected << " x 429\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    QCoreApplication app(argc, argv);
+    const int capacity = std::max(1, argc > 1 ? std::atoi(argv[1]) : 16);
+    const int jobs = std::max(1, argc > 2 ? std::atoi(argv[2]) : 4000);
+    const int serviceMs = std::max(1, argc > 3 ? std::atoi(argv[3]) : 20);
+    const int maxLimit = std::max(1, argc > 4 ? std::atoi(argv[4]) : 64);
+
+    SimulatedApi api(capacity, serviceMs);
+    if (!api.listen()) {
+        std::cerr << "listen failed\n";
+        return 1;
+    }
+
+    std::cout << "Server capacity " << capacity << " concurrent requests, " << serviceMs
+              << " ms each (ideal " << capacity * 1000 / serviceMs << " checks/s), " << jobs
+              << " jobs\n\n";
+
+    for (const int fixed : {std::max(1, capacity / 4), capacity, maxLimit}) {
+        const std::string name = "fixed " + std::to_string(fixed);
+        report(name.c_str(), run(api, jobs, fixed, nullptr), jobs);
+    }
+
+    qtgh::AimdLimiter::Config config;
+    config.maxLimit = maxLimit;
+    const RunResult adaptive = run(api, jobs, maxLimit, &config);
+    report("adaptive", adaptive, jobs);
+
+    // Convergence: the limit over time and its mean over the second half
+    std::cout << "\nAdaptive limit every 100 ms:";
+    for (std::size_t i = 0; i < adaptive.limits.size(); ++i)
+        std::cout << (i % 20 == 0 ? "\n  " : " ") << adaptive.limits[i];
+    double mean = 0;
+    const std::size_t half = adaptive.limits.size() / 2;
+    for (std::size_t i = half; i < adaptive.limits.size(); ++i)
+        mean += adaptive.limits[i];
+    if (adaptive.limits.size() > half)
+        mean /= static_cast<double>(adaptive.limits.size() - half);
+    std::cout << "\nMean limit (second half): " << std::fixed << std::setprecision(1) << mean
+              << " for a capacity of " << capacity << "\n";
+
+    return adaptive.failed == 0 ? 0 : 1;
+}
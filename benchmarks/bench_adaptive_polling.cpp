@@ -0,0 +1,181 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: 2026 Zheng-Bote
+//
+// bench_adaptive_polling.cpp - Simulation benchmark for ReleaseScheduler
+//
+// Generates synthetic release histories (Poisson processes with daily to
+// multi-year cadence), then replays one year of sweeps with a fixed polling
+// interval and with the adaptive ReleaseScheduler. Reports the number of
+// requests and the release detection delay per cadence class.
+//
+// Usage:
+//   bench_adaptive_polling [repos-per-class] [fixed-interval-minutes]
+
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "qt_gh-release-scheduler.hpp"
+
+using namespace std::chrono;
+using TimePoint = qtgh::ReleaseScheduler::TimePoint;
+
+namespace {
+
+struct CadenceClass {
+    const char* name;
+    hours meanInterval;
+};
+
+struct SimRepo {
+    int cadence;                        // index into the class table
+    std::vector<TimePoint> releases;    // sorted publication times
+};
+
+struct Tally {
+    std::size_t requests = 0;
+    std::vector<double> delaysHours;
+};
+
+/// Index of the newest release published at or before t (-1 if none)
+int latestAt(const SimRepo& repo, TimePoint t) {
+    auto it = std::upper_bound(repo.releases.begin(), repo.releases.end(), t);
+    return static_cast<int>(it - repo.releases.begin()) - 1;
+}
+
+void recordDetection(const SimRepo& repo, int& detected, int latest, TimePoint now,
+                     TimePoint start, Tally& tally) {
+    for (int i = detected + 1; i <= latest; ++i) {
+        if (repo.releases[static_cast<std::size_t>(i)] >= start)
+            tally.delaysHours.push_back(duration<double, std::ratio<3600>>(
+                now - repo.releases[static_cast<std::size_t>(i)]).count());
+    }
+    detected = std::max(detected, latest);
+}
+
+double mean(const std::vector<double>& v) {
+    double sum = 0;
+    for (double d : v)
+        sum += d;
+    return v.empty() ? 0.0 : sum / static_cast<double>(v.size());
+}
+
+double percentile(std::vector<double> v, double p) {
+    if (v.empty())
+        return 0.0;
+    std::sort(v.begin(), v.end());
+    return v[static_cast<std::size_t>(p * static_cast<double>(v.size() - 1))];
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const int perClass = argc > 1 ? std::atoi(argv[1]) : 200;
+    const minutes fixedInterval{argc > 2 ? std::atoi(argv[2]) : 60};
+
+    const std::vector<CadenceClass> classes = {
+        {"daily",   hours(24)},
+        {"weekly",  hours(24 * 7)},
+        {"monthly", hours(24 * 30)},
+        {"yearly",  hours(24 * 365)},
+        {"dormant", hours(24 * 365 * 5)},
+    };
+
+    const TimePoint start = sys_days{year{2026} / 1 / 1};
+    const TimePoint end   = start + days(365);
+    const TimePoint historyStart = start - days(2 * 365);
+
+    // Synthetic release histories
+    std::mt19937_64 rng(42);
+    std::vector<SimRepo> repos;
+    for (std::size_t c = 0; c < classes.size(); ++c) {
+        std::exponential_distribution<double> gap(1.0 / static_cast<double>(classes[c].meanInterval.count()));
+        for (int i = 0; i < perClass; ++i) {
+            SimRepo repo{static_cast<int>(c), {}};
+            TimePoint t = historyStart;
+            for (;;) {
+                t += duration_cast<seconds>(duration<double, std::ratio<3600>>(gap(rng)));
+                if (t >= end)
+                    break;
+                repo.releases.push_back(t);
+            }
+            repos.push_back(std::move(repo));
+        }
+    }
+
+    // Fixed-interval polling with a random phase per repository
+    std::vector<Tally> fixed(classes.size());
+    std::uniform_int_distribution<long long> phaseDist(0, duration_cast<seconds>(fixedInterval).count() - 1);
+    for (const auto& repo : repos) {
+        Tally& tally = fixed[static_cast<std::size_t>(repo.cadence)];
+        int detected = latestAt(repo, start);
+        for (TimePoint t = start + seconds(phaseDist(rng)); t < end; t += fixedInterval) {
+            ++tally.requests;
+            recordDetection(repo, detected, latestAt(repo, t), t, start, tally);
+        }
+    }
+
+    // Adaptive polling
+    std::vector<Tally> adaptive(classes.size());
+    qtgh::ReleaseScheduler scheduler;
+    QHash<QString, std::size_t> index;
+    std::vector<int> detected(repos.size());
+    for (std::size_t i = 0; i < repos.size(); ++i) {
+        const QString key = QStringLiteral("owner/repo-%1").arg(i);
+        index.insert(key, i);
+        detected[i] = latestAt(repos[i], start);
+        scheduler.addRepo(key, start);
+    }
+
+    const auto cpuStart = steady_clock::now();
+    while (auto due = scheduler.nextDueTime()) {
+        if (*due >= end)
+            break;
+        const TimePoint now = *due;
+        for (const QString& key : scheduler.takeDue(now)) {
+            const std::size_t i = index.value(key);
+            const SimRepo& repo = repos[i];
+            Tally& tally = adaptive[static_cast<std::size_t>(repo.cadence)];
+            ++tally.requests;
+
+            const int latest = latestAt(repo, now);
+            recordDetection(repo, detected[i], latest, now, start, tally);
+            if (latest < 0) {
+                scheduler.recordCheck(key, QStringLiteral("v0.0.0"), now);
+            } else {
+                scheduler.recordCheck(key, QStringLiteral("v%1.0.0").arg(latest), now,
+                                      repo.releases[static_cast<std::size_t>(latest)]);
+            }
+        }
+    }
+    const auto cpuMs = duration_cast<milliseconds>(steady_clock::now() - cpuStart).count();
+
+    std::cout << "Simulated " << repos.size() << " repositories over 365 days, fixed interval "
+              << fixedInterval.count() << " min\n\n";
+    std::cout << std::left << std::setw(10) << "class"
+              << std::right << std::setw(12) << "fixed req" << std::setw(12) << "adapt req"
+              << std::setw(10) << "saved"
+              << std::setw(14) << "fixed mean h" << std::setw(14) << "adapt mean h"
+              << std::setw(13) << "adapt p95 h" << "\n";
+
+    std::size_t totalFixed = 0, totalAdaptive = 0;
+    std::cout << std::fixed << std::setprecision(2);
+    for (std::size_t c = 0; c < classes.size(); ++c) {
+        totalFixed += fixed[c].requests;
+        totalAdaptive += adaptive[c].requests;
+        const double saved = 100.0 * (1.0 - static_cast<double>(adaptive[c].requests)
+                                            / static_cast<double>(std::max<std::size_t>(1, fixed[c].requests)));
+        std::cout << std::left << std::setw(10) << classes[c].name << std::right
+                  << std::setw(12) << fixed[c].requests << std::setw(12) << adaptive[c].requests
+                  << std::setw(9) << saved << "%"
+                  << std::setw(14) << mean(fixed[c].delaysHours)
+                  << std::setw(14) << mean(adaptive[c].delaysHours)
+                  << std::setw(13) << percentile(adaptive[c].delaysHours, 0.95) << "\n";
+    }
+    std::cout << "\nTotal requests: fixed " << totalFixed << ", adaptive " << totalAdaptive
+              << " (" << 100.0 * (1.0 - static_cast<double>(totalAdaptive) / static_cast<double>(totalFixed))
+              << "% fewer); scheduler CPU time " << cpuMs << " ms\n";
+    return 0;
+}
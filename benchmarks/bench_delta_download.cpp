@@ -0,0 +1,162 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: 2026 Zheng-Bote
+//
+// bench_delta_download.cpp - Delta vs. full downloads of a patched asset
+//
+// Generates an asset of `megabytes` MiB and a patch release of it (64
+// scattered 100-byte edits and one 10 KiB insertion), then measures:
+//
+//   manifest    buildBlockManifest() on one thread and on all cores
+//   plan        planDelta() of the old version on one thread and on all cores
+//   full        AssetDownloader fetching the whole new version
+//   delta       DeltaDownloader rebuilding it from the old version
+//
+// The last two run against a local HttpServer with Range support; they
+// print the bytes transferred and the wall time.
+//
+// Usage:
+//   bench_delta_download [megabytes]
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QRandomGenerator>
+#include <QTemporaryDir>
+#include <iomanip>
+#include <iostream>
+#include "qt_gh-delta-download.hpp"
+#include "qt_gh-http-server.hpp"
+
+namespace {
+
+constexpr qint64 MiB = 1024 * 1024;
+
+const uchar* bytes(const QByteArray& data) { return reinterpret_cast<const uchar*>(data.constData()); }
+
+QByteArray randomBytes(qsizetype size, quint32 seed) {
+    QByteArray data(size, Qt::Uninitialized);
+    QRandomGenerator rng(seed);
+    rng.fillRange(reinterpret_cast<quint32*>(data.data()), size / 4);
+    return data;
+}
+
+/// Best of three runs of `work`, in seconds
+template <typename Work>
+double best(Work work) {
+    double seconds = 1e300;
+    for (int round = 0; round < 3; ++round) {
+        QElapsedTimer timer;
+        timer.start();
+        work();
+        seconds = std::min(seconds, timer.nsecsElapsed() / 1e9);
+    }
+    return seconds;
+}
+
+void report(const char* name, const char* what, qint64 size, double seconds) {
+    std::cout << std::left << std::setw(10) << name << std::setw(14) << what << std::right
+              << std::setw(10) << seconds * 1000 << " ms" << std::setw(10) << size / seconds / MiB
+              << " MiB/s\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    QCoreApplication app(argc, argv);
+    const qint64 size = std::max<qint64>(1, argc > 1 ? std::atoll(argv[1]) : 128) * MiB;
+    const unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+
+    const QByteArray v1 = randomBytes(size, 1);
+    QByteArray v2 = v1;
+    QRandomGenerator rng(2);
+    for (int i = 0; i < 64; ++i)
+        v2.replace(rng.bounded(v2.size() - 100), 100, randomBytes(100, 3 + i));
+    v2.insert(v2.size() / 2, randomBytes(10 * 1024, 100));
+
+    std::cout << size / MiB << " MiB, " << cores << " cores\n\n" << std::fixed << std::setprecision(1);
+
+    qtgh::BlockManifest manifest;
+    report("manifest", "1 thread", v2.size(),
+           best([&] { manifest = qtgh::buildBlockManifest(bytes(v2), v2.size(), 4096, 1); }));
+    report("manifest", "all cores", v2.size(),
+           best([&] { manifest = qtgh::buildBlockManifest(bytes(v2), v2.size(), 4096, cores); }));
+    qtgh::BlockPlan plan;
+    report("plan", "1 thread", v1.size(), best([&] { plan = qtgh::planDelta(manifest, bytes(v1), v1.size(), 1); }));
+    report("plan", "all cores", v1.size(),
+           best([&] { plan = qtgh::planDelta(manifest, bytes(v1), v1.size(), cores); }));
+
+    const QByteArray manifestData = manifest.toCbor();
+    qint64 served = 0;
+    qtgh::HttpServer server([&](const qtgh::HttpRequest& req, qtgh::HttpServer::Responder respond) {
+        if (req.path == "/asset.blocksums") {
+            served += manifestData.size();
+            respond({200, "application/cbor", {}, manifestData});
+            return;
+        }
+        const QByteArray range = req.header("range");
+        if (!range.startsWith("bytes=")) {
+            served += v2.size();
+            respond({200, "application/octet-stream", {}, v2});
+            return;
+        }
+        const auto bounds = range.mid(6).split('-');
+        const qint64 first = bounds.value(0).toLongLong();
+        const qint64 last = std::min<qint64>(bounds.value(1).toLongLong(), v2.size() - 1);
+        served += last - first + 1;
+        respond({206, "application/octet-stream",
+                 {{"Content-Range", "bytes " + QByteArray::number(first) + "-" + QByteArray::number(last)
+                                        + "/" + QByteArray::number(v2.size())}},
+                 v2.mid(first, last - first + 1)});
+    });
+    if (!server.listen()) {
+        std::cerr << "listen failed\n";
+        return 1;
+    }
+    const QString asset = QStringLiteral("http://127.0.0.1:%1/asset").arg(server.serverPort());
+    QTemporaryDir dir;
+
+    // Full download
+    {
+        qtgh::AssetDownloader downloader;
+        QFile file(dir.filePath("full.bin"));
+        file.open(QIODevice::WriteOnly);
+        served = 0;
+        QEventLoop loop;
+        QElapsedTimer timer;
+        timer.start();
+        downloader.download(asset, &file, [&](const qtgh::DownloadResult& r) {
+            if (!r.error.isEmpty())
+                std::cerr << "download failed: " << r.error.toStdString() << "\n";
+            loop.quit();
+        });
+        loop.exec();
+        const double seconds = timer.nsecsElapsed() / 1e9;
+        std::cout << "\nfull      " << std::setw(10) << served / double(MiB) << " MiB transferred"
+                  << std::setw(10) << seconds * 1000 << " ms\n";
+    }
+
+    // Delta update of the old version
+    {
+        const QString installed = dir.filePath("installed.bin");
+        QFile file(installed);
+        file.open(QIODevice::WriteOnly);
+        file.write(v1);
+        file.close();
+        qtgh::DeltaDownloader delta;
+        served = 0;
+        QEventLoop loop;
+        qtgh::DeltaResult result;
+        delta.update({asset + ".blocksums", asset, installed, installed}, [&](const qtgh::DeltaResult& r) {
+            result = r;
+            loop.quit();
+        });
+        loop.exec();
+        if (!result.error.isEmpty())
+            std::cerr << "delta failed: " << result.error.toStdString() << "\n";
+        std::cout << "delta     " << std::setw(10) << served / double(MiB) << " MiB transferred"
+                  << std::setw(10) << std::chrono::duration<double, std::milli>(result.elapsed).count()
+                  << " ms  (" << result.rangeRequests << " ranges, manifest "
+                  << result.manifestBytes / 1024.0 << " KiB)\n";
+    }
+    return 0;
+}
@@ -0,0 +1,150 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: 2026 Zheng-Bote
+//
+// bench_download_throttle.cpp - Achieved rates of throttled asset downloads
+//
+// Serves generated files from a local HttpServer and downloads them with
+// AssetDownloader on the same thread:
+//
+//   single      one background download per global rate, sized for
+//               `seconds` of transfer; configured vs. achieved rate
+//   shared      four background downloads under one global rate; total
+//               rate and when the first and the last one finished
+//   yielding    a background download while an interactive guard is held
+//               for the middle third of the transfer
+//
+// Also prints the most bytes that waited in a reply, which stays near the
+// read buffer cap (AssetDownloader::kReadBufferSize) because reads are
+// paused instead of buffered.
+//
+// Usage:
+//   bench_download_throttle [seconds]
+
+#include <QBuffer>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QUrlQuery>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include "qt_gh-asset-downloader.hpp"
+#include "qt_gh-http-server.hpp"
+
+namespace {
+
+constexpr qint64 KiB = 1024;
+constexpr qint64 MiB = 1024 * KiB;
+
+double seconds(std::chrono::nanoseconds d) { return std::chrono::duration<double>(d).count(); }
+
+/// Start `sizes.size()` downloads and run the event loop until all are done
+std::vector<qtgh::DownloadResult> run(qtgh::AssetDownloader& downloader, const QString& base,
+                                      const std::vector<qint64>& sizes,
+                                      const std::function<void()>& started = {}) {
+    std::vector<qtgh::DownloadResult> results;
+    std::vector<std::unique_ptr<QBuffer>> sinks;
+    QEventLoop loop;
+    for (qint64 size : sizes) {
+        sinks.push_back(std::make_unique<QBuffer>());
+        sinks.back()->open(QIODevice::WriteOnly);
+        downloader.download(QStringLiteral("%1/asset?size=%2").arg(base).arg(size), sinks.back().get(),
+                            [&](const qtgh::DownloadResult& r) {
+                                results.push_back(r);
+                                if (results.size() == sizes.size())
+                                    loop.quit();
+                            });
+    }
+    if (started)
+        started();
+    loop.exec();
+    for (const auto& r : results)
+        if (!r.error.isEmpty())
+            std::cerr << "download failed: " << r.error.toStdString() << "\n";
+    return results;
+}
+
+void reportRate(const char* name, qint64 configured, const qtgh::DownloadResult& r) {
+    const double achieved = r.bytes / seconds(r.elapsed);
+    std::cout << std::left << std::setw(10) << name << std::right << std::setw(12);
+    if (configured > 0)
+        std::cout << configured / double(KiB);
+    else
+        std::cout << "unlimited";
+    std::cout << " KiB/s" << std::setw(12) << achieved / KiB << " KiB/s";
+    if (configured > 0)
+        std::cout << std::setw(8) << 100.0 * (achieved - configured) / configured << " %";
+    else
+        std::cout << std::setw(10) << "";
+    std::cout << std::setw(10) << r.peakBuffered / double(KiB) << " KiB peak buffered\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    QCoreApplication app(argc, argv);
+    const double duration = std::max(0.5, argc > 1 ? std::atof(argv[1]) : 3.0);
+
+    qtgh::HttpServer server([](const qtgh::HttpRequest& req, qtgh::HttpServer::Responder respond) {
+        const QUrl url(QString::fromUtf8(req.path));
+        respond({200, "application/octet-stream", {},
+                 QByteArray(QUrlQuery(url).queryItemValue("size").toLongLong(), 'x')});
+    });
+    if (!server.listen()) {
+        std::cerr << "listen failed\n";
+        return 1;
+    }
+    const QString base = QStringLiteral("http://127.0.0.1:%1").arg(server.serverPort());
+    qtgh::AssetDownloader downloader;
+
+    std::cout << "about " << duration << " s per transfer, read buffer "
+              << qtgh::AssetDownloader::kReadBufferSize / KiB << " KiB\n\n"
+              << std::fixed << std::setprecision(1);
+
+    for (qint64 rate : {256 * KiB, 1 * MiB, 4 * MiB, 16 * MiB}) {
+        downloader.throttle().setGlobalRate(rate);
+        const auto r = run(downloader, base, {static_cast<qint64>(rate * duration)});
+        reportRate("single", rate, r.front());
+    }
+    downloader.throttle().setGlobalRate(0);
+    reportRate("single", 0, run(downloader, base, {64 * MiB}).front());
+
+    // Four downloads sharing 2 MiB/s
+    {
+        const qint64 rate = 2 * MiB;
+        downloader.throttle().setGlobalRate(rate);
+        const qint64 each = static_cast<qint64>(rate * duration / 4);
+        QElapsedTimer clock;
+        clock.start();
+        const auto results = run(downloader, base, {each, each, each, each});
+        const double total = 4.0 * each / (clock.nsecsElapsed() / 1e9);
+        double earliest = 1e300, latest = 0;
+        for (const auto& r : results) {
+            earliest = std::min(earliest, seconds(r.elapsed));
+            latest = std::max(latest, seconds(r.elapsed));
+        }
+        std::cout << "\nshared    " << std::setw(12) << rate / double(KiB) << " KiB/s" << std::setw(12)
+                  << total / KiB << " KiB/s total, finished after " << earliest << " - " << latest
+                  << " s\n";
+    }
+
+    // Interactive guard held for the middle third
+    {
+        const qint64 rate = 2 * MiB;
+        downloader.throttle().setGlobalRate(rate);
+        downloader.throttle().setInteractiveShare(0.1);
+        std::optional<qtgh::BandwidthThrottle::InteractiveGuard> guard;
+        const auto third = std::chrono::milliseconds(static_cast<qint64>(duration * 1000 / 3));
+        const auto r = run(downloader, base, {static_cast<qint64>(rate * duration)}, [&] {
+            QTimer::singleShot(third, [&] { guard.emplace(downloader.throttle().yieldToInteractive()); });
+            QTimer::singleShot(2 * third, [&] { guard.reset(); });
+        });
+        // For a third of the planned time only 10 % of the rate: 0.3 * duration longer
+        const double expected = duration + duration / 3 * 0.9;
+        std::cout << "yielding  " << std::setw(12) << rate / double(KiB) << " KiB/s"
+                  << std::setw(12) << r.front().bytes / seconds(r.front().elapsed) / KiB
+                  << " KiB/s, took " << seconds(r.front().elapsed) << " s (about " << expected
+                  << " s expected)\n";
+    }
+    return 0;
+}
@@ -0,0 +1,77 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: 2026 Zheng-Bote
+//
+// bench_offline_fastfail.cpp - Time to failure of checks on an offline host
+//
+// Simulates an offline host by pointing the checks at an unroutable
+// address (TEST-NET-1, 192.0.2.1), where a request only ends at its
+// timeout, the way DNS and connect timeouts stall a check on a laptop
+// without network. The same checks are then run with offline detection
+// (NetworkStatus forced to Offline), which fails them without a request.
+// Also prints what NetworkStatus reports for api.github.com on this host.
+//
+// Usage:
+//   bench_offline_fastfail [checks] [timeout-ms]
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <iomanip>
+#include <iostream>
+#include "qt_gh-network-status.hpp"
+#include "qt_gh-update-checker.hpp"
+
+namespace {
+
+/// Mean time to failure in µs
+double timeToFailure(const qtgh::CheckOptions& options, int checks) {
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < checks; ++i) {
+        try {
+            qtgh::check_github_update(QStringLiteral("https://github.com/owner/repo-%1").arg(i),
+                                      "1.0.0", options);
+        } catch (const std::exception&) {
+        }
+    }
+    return static_cast<double>(timer.nsecsElapsed()) / 1000.0 / checks;
+}
+
+const char* stateName(qtgh::NetworkStatus::State state) {
+    switch (state) {
+    case qtgh::NetworkStatus::State::Online:  return "online";
+    case qtgh::NetworkStatus::State::Offline: return "offline";
+    case qtgh::NetworkStatus::State::Unknown: return "unknown";
+    }
+    return "?";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    QCoreApplication app(argc, argv);
+    const int checks = std::max(1, argc > 1 ? std::atoi(argv[1]) : 5);
+    const int timeoutMs = std::max(1, argc > 2 ? std::atoi(argv[2]) : 5000);
+
+    std::cout << "NetworkStatus for api.github.com: "
+              << stateName(qtgh::NetworkStatus::state(QUrl("https://api.github.com"))) << "\n"
+              << checks << " checks against an unroutable address, " << timeoutMs
+              << " ms request timeout\n\n"
+              << std::fixed << std::setprecision(1);
+
+    qtgh::CheckOptions options;
+    options.apiBaseUrl = QStringLiteral("http://192.0.2.1");
+    options.timeout = std::chrono::milliseconds(timeoutMs);
+    options.offlineFastFail = false;
+    const double waiting = timeToFailure(options, checks);
+    std::cout << std::left << std::setw(20) << "waiting for network" << std::right
+              << std::setw(14) << waiting / 1000.0 << " ms per check\n";
+
+    qtgh::NetworkStatus::setOverride(qtgh::NetworkStatus::State::Offline);
+    options.offlineFastFail = true;
+    const double fastFail = timeToFailure(options, checks * 1000);
+    std::cout << std::left << std::setw(20) << "offline detection" << std::right
+              << std::setw(14) << fastFail / 1000.0 << " ms per check\n"
+              << "\nTime to failure reduced " << std::setprecision(0) << waiting / fastFail
+              << "x\n";
+    return 0;
+}
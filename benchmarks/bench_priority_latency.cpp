@@ -0,0 +1,142 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: 2026 Zheng-Bote
+//
+// bench_priority_latency.cpp - Interactive latency under a background sweep
+//
+// Starts a local releases API (HttpServer on the main thread) that answers
+// every request after `service-ms`, then saturates a BatchChecker with
+// `background` sweep jobs. While the sweep runs, an interactive check is
+// submitted every `interval-ms` and its latency (enqueue to result) is
+// recorded. The same load is run three times:
+//
+//   fifo        interactive jobs queued as Background (no priorities)
+//   priority    BatchPriority::Interactive, preemption off
+//   preemptive  BatchPriority::Interactive, preemption on (default)
+//
+// Usage:
+//   bench_priority_latency [background] [slots] [service-ms] [interval-ms]
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QTimer>
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+#include "qt_gh-batch-checker.hpp"
+#include "qt_gh-http-server.hpp"
+
+namespace {
+
+struct RunResult {
+    qint64 elapsedMs = 0;
+    int failed = 0;
+    quint64 preemptions = 0;
+    std::vector<qint64> latencies;      ///< Interactive latencies in µs
+};
+
+qint64 percentile(std::vector<qint64> values, double p) {
+    if (values.empty())
+        return 0;
+    std::sort(values.begin(), values.end());
+    const auto index = static_cast<std::size_t>(p * static_cast<double>(values.size() - 1));
+    return values[index];
+}
+
+RunResult run(const QString& baseUrl, int background, int slots, int intervalMs,
+              bool usePriority, bool preemption) {
+    RunResult out;
+    qtgh::BatchChecker checker(slots);
+    qtgh::CheckOptions options;
+    options.apiBaseUrl = baseUrl;
+    checker.setOptions(options);
+    checker.setPreemption(preemption);
+
+    QElapsedTimer clock;
+    clock.start();
+    QHash<QString, qint64> submitted;
+    int backgroundLeft = background;
+    checker.setResultHandler([&](const qtgh::BatchResult& r) {
+        if (r.status != qtgh::BatchStatus::Ok)
+            ++out.failed;
+        if (submitted.contains(r.job.repoUrl))
+            out.latencies.push_back(clock.nsecsElapsed() / 1000 - submitted.take(r.job.repoUrl));
+        else
+            --backgroundLeft;
+    });
+
+    for (int i = 0; i < background; ++i)
+        checker.enqueue({QStringLiteral("https://github.com/sweep/repo-%1").arg(i), "1.0.0", {}});
+
+    // Interactive checks arrive while the sweep is running
+    QTimer interactive;
+    int next = 0;
+    QObject::connect(&interactive, &QTimer::timeout, [&] {
+        if (backgroundLeft <= slots) {
+            interactive.stop();
+            checker.closeInput();
+            return;
+        }
+        qtgh::BatchJob job{QStringLiteral("https://github.com/user/click-%1").arg(next++), "1.0.0",
+                           {}};
+        if (usePriority)
+            job.priority = qtgh::BatchPriority::Interactive;
+        submitted.insert(job.repoUrl, clock.nsecsElapsed() / 1000);
+        checker.enqueue(std::move(job));
+    });
+    interactive.start(intervalMs);
+
+    checker.waitForFinished();
+    out.elapsedMs = std::max<qint64>(1, clock.elapsed());
+    out.preemptions = checker.preemptions();
+    return out;
+}
+
+void report(const char* name, const RunResult& r, int background) {
+    std::cout << std::left << std::setw(12) << name << std::right
+              << std::setw(6) << r.latencies.size() << " checks"
+              << std::setw(10) << percentile(r.latencies, 0.5) / 1000.0 << " ms p50"
+              << std::setw(10) << percentile(r.latencies, 0.99) / 1000.0 << " ms p99"
+              << std::setw(10) << percentile(r.latencies, 1.0) / 1000.0 << " ms max"
+              << std::setw(8) << background * 1000LL / r.elapsedMs << " sweep/s"
+              << std::setw(6) << r.preemptions << " preempted"
+              << (r.failed ? "  FAILURES" : "") << "\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    QCoreApplication app(argc, argv);
+    const int background = std::max(1, argc > 1 ? std::atoi(argv[1]) : 2000);
+    const int slots = std::max(1, argc > 2 ? std::atoi(argv[2]) : 8);
+    const int serviceMs = std::max(1, argc > 3 ? std::atoi(argv[3]) : 50);
+    const int intervalMs = std::max(1, argc > 4 ? std::atoi(argv[4]) : 100);
+
+    qtgh::HttpServer api([serviceMs](const qtgh::HttpRequest&, qtgh::HttpServer::Responder respond) {
+        QTimer::singleShot(serviceMs, [respond] {
+            respond({200, "application/json", {},
+                     R"({"tag_name":"v1.2.3","published_at":"2026-01-01T00:00:00Z"})"});
+        });
+    });
+    if (!api.listen()) {
+        std::cerr << "listen failed\n";
+        return 1;
+    }
+    const QString baseUrl = QStringLiteral("http://127.0.0.1:%1").arg(api.serverPort());
+
+    std::cout << background << " background checks over " << slots << " slots, " << serviceMs
+              << " ms per request, one interactive check every " << intervalMs << " ms\n\n"
+              << std::fixed << std::setprecision(1);
+
+    int failed = 0;
+    const RunResult fifo = run(baseUrl, background, slots, intervalMs, false, false);
+    report("fifo", fifo, background);
+    const RunResult priority = run(baseUrl, background, slots, intervalMs, true, false);
+    report("priority", priority, background);
+    const RunResult preemptive = run(baseUrl, background, slots, intervalMs, true, true);
+    report("preemptive", preemptive, background);
+    for (const RunResult* r : {&fifo, &priority, &preemptive})
+        failed += r->failed;
+
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,115 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: 2026 Zheng-Bote
+//
+// bench_proxy_throughput.cpp - Throughput of CachingProxy cache hits
+//
+// Starts a fake upstream (HttpServer answering every releases request with
+// a fixed JSON body and ETag) and a CachingProxy in front of it, both on
+// the main thread. Worker threads then issue keep-alive GET requests for
+// a set of repositories over plain sockets and the benchmark reports the
+// requests per second the single-threaded proxy answers from its cache.
+//
+// Usage:
+//   bench_proxy_throughput [workers] [requests-per-worker] [repos]
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QTcpSocket>
+#include <atomic>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include "qt_gh-caching-proxy.hpp"
+
+/// Issue `count` keep-alive requests and return the number of 200 responses
+static int runWorker(quint16 port, int count, int repos, int seed) {
+    QTcpSocket socket;
+    socket.connectToHost(QHostAddress::LocalHost, port);
+    if (!socket.waitForConnected(5000))
+        return 0;
+
+    int ok = 0;
+    QByteArray buffer;
+    for (int i = 0; i < count; ++i) {
+        const int repo = (seed + i) % repos;
+        socket.write("GET /repos/owner/repo-" + QByteArray::number(repo)
+                     + "/releases/latest HTTP/1.1\r\nHost: proxy\r\n\r\n");
+
+        // Read one response: header block + Content-Length body
+        qsizetype headerEnd = -1;
+        qsizetype length = 0;
+        for (;;) {
+            if (headerEnd < 0 && (headerEnd = buffer.indexOf("\r\n\r\n")) >= 0) {
+                const qsizetype at = buffer.indexOf("Content-Length: ");
+                length = buffer.mid(at + 16, buffer.indexOf("\r\n", at) - at - 16).toLongLong();
+            }
+            if (headerEnd >= 0 && buffer.size() >= headerEnd + 4 + length)
+                break;
+            if (!socket.waitForReadyRead(5000))
+                return ok;
+            buffer.append(socket.readAll());
+        }
+        if (buffer.startsWith("HTTP/1.1 200"))
+            ++ok;
+        buffer.remove(0, headerEnd + 4 + length);
+    }
+    return ok;
+}
+
+int main(int argc, char** argv) {
+    QCoreApplication app(argc, argv);
+    const int workers = argc > 1 ? std::atoi(argv[1]) : 8;
+    const int perWorker = argc > 2 ? std::atoi(argv[2]) : 20000;
+    const int repos = std::max(1, argc > 3 ? std::atoi(argv[3]) : 100);
+
+    // Fake upstream
+    int upstreamRequests = 0;
+    qtgh::HttpServer upstream([&](const qtgh::HttpRequest& req, qtgh::HttpServer::Responder respond) {
+        ++upstreamRequests;
+        if (req.header("if-none-match") == "\"v1\"") {
+            respond({304, {}, {{"ETag", "\"v1\""}}, {}});
+            return;
+        }
+        respond({200, "application/json", {{"ETag", "\"v1\""}},
+                 R"({"tag_name":"v1.2.3","published_at":"2026-01-01T00:00:00Z"})"});
+    });
+    if (!upstream.listen()) {
+        std::cerr << "upstream listen failed: " << upstream.errorString().toStdString() << "\n";
+        return 1;
+    }
+
+    qtgh::CachingProxy proxy;
+    proxy.setUpstreamBaseUrl(QStringLiteral("http://127.0.0.1:%1").arg(upstream.serverPort()));
+    proxy.setTtl(std::chrono::hours(1));
+    if (!proxy.listen()) {
+        std::cerr << "proxy listen failed: " << proxy.errorString().toStdString() << "\n";
+        return 1;
+    }
+
+    std::atomic<int> done{0};
+    std::atomic<long long> served{0};
+    std::vector<std::thread> pool;
+    QElapsedTimer timer;
+    timer.start();
+    for (int w = 0; w < workers; ++w) {
+        pool.emplace_back([&, w] {
+            served += runWorker(proxy.serverPort(), perWorker, repos, w * 7919);
+            ++done;
+        });
+    }
+    while (done < workers)
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+    const qint64 elapsedMs = std::max<qint64>(1, timer.elapsed());
+    for (auto& t : pool)
+        t.join();
+
+    const auto& stats = proxy.stats();
+    std::cout << "Workers:            " << workers << "\n"
+              << "Requests:           " << stats.requests << " (" << served << " x 200)\n"
+              << "Upstream requests:  " << upstreamRequests << "\n"
+              << "Cache hits:         " << stats.hits << "\n"
+              << "Coalesced:          " << stats.coalesced << "\n"
+              << "Elapsed:            " << elapsedMs << " ms\n"
+              << "Throughput:         " << stats.requests * 1000 / elapsedMs << " req/s\n";
+    return served == static_cast<long long>(workers) * perWorker ? 0 : 1;
+}
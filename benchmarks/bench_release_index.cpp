@@ -0,0 +1,172 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: 2026 Zheng-Bote
+//
+// bench_release_index.cpp - Refresh cost of the incremental release index
+//
+// Starts a fake releases API (HttpServer, listing `releases` releases of
+// about 2 KB each newest first, 100 per page, with ETag and Link headers)
+// and refreshes a ReleaseIndex against it:
+//
+//   full listing   a new index each time: what every sweep costs without one
+//   unchanged      the probe page is answered 304 Not Modified
+//   3 new          three releases published since the last refresh
+//   150 new        more new releases than fit on the probe page
+//
+// Prints requests, response bytes and wall time per refresh (best of
+// `rounds`), then the time of countNewerThan() and latestInSeries() queries.
+//
+// Usage:
+//   bench_release_index [releases] [rounds]
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QUrlQuery>
+#include <iomanip>
+#include <iostream>
+#include "qt_gh-http-server.hpp"
+#include "qt_gh-release-index.hpp"
+
+namespace {
+
+class FakeApi {
+public:
+    explicit FakeApi(int releases) {
+        for (int i = 0; i < releases; ++i)
+            publish();
+    }
+
+    void publish() {
+        const qsizetype n = m_releases.size();
+        const QString tag = QStringLiteral("v%1.%2.%3").arg(n / 400 + 1).arg(n / 20 % 20).arg(n % 20);
+        QJsonObject release{{"id", n + 1}, {"tag_name", tag}, {"name", tag},
+                            {"draft", false}, {"prerelease", n % 17 == 0},
+                            {"published_at", "2026-01-01T00:00:00Z"},
+                            {"body", QString(1500, QLatin1Char('x'))}};
+        release.insert("assets", QJsonArray{QJsonObject{
+            {"name", "source.tar.gz"}, {"size", 123456},
+            {"browser_download_url", "https://github.com/owner/repo/releases/download/" + tag}}});
+        m_releases.append(release);
+    }
+
+    void handle(const qtgh::HttpRequest& req, qtgh::HttpServer::Responder respond) const {
+        const QUrl url(QString::fromUtf8(req.path));
+        const QUrlQuery query(url);
+        const int perPage = query.queryItemValue("per_page").toInt();
+        const int page = query.queryItemValue("page").toInt();
+        const QByteArray etag = QStringLiteral("\"%1-%2-%3\"")
+                                    .arg(m_releases.size()).arg(perPage).arg(page).toUtf8();
+        if (req.header("if-none-match") == etag) {
+            respond({304, {}, {{"ETag", etag}}, {}});
+            return;
+        }
+        QJsonArray list;
+        const qsizetype first = qsizetype(page - 1) * perPage;
+        for (qsizetype k = first; k < first + perPage && k < m_releases.size(); ++k)
+            list.append(m_releases.at(m_releases.size() - 1 - k));
+        QList<QPair<QByteArray, QByteArray>> headers{{"ETag", etag}};
+        if (first + perPage < m_releases.size())
+            headers.append({"Link", QStringLiteral("<%1?per_page=%2&page=%3>; rel=\"next\"")
+                                        .arg(url.path()).arg(perPage).arg(page + 1).toUtf8()});
+        respond({200, "application/json", headers, QJsonDocument(list).toJson(QJsonDocument::Compact)});
+    }
+
+private:
+    QList<QJsonObject> m_releases;
+};
+
+struct Cost {
+    int requests = 0;
+    qint64 bytes = 0;
+    double ms = 1e300;
+};
+
+qtgh::ReleaseIndexRefresh refresh(qtgh::ReleaseIndex& index, double* ms) {
+    qtgh::ReleaseIndexRefresh result;
+    QEventLoop loop;
+    QElapsedTimer timer;
+    timer.start();
+    index.refresh("https://github.com/owner/repo", [&](const qtgh::ReleaseIndexRefresh& r) {
+        result = r;
+        loop.quit();
+    });
+    loop.exec();
+    *ms = timer.nsecsElapsed() / 1e6;
+    if (!result.error.isEmpty())
+        std::cerr << "refresh failed: " << result.error.toStdString() << "\n";
+    return result;
+}
+
+void report(const char* name, const Cost& cost) {
+    std::cout << std::left << std::setw(14) << name << std::right << std::setw(6) << cost.requests
+              << " requests" << std::setw(12) << cost.bytes / 1024.0 << " KiB" << std::setw(10)
+              << cost.ms << " ms\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    QCoreApplication app(argc, argv);
+    const int releases = std::max(1, argc > 1 ? std::atoi(argv[1]) : 1500);
+    const int rounds = std::max(1, argc > 2 ? std::atoi(argv[2]) : 5);
+
+    FakeApi api(releases);
+    qtgh::HttpServer server([&api](const qtgh::HttpRequest& req, qtgh::HttpServer::Responder respond) {
+        api.handle(req, std::move(respond));
+    });
+    if (!server.listen()) {
+        std::cerr << "listen failed\n";
+        return 1;
+    }
+    const QString base = QStringLiteral("http://127.0.0.1:%1").arg(server.serverPort());
+
+    std::cout << releases << " releases, best of " << rounds << " rounds\n\n"
+              << std::fixed << std::setprecision(2);
+
+    auto measure = [&](const char* name, auto&& prepare) {
+        Cost cost;
+        for (int round = 0; round < rounds; ++round) {
+            qtgh::ReleaseIndex index;
+            index.setApiBaseUrl(base);
+            prepare(index);
+            double ms = 0;
+            const auto r = refresh(index, &ms);
+            cost = {r.requests, r.bytes, std::min(cost.ms, ms)};
+        }
+        report(name, cost);
+    };
+
+    measure("full listing", [](qtgh::ReleaseIndex&) {});
+    // Warm indexes: built, then refreshed once so the probe page's ETag is known
+    auto warm = [&](qtgh::ReleaseIndex& index, int publish) {
+        double ms = 0;
+        refresh(index, &ms);
+        refresh(index, &ms);
+        for (int i = 0; i < publish; ++i)
+            api.publish();
+    };
+    measure("unchanged", [&](qtgh::ReleaseIndex& index) { warm(index, 0); });
+    measure("3 new", [&](qtgh::ReleaseIndex& index) { warm(index, 3); });
+    measure("150 new", [&](qtgh::ReleaseIndex& index) { warm(index, 150); });
+
+    // Queries against the history
+    qtgh::ReleaseIndex index;
+    index.setApiBaseUrl(base);
+    double ms = 0;
+    refresh(index, &ms);
+    const auto history = *index.history("owner/repo");
+    constexpr int queries = 1000000;
+    qsizetype sink = 0;
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < queries; ++i)
+        sink += history.countNewerThan(qtgh::SemVer{i % 5 + 1, i % 20, i % 20});
+    const double countNs = timer.nsecsElapsed() / double(queries);
+    timer.restart();
+    for (int i = 0; i < queries; ++i)
+        sink += history.latestInSeries(i % 5 + 1, i % 20).has_value();
+    const double seriesNs = timer.nsecsElapsed() / double(queries);
+    std::cout << "\n" << history.size() << " indexed: countNewerThan " << countNs
+              << " ns, latestInSeries " << seriesNs << " ns (checksum " << sink << ")\n";
+    return 0;
+}
@@ -0,0 +1,83 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: 2026 Zheng-Bote
+//
+// bench_release_parse.cpp - Release JSON: core scanner vs. QJsonDocument
+//
+// Builds a "latest release" response shaped like GitHub's (release notes
+// of `notes-kb` KiB, `assets` asset objects with uploader records) and
+// extracts tag_name / published_at from it `iterations` times, once with
+// QJsonDocument (what parseRelease() used before the Qt-free core) and
+// once with core::extractRelease().
+//
+// Usage:
+//   bench_release_parse [iterations] [assets] [notes-kb]
+
+#include <QElapsedTimer>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include "qt_gh-core.hpp"
+
+namespace {
+
+std::string makeRelease(int assets, int notesKb) {
+    std::string json = R"({"url":"https://api.github.com/repos/owner/repo/releases/1","id":1,)"
+                       R"("author":{"login":"owner","id":2,"type":"User","site_admin":false},)"
+                       R"("tag_name":"v1.2.3","name":"Release 1.2.3","draft":false,)"
+                       R"("prerelease":false,"created_at":"2026-01-01T00:00:00Z",)"
+                       R"("published_at":"2026-01-01T00:00:00Z","assets":[)";
+    for (int i = 0; i < assets; ++i) {
+        if (i)
+            json += ',';
+        json += R"({"id":)" + std::to_string(1000 + i)
+              + R"(,"name":"repo-1.2.3-linux-x86_64-)" + std::to_string(i)
+              + R"(.tar.gz","label":null,"uploader":{"login":"owner","id":2},)"
+                R"("content_type":"application/gzip","state":"uploaded","size":12345678,)"
+                R"("download_count":42,"browser_download_url":"https://github.com/owner/repo/)"
+                R"(releases/download/v1.2.3/asset.tar.gz"})";
+    }
+    json += R"(],"body":")";
+    for (int i = 0; i < notesKb * 16; ++i)
+        json += R"(- Fixed \"issue\" #1234 — see notes\n)";
+    json += R"("})";
+    return json;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const int iterations = std::max(1, argc > 1 ? std::atoi(argv[1]) : 20000);
+    const int assets = std::max(0, argc > 2 ? std::atoi(argv[2]) : 30);
+    const int notesKb = std::max(0, argc > 3 ? std::atoi(argv[3]) : 8);
+
+    const std::string json = makeRelease(assets, notesKb);
+    const QByteArray data = QByteArray::fromStdString(json);
+    std::cout << iterations << " parses of a " << json.size() / 1024 << " KiB release ("
+              << assets << " assets)\n\n"
+              << std::fixed << std::setprecision(2);
+
+    std::size_t sink = 0;
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < iterations; ++i) {
+        const QJsonObject obj = QJsonDocument::fromJson(data).object();
+        sink += obj["tag_name"].toString().size() + obj["published_at"].toString().size();
+    }
+    const double qt = static_cast<double>(timer.nsecsElapsed()) / 1000.0 / iterations;
+
+    timer.restart();
+    for (int i = 0; i < iterations; ++i) {
+        const auto fields = qtgh::core::extractRelease(json);
+        sink += fields->tag->size() + fields->publishedAt->size();
+    }
+    const double core = static_cast<double>(timer.nsecsElapsed()) / 1000.0 / iterations;
+
+    std::cout << std::left << std::setw(16) << "QJsonDocument" << std::right << std::setw(10)
+              << qt << " us/parse\n"
+              << std::left << std::setw(16) << "core scanner" << std::right << std::setw(10)
+              << core << " us/parse\n"
+              << "\nSpeedup " << qt / core << "x (checksum " << sink << ")\n";
+    return 0;
+}
@@ -0,0 +1,132 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: 2026 Zheng-Bote
+//
+// bench_result_formats.cpp - Batch result output: NDJSON vs. CBOR
+//
+// Encodes `results` batch results (mostly successful checks with an
+// origin, some failures, as a large "scan" produces them) once as NDJSON
+// records built like "scan --json" does (QJsonObject per result) and once
+// as a CBOR sequence (writeCborResult(), streamed), then decodes both:
+// NDJSON line by line with QJsonDocument like "merge", CBOR with
+// CborResultReader. Prints output size and encode/decode throughput.
+//
+// Usage:
+//   bench_result_formats [results] [rounds]
+
+#include <QElapsedTimer>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTimeZone>
+#include <iomanip>
+#include <iostream>
+#include "qt_gh-result-cbor.hpp"
+
+namespace {
+
+qtgh::BatchResult makeResult(int i) {
+    qtgh::BatchResult r;
+    r.job = {QStringLiteral("https://github.com/owner-%1/repository-%2").arg(i % 97).arg(i),
+             QStringLiteral("%1.%2.%3").arg(i % 5).arg(i % 13).arg(i % 7),
+             QStringLiteral("third_party/CMakeLists.txt:%1").arg(i % 400 + 1)};
+    if (i % 10 == 0) {
+        r.status = qtgh::BatchStatus::Failed;
+        r.error = QStringLiteral("Repository not found (HTTP 404)");
+        r.cached = i % 20 == 0;
+    } else {
+        r.status = qtgh::BatchStatus::Ok;
+        r.info.latestVersion = QStringLiteral("v%1.%2.0").arg(i % 5 + 1).arg(i % 13);
+        r.info.hasUpdate = i % 3 == 0;
+    }
+    return r;
+}
+
+/// The NDJSON record of "scan --json"
+QByteArray toNdjson(const qtgh::BatchResult& result) {
+    QJsonObject obj;
+    obj["repo"] = result.job.repoUrl;
+    obj["local"] = result.job.localVersion;
+    if (!result.job.origin.isEmpty())
+        obj["origin"] = result.job.origin;
+    if (result.status == qtgh::BatchStatus::Ok) {
+        obj["remote"] = result.info.latestVersion;
+        obj["update"] = result.info.hasUpdate;
+    } else {
+        obj["error"] = result.error;
+        if (result.cached)
+            obj["cached"] = true;
+    }
+    return QJsonDocument(obj).toJson(QJsonDocument::Compact) + '\n';
+}
+
+struct Timing {
+    double encodeUs = 0;   ///< Best round, whole set
+    double decodeUs = 0;
+};
+
+void report(const char* name, qsizetype bytes, const Timing& t, int results) {
+    std::cout << std::left << std::setw(8) << name << std::right << std::setw(10)
+              << bytes / 1024.0 << " KiB" << std::setw(10) << bytes / double(results)
+              << " B/result" << std::setw(10) << results / t.encodeUs << " M/s enc"
+              << std::setw(10) << results / t.decodeUs << " M/s dec\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const int count = std::max(1, argc > 1 ? std::atoi(argv[1]) : 50000);
+    const int rounds = std::max(1, argc > 2 ? std::atoi(argv[2]) : 5);
+
+    QList<qtgh::BatchResult> results;
+    results.reserve(count);
+    for (int i = 0; i < count; ++i)
+        results.append(makeResult(i));
+
+    std::cout << count << " results, best of " << rounds << " rounds\n\n"
+              << std::fixed << std::setprecision(2);
+
+    QByteArray ndjson, cbor;
+    Timing json, binary;
+    json.encodeUs = json.decodeUs = binary.encodeUs = binary.decodeUs = 1e300;
+    std::size_t sink = 0;
+    QElapsedTimer timer;
+    for (int round = 0; round < rounds; ++round) {
+        ndjson.clear();
+        timer.start();
+        for (const auto& result : std::as_const(results))
+            ndjson += toNdjson(result);
+        json.encodeUs = std::min(json.encodeUs, timer.nsecsElapsed() / 1000.0);
+
+        cbor.clear();
+        timer.restart();
+        {
+            QCborStreamWriter writer(&cbor);
+            for (const auto& result : std::as_const(results))
+                qtgh::writeCborResult(writer, result);
+        }
+        binary.encodeUs = std::min(binary.encodeUs, timer.nsecsElapsed() / 1000.0);
+
+        timer.restart();
+        for (const QByteArray& line : ndjson.split('\n')) {
+            if (line.isEmpty())
+                continue;
+            const QJsonObject obj = QJsonDocument::fromJson(line).object();
+            sink += obj["repo"].toString().size() + obj["remote"].toString().size()
+                    + obj["update"].toBool();
+        }
+        json.decodeUs = std::min(json.decodeUs, timer.nsecsElapsed() / 1000.0);
+
+        timer.restart();
+        qtgh::CborResultReader reader(cbor);
+        while (auto result = reader.next())
+            sink += result->job.repoUrl.size() + result->info.latestVersion.size()
+                    + result->info.hasUpdate;
+        binary.decodeUs = std::min(binary.decodeUs, timer.nsecsElapsed() / 1000.0);
+    }
+
+    report("NDJSON", ndjson.size(), json, count);
+    report("CBOR", cbor.size(), binary, count);
+    std::cout << "\nCBOR size " << 100.0 * cbor.size() / ndjson.size() << "% of NDJSON, encode "
+              << json.encodeUs / binary.encodeUs << "x, decode "
+              << json.decodeUs / binary.decodeUs << "x (checksum " << sink << ")\n";
+    return 0;
+}
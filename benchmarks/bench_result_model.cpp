@@ -0,0 +1,136 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: 2026 Zheng-Bote
+//
+// bench_result_model.cpp - Frame stalls while results stream into a model
+//
+// Streams `results` batch results into a ResultTableModel sorted by the
+// latest version, `perTick` results every millisecond as the batch engine
+// delivers them, while a 16 ms "frame" timer measures how late each frame
+// is. A stand-in view reads the visible rows (40 rows x 5 columns) after
+// every model signal, as a view repainting per change would.
+//
+//   per-result  append() + flush() for every result: one insert and one
+//               merge into the sort order per result
+//   coalesced   append() only; the model flushes once per frame
+//
+// Prints frame count, worst and 99th-percentile frame time, frames over
+// 33 ms (two missed frames) and the number of model signals.
+//
+// Usage:
+//   bench_result_model [results] [perTick]
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include "qt_gh-result-model.hpp"
+
+namespace {
+
+qtgh::BatchResult makeResult(int i) {
+    qtgh::BatchResult r;
+    r.job = {QStringLiteral("https://github.com/owner-%1/repository-%2").arg(i % 97).arg(i),
+             QStringLiteral("%1.%2.%3").arg(i % 5).arg(i % 13).arg(i % 7),
+             QStringLiteral("third_party/CMakeLists.txt:%1").arg(i % 400 + 1)};
+    if (i % 10 == 0) {
+        r.status = qtgh::BatchStatus::Failed;
+        r.error = QStringLiteral("Repository not found (HTTP 404)");
+    } else {
+        r.status = qtgh::BatchStatus::Ok;
+        r.info.latestVersion = QStringLiteral("v%1.%2.%3").arg(i % 7 + 1).arg(i % 13).arg(i % 31);
+        r.info.hasUpdate = i % 3 == 0;
+    }
+    return r;
+}
+
+struct Stats {
+    std::vector<double> frameMs;
+    int signals = 0;
+    double totalMs = 0;
+};
+
+Stats run(const QList<qtgh::BatchResult>& results, int perTick, bool coalesce) {
+    qtgh::ResultTableModel model;
+    model.sort(qtgh::ResultTableModel::Latest, Qt::DescendingOrder);
+
+    Stats stats;
+    std::size_t sink = 0;
+    auto repaint = [&] {
+        ++stats.signals;
+        const int rows = std::min(model.rowCount(), 40);
+        for (int row = 0; row < rows; ++row)
+            for (int column = 0; column < qtgh::ResultTableModel::ColumnCount; ++column)
+                sink += model.data(model.index(row, column)).toString().size();
+    };
+    QObject::connect(&model, &QAbstractItemModel::rowsInserted, repaint);
+    QObject::connect(&model, &QAbstractItemModel::dataChanged, repaint);
+    QObject::connect(&model, &QAbstractItemModel::layoutChanged, repaint);
+
+    QElapsedTimer clock;
+    qint64 lastFrame = 0;
+    QTimer frame;
+    frame.setTimerType(Qt::PreciseTimer);
+    QObject::connect(&frame, &QTimer::timeout, [&] {
+        const qint64 now = clock.nsecsElapsed();
+        stats.frameMs.push_back((now - lastFrame) / 1e6);
+        lastFrame = now;
+    });
+
+    qsizetype next = 0;
+    QTimer producer;
+    producer.setTimerType(Qt::PreciseTimer);
+    QObject::connect(&producer, &QTimer::timeout, [&] {
+        for (int k = 0; k < perTick && next < results.size(); ++k) {
+            model.append(results.at(next++));
+            if (!coalesce)
+                model.flush();
+        }
+        if (next == results.size()) {
+            producer.stop();
+            model.flush();
+            QCoreApplication::quit();
+        }
+    });
+
+    clock.start();
+    frame.start(16);
+    producer.start(1);
+    QCoreApplication::exec();
+    stats.totalMs = clock.nsecsElapsed() / 1e6;
+    if (model.rowCount() != results.size() || sink == 0)
+        std::cerr << "unexpected row count " << model.rowCount() << "\n";
+    return stats;
+}
+
+void report(const char* name, Stats stats) {
+    std::sort(stats.frameMs.begin(), stats.frameMs.end());
+    const auto n = stats.frameMs.size();
+    const double worst = n ? stats.frameMs.back() : 0;
+    const double p99 = n ? stats.frameMs[std::min(n - 1, n * 99 / 100)] : 0;
+    const auto late = std::count_if(stats.frameMs.begin(), stats.frameMs.end(),
+                                    [](double ms) { return ms > 33.0; });
+    std::cout << std::left << std::setw(12) << name << std::right << std::setw(8) << n
+              << " frames" << std::setw(10) << worst << " ms max" << std::setw(10) << p99
+              << " ms p99" << std::setw(7) << late << " >33ms" << std::setw(9) << stats.signals
+              << " signals" << std::setw(10) << stats.totalMs << " ms total\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    QCoreApplication app(argc, argv);
+    const int count = std::max(1, argc > 1 ? std::atoi(argv[1]) : 10000);
+    const int perTick = std::max(1, argc > 2 ? std::atoi(argv[2]) : 10);
+
+    QList<qtgh::BatchResult> results;
+    results.reserve(count);
+    for (int i = 0; i < count; ++i)
+        results.append(makeResult(i));
+
+    std::cout << count << " results, " << perTick << " per ms, sorted by latest version\n\n"
+              << std::fixed << std::setprecision(2);
+    report("per-result", run(results, perTick, false));
+    report("coalesced", run(results, perTick, true));
+    return 0;
+}
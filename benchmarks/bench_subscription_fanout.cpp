@@ -0,0 +1,149 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: 2026 Zheng-Bote
+//
+// bench_subscription_fanout.cpp - Load test for SubscriptionService
+//
+// Connects thousands of local clients, each subscribing to a random subset
+// of repositories, then publishes a new release for every repository and
+// measures how long it takes until all subscribers have been notified.
+// Upstream polls are served from a pre-filled ReleaseCache so the test
+// runs without network access.
+//
+// Usage:
+//   bench_subscription_fanout [clients] [repos] [repos-per-client]
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QTimer>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+#include "qt_gh-subscription-service.hpp"
+
+#ifdef Q_OS_UNIX
+#include <sys/resource.h>
+#endif
+
+/// Run the event loop until pred() holds or timeoutMs elapsed
+template <typename Pred>
+static bool waitUntil(Pred pred, int timeoutMs) {
+    QElapsedTimer timer;
+    timer.start();
+    while (!pred()) {
+        if (timer.elapsed() > timeoutMs)
+            return false;
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    QCoreApplication app(argc, argv);
+    const int clients = argc > 1 ? std::atoi(argv[1]) : 2000;
+    const int repos = argc > 2 ? std::atoi(argv[2]) : 100;
+    const int perClient = std::min(repos, argc > 3 ? std::atoi(argv[3]) : 5);
+
+#ifdef Q_OS_UNIX
+    // Each client needs two descriptors (client and server end)
+    rlimit lim{};
+    if (getrlimit(RLIMIT_NOFILE, &lim) == 0) {
+        lim.rlim_cur = std::min<rlim_t>(lim.rlim_max, static_cast<rlim_t>(clients) * 2 + 256);
+        setrlimit(RLIMIT_NOFILE, &lim);
+    }
+#endif
+
+    // Baseline releases for all repositories
+    qtgh::ReleaseCache cache;
+    const QDateTime now = QDateTime::currentDateTimeUtc();
+    for (int r = 0; r < repos; ++r)
+        cache.store(QStringLiteral("owner/repo-%1").arg(r),
+                    {QStringLiteral("v1.0.0"), now, now, now.addDays(1)});
+
+    qtgh::SubscriptionService service;
+    qtgh::CheckOptions options;
+    options.cache = &cache;
+    service.setOptions(options);
+    const QString name = QStringLiteral("qtgh-bench-%1").arg(QCoreApplication::applicationPid());
+    if (!service.listen(name)) {
+        std::cerr << "listen failed: " << service.errorString().toStdString() << "\n";
+        return 1;
+    }
+
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> pick(0, repos - 1);
+    std::vector<std::unique_ptr<qtgh::SubscriptionClient>> pool;
+    std::vector<int> subscribers(static_cast<std::size_t>(repos), 0);
+    qint64 acks = 0;
+    qint64 received = 0;
+
+    QElapsedTimer timer;
+    timer.start();
+    for (int c = 0; c < clients; ++c) {
+        auto client = std::make_unique<qtgh::SubscriptionClient>();
+        client->setMessageHandler([&](const QJsonObject& msg) {
+            if (msg["event"].toString() == "subscribed")
+                ++acks;
+            else if (msg["event"].toString() == "release")
+                ++received;
+        });
+        if (!client->connectToService(name)) {
+            std::cerr << "client " << c << " failed to connect: "
+                      << client->socket().errorString().toStdString() << "\n";
+            return 1;
+        }
+        QSet<int> chosen;
+        while (chosen.size() < perClient)
+            chosen.insert(pick(rng));
+        QStringList urls;
+        for (int r : chosen) {
+            urls.append(QStringLiteral("https://github.com/owner/repo-%1").arg(r));
+            ++subscribers[static_cast<std::size_t>(r)];
+        }
+        client->subscribe(urls);
+        pool.push_back(std::move(client));
+    }
+    if (!waitUntil([&] { return acks == clients; }, 60000)) {
+        std::cerr << "timed out waiting for subscriptions (" << acks << "/" << clients << ")\n";
+        return 1;
+    }
+    // Baseline polls (served from the cache) must complete before new releases count
+    const bool baselined = waitUntil([&] {
+        for (int r = 0; r < repos; ++r) {
+            if (subscribers[static_cast<std::size_t>(r)] > 0
+                && service.latestTag(QStringLiteral("owner/repo-%1").arg(r)).isEmpty())
+                return false;
+        }
+        return true;
+    }, 60000);
+    if (!baselined) {
+        std::cerr << "timed out waiting for baseline polls\n";
+        return 1;
+    }
+    const qint64 subscribeMs = timer.elapsed();
+
+    qint64 expected = 0;
+    for (int n : subscribers)
+        expected += n;
+
+    // Publish a new release for every repository and wait for the fan-out
+    timer.restart();
+    for (int r = 0; r < repos; ++r)
+        service.notifyRelease(QStringLiteral("owner/repo-%1").arg(r),
+                              {QStringLiteral("v1.1.0"), now, now, now.addDays(1)});
+    const bool complete = waitUntil([&] { return received == expected; }, 60000);
+    const qint64 fanoutUs = timer.nsecsElapsed() / 1000;
+
+    const auto& stats = service.stats();
+    std::cout << clients << " clients, " << repos << " repos, " << perClient << " subscriptions each\n"
+              << "  subscribe phase:       " << subscribeMs << " ms\n"
+              << "  tracked repositories:  " << service.repoCount()
+              << " (naive per-client polling: " << expected << " pollers)\n"
+              << "  polls:                 " << stats.polls << " (" << stats.cacheHits
+              << " served from cache)\n"
+              << "  release messages:      " << received << "/" << expected << "\n"
+              << "  fan-out time:          " << fanoutUs << " us ("
+              << (fanoutUs > 0 ? received * 1000000 / fanoutUs : 0) << " messages/s)\n";
+    return complete ? 0 : 1;
+}
@@ -0,0 +1,71 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: 2026 Zheng-Bote
+//
+// fuzz_common.hpp - Shared helpers for the libFuzzer targets
+//
+// TimeBudget turns slow inputs into findings: if one call takes longer
+// than a fixed base plus an allowance per KiB of input, the target aborts
+// and libFuzzer saves the input as a crash reproducer. This catches
+// super-linear behaviour (regex backtracking, quadratic scans) long before
+// libFuzzer's own -timeout would.
+//
+// The budget can be scaled for slow machines or heavier sanitizers with
+// QTGH_FUZZ_TIME_SCALE (e.g. 4 for MSan).
+
+#pragma once
+#include <QByteArray>
+#include <QString>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+namespace qtgh::fuzz {
+
+/// @brief Abort if the enclosing scope exceeds base + perKiB * size
+class TimeBudget {
+public:
+    TimeBudget(const char* what, std::size_t inputSize,
+               std::chrono::microseconds base = std::chrono::milliseconds(5),
+               std::chrono::microseconds perKiB = std::chrono::microseconds(100))
+        : m_what(what),
+          m_size(inputSize),
+          m_budget((base + perKiB * static_cast<long long>(inputSize / 1024)) * scale()),
+          m_start(std::chrono::steady_clock::now()) {}
+
+    TimeBudget(const TimeBudget&) = delete;
+    TimeBudget& operator=(const TimeBudget&) = delete;
+
+    ~TimeBudget() {
+        const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - m_start);
+        if (elapsed > m_budget) {
+            std::fprintf(stderr, "%s: %lld us for %zu input bytes exceeds the budget of %lld us\n",
+                         m_what, static_cast<long long>(elapsed.count()), m_size,
+                         static_cast<long long>(m_budget.count()));
+            std::abort();
+        }
+    }
+
+private:
+    static long long scale() {
+        static const long long s = [] {
+            const char* env = std::getenv("QTGH_FUZZ_TIME_SCALE");
+            const long long v = env ? std::atoll(env) : 1;
+            return v > 0 ? v : 1;
+        }();
+        return s;
+    }
+
+    const char* m_what;
+    std::size_t m_size;
+    std::chrono::microseconds m_budget;
+    std::chrono::steady_clock::time_point m_start;
+};
+
+/// @brief Report a violated invariant and abort
+[[noreturn]] inline void fail(const char* what, const QString& input) {
+    std::fprintf(stderr, "%s (input: %s)\n", what, input.left(200).toUtf8().constData());
+    std::abort();
+}
+
+} // namespace qtgh::fuzz
@@ -0,0 +1,53 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: 2026 Zheng-Bote
+//
+// fuzz_github_url.cpp - libFuzzer target for toGithubApiUrl and toRepoSlug
+//
+// Input: a repository URL as found in manifests (UTF-8).
+// Oracles: no crash, time budget, and the shape of successful results.
+
+#include "fuzz_common.hpp"
+#include "qt_gh-update-checker.hpp"
+
+static const QString kBase = QStringLiteral("https://api.github.com");
+
+extern "C" int LLVMFuzzerInitialize(int*, char***) {
+    // Compile the regular expression outside the timed region
+    (void)qtgh::toGithubApiUrl(QStringLiteral("https://github.com/o/r"), kBase);
+    (void)qtgh::toRepoSlug(QStringLiteral("https://github.com/o/r"));
+    return 0;
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    const QString input = QString::fromUtf8(reinterpret_cast<const char*>(data),
+                                            static_cast<qsizetype>(size));
+
+    try {
+        QString api;
+        {
+            qtgh::fuzz::TimeBudget budget("toGithubApiUrl", size);
+            api = qtgh::toGithubApiUrl(input, kBase);
+        }
+        if (!input.contains(QLatin1StringView("api.github.com"))
+            && (!api.startsWith(kBase + QLatin1StringView("/repos/"))
+                || !api.endsWith(QLatin1StringView("/releases/latest"))))
+            qtgh::fuzz::fail("toGithubApiUrl returned a malformed URL", input);
+    } catch (const std::runtime_error&) {
+    }
+
+    try {
+        QString slug;
+        {
+            qtgh::fuzz::TimeBudget budget("toRepoSlug", size);
+            slug = qtgh::toRepoSlug(input);
+        }
+        const qsizetype slash = slug.indexOf(QLatin1Char('/'));
+        if (slash <= 0)
+            qtgh::fuzz::fail("toRepoSlug returned a slug without owner", input);
+        for (const QChar c : slug)
+            if (c.isSpace())
+                qtgh::fuzz::fail("toRepoSlug returned whitespace", input);
+    } catch (const std::runtime_error&) {
+    }
+    return 0;
+}
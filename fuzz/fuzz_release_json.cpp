@@ -0,0 +1,39 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: 2026 Zheng-Bote
+//
+// fuzz_release_json.cpp - libFuzzer target for release response parsing
+//
+// Input: a raw /releases/latest response body, fed through the same path
+// as check_github_update() and the batch engine (evaluateRelease()).
+// Oracles: no crash, only std::runtime_error escapes, time budget, and a
+// successful result reports the tag it parsed.
+
+#include "fuzz_common.hpp"
+#include "qt_gh-update-checker.hpp"
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size);
+
+extern "C" int LLVMFuzzerInitialize(int*, char***) {
+    // Warm up the JSON parser and date/time code outside the timed region
+    static const char warmup[] = R"({"tag_name":"v1.2.3","published_at":"2024-01-01T00:00:00Z"})";
+    LLVMFuzzerTestOneInput(reinterpret_cast<const uint8_t*>(warmup), sizeof(warmup) - 1);
+    return 0;
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    const QByteArray body = QByteArray::fromRawData(reinterpret_cast<const char*>(data),
+                                                    static_cast<qsizetype>(size));
+    try {
+        qtgh::ReleaseRecord release;
+        qtgh::UpdateInfo info{};
+        {
+            qtgh::fuzz::TimeBudget budget("evaluateRelease", size);
+            release = qtgh::parseRelease(body);
+            info = qtgh::evaluateRelease(body, QStringLiteral("1.0.0"));
+        }
+        if (info.latestVersion != release.tag)
+            qtgh::fuzz::fail("evaluateRelease reported a different tag", release.tag);
+    } catch (const std::runtime_error&) {
+    }
+    return 0;
+}
@@ -0,0 +1,44 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: 2026 Zheng-Bote
+//
+// fuzz_semver.cpp - libFuzzer target for SemVer::parse
+//
+// Input: a release tag or local version string (UTF-8).
+// Oracles: no crash, time budget, both overloads agree, and formatting a
+// parsed version and parsing it again yields the same version.
+
+#include "fuzz_common.hpp"
+#include "qt_gh-update-checker.hpp"
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size);
+
+extern "C" int LLVMFuzzerInitialize(int*, char***) {
+    // Run once outside libFuzzer so Qt state initialized on first use
+    // (locale data for arg()) is not charged to the first input's budget
+    static const char warmup[] = "v1.2.3";
+    LLVMFuzzerTestOneInput(reinterpret_cast<const uint8_t*>(warmup), sizeof(warmup) - 1);
+    return 0;
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    const QString input = QString::fromUtf8(reinterpret_cast<const char*>(data),
+                                            static_cast<qsizetype>(size));
+    qtgh::SemVer version;
+    try {
+        qtgh::fuzz::TimeBudget budget("SemVer::parse", size);
+        version = qtgh::SemVer::parse(QStringView(input));
+    } catch (const std::runtime_error&) {
+        return 0;
+    }
+
+    if (version.major < 0 || version.minor < 0 || version.patch < 0)
+        qtgh::fuzz::fail("negative version component", input);
+    if (qtgh::SemVer::parse(input) != version)
+        qtgh::fuzz::fail("QString and QStringView overloads disagree", input);
+
+    const QString formatted = QStringLiteral("%1.%2.%3")
+        .arg(version.major).arg(version.minor).arg(version.patch);
+    if (qtgh::SemVer::parse(formatted) != version)
+        qtgh::fuzz::fail("formatted version does not round-trip", input);
+    return 0;
+}
@@ -0,0 +1,381 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: 2026 Zheng-Bote
+//
+// qt_gh-asset-downloader.hpp - Rate-limited release asset downloads
+//
+// Downloads release assets (browser_download_url, or the API asset URL
+// with its redirect) into a QIODevice without saturating shared links:
+//
+// - each reply's read buffer is capped (readBufferSize()), so Qt stops
+//   reading from the socket while the buffer is full and TCP flow control
+//   slows the sender down; nothing piles up in memory
+// - data is taken from the reply as token buckets allow: a global one
+//   shared by all background downloads (BandwidthThrottle) and an
+//   optional one per download; both can be changed while downloads run
+// - while interactive traffic is active (an interactive download, or a
+//   BandwidthThrottle::yieldToInteractive() guard held e.g. around a
+//   check a user waits for), background downloads get only a share of
+//   the global rate; interactive downloads are not held back by it
+// - DownloadOptions::range fetches part of an asset with an HTTP Range
+//   request; a server that answers with the whole asset is an error
+//
+// Usage:
+//   #include "qt_gh-asset-downloader.hpp"
+//   qtgh::AssetDownloader downloader;
+//   downloader.throttle().setGlobalRate(2 * 1024 * 1024);     // 2 MiB/s
+//   QFile file("asset.tar.gz");
+//   file.open(QIODevice::WriteOnly);
+//   downloader.download(assetUrl, &file, [](const qtgh::DownloadResult& r) { ... });
+
+#pragma once
+#include "qt_gh-batch-checker.hpp"
+#include "qt_gh-byte-range.hpp"
+#include "qt_gh-token-bucket.hpp"
+#include <QElapsedTimer>
+#include <QIODevice>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QTimer>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace qtgh {
+
+// ---------------------------------------------------------
+// BandwidthThrottle
+// ---------------------------------------------------------
+/// @brief Global rate of background downloads, reduced during interactive traffic
+///
+/// Owned by an AssetDownloader; yieldToInteractive() guards may be taken
+/// by any code on the downloader's thread and must not outlive it.
+///
+/// @example
+///   downloader.throttle().setGlobalRate(1024 * 1024);
+///   {
+///       auto guard = downloader.throttle().yieldToInteractive();
+///       auto info = qtgh::check_github_update(url, version);  // background gets 10 %
+///   }
+class BandwidthThrottle {
+public:
+    /// @brief Keeps background downloads at interactiveShare() while it exists
+    class InteractiveGuard {
+    public:
+        InteractiveGuard() = default;
+        explicit InteractiveGuard(BandwidthThrottle* throttle) : m_throttle(throttle) {
+            if (m_throttle)
+                m_throttle->setInteractive(+1);
+        }
+        InteractiveGuard(InteractiveGuard&& other) noexcept
+            : m_throttle(std::exchange(other.m_throttle, nullptr)) {}
+        InteractiveGuard& operator=(InteractiveGuard&& other) noexcept {
+            if (this != &other) {
+                reset();
+                m_throttle = std::exchange(other.m_throttle, nullptr);
+            }
+            return *this;
+        }
+        ~InteractiveGuard() { reset(); }
+
+        /// @brief Release the guard early
+        void reset() {
+            if (m_throttle)
+                std::exchange(m_throttle, nullptr)->setInteractive(-1);
+        }
+
+    private:
+        BandwidthThrottle* m_throttle = nullptr;
+    };
+
+    /// @brief Total rate of background downloads in bytes per second (0 = unlimited)
+    void setGlobalRate(qint64 bytesPerSecond) {
+        m_rate = std::max<qint64>(0, bytesPerSecond);
+        update();
+    }
+    qint64 globalRate() const { return m_rate; }
+
+    /// @brief Fraction of the global rate background downloads keep during
+    ///   interactive traffic (default 0.1; 0 pauses them)
+    void setInteractiveShare(double share) {
+        m_share = std::clamp(share, 0.0, 1.0);
+        update();
+    }
+    double interactiveShare() const { return m_share; }
+
+    /// @brief Hold background downloads back until the guard is destroyed
+    [[nodiscard]] InteractiveGuard yieldToInteractive() { return InteractiveGuard(this); }
+
+    bool interactiveActive() const { return m_interactive > 0; }
+
+    /// @brief Rate background downloads get now (0 = unlimited)
+    qint64 effectiveRate() const { return m_rate > 0 && interactiveActive() ? backgroundRate() : m_rate; }
+
+    /// @brief Whether background downloads are paused (interactive share 0)
+    bool paused() const { return m_rate > 0 && interactiveActive() && backgroundRate() == 0; }
+
+    /// @brief The bucket background downloads draw from
+    TokenBucket& bucket() { return m_bucket; }
+
+    /// @brief Called when the effective rate changed (e.g. to resume paused reads)
+    void setChangeHandler(std::function<void()> handler) { m_changed = std::move(handler); }
+
+private:
+    qint64 backgroundRate() const { return static_cast<qint64>(static_cast<double>(m_rate) * m_share); }
+
+    void setInteractive(int delta) {
+        m_interactive += delta;
+        update();
+    }
+
+    void update() {
+        // While paused the bucket is not drawn from at all
+        m_bucket.setRate(paused() ? m_rate : effectiveRate());
+        if (m_changed)
+            m_changed();
+    }
+
+    qint64 m_rate = 0;
+    double m_share = 0.1;
+    int m_interactive = 0;
+    TokenBucket m_bucket;
+    std::function<void()> m_changed;
+};
+
+// ---------------------------------------------------------
+// AssetDownloader
+// ---------------------------------------------------------
+/// @brief Per-download settings
+struct DownloadOptions {
+    BatchPriority priority = BatchPriority::Background;     ///< Interactive: not limited by the global rate
+    qint64 rateLimit = 0;                                   ///< Bytes per second for this download (0 = none)
+    std::chrono::milliseconds timeout{0};                   ///< Abort if no data arrives for this long (0 = none)
+    ByteRange range;                                        ///< Only these bytes (length 0 = the whole asset)
+};
+
+/// @brief Outcome of a download
+struct DownloadResult {
+    quint64 id = 0;             ///< Returned by AssetDownloader::download()
+    QString url;
+    qint64 bytes = 0;           ///< Bytes written to the device
+    qint64 peakBuffered = 0;    ///< Most bytes waiting in the reply at once
+    std::chrono::nanoseconds elapsed{0};
+    QString error;              ///< Empty on success
+};
+
+/// @brief Downloads assets into QIODevices at a limited rate
+///
+/// Lives on one thread with an event loop; all members must be called
+/// there. Writes happen as data is taken from the reply; the device must
+/// stay open until the handler ran or the download was cancelled.
+///
+/// @example
+///   qtgh::AssetDownloader downloader;
+///   downloader.throttle().setGlobalRate(512 * 1024);
+///   const auto id = downloader.download(url, &file, done);
+///   downloader.setRateLimit(id, 64 * 1024);             // later, at runtime
+class AssetDownloader {
+public:
+    using Handler = std::function<void(const DownloadResult&)>;
+
+    /// @brief Cap of a reply's read buffer; Qt stops reading the socket when it is full
+    static constexpr qint64 kReadBufferSize = 64 * 1024;
+    /// @brief Most bytes taken from one reply before the next one's turn
+    static constexpr qint64 kSlice = 16 * 1024;
+
+    AssetDownloader() {
+        m_timer.setSingleShot(true);
+        m_timer.setTimerType(Qt::PreciseTimer);
+        QObject::connect(&m_timer, &QTimer::timeout, &m_timer, [this] { pump(); });
+        m_throttle.setChangeHandler([this] { schedule(std::chrono::nanoseconds(0)); });
+    }
+
+    AssetDownloader(const AssetDownloader&) = delete;
+    AssetDownloader& operator=(const AssetDownloader&) = delete;
+
+    ~AssetDownloader() {
+        m_throttle.setChangeHandler({});
+        for (const auto& d : m_downloads) {
+            QObject::disconnect(d->reply, nullptr, nullptr, nullptr);
+            d->reply->abort();
+            d->reply->deleteLater();
+        }
+    }
+
+    /// @brief The global limit shared by this downloader's background downloads
+    BandwidthThrottle& throttle() { return m_throttle; }
+
+    /// @brief Start downloading `url` into `out`
+    /// @return Id for setRateLimit() and cancel(), also passed to `done`
+    quint64 download(const QString& url, QIODevice* out, Handler done, const DownloadOptions& options = {}) {
+        auto d = std::make_shared<Download>();
+        d->result.id = ++m_lastId;
+        d->result.url = url;
+        d->out = out;
+        d->done = std::move(done);
+        d->priority = options.priority;
+        d->bucket.setRate(options.rateLimit);
+        if (options.priority == BatchPriority::Interactive)
+            d->guard = m_throttle.yieldToInteractive();
+
+        QNetworkRequest req = makeGithubRequest(url);
+        req.setRawHeader("Accept", "application/octet-stream");
+        if (options.timeout.count() > 0)
+            req.setTransferTimeout(options.timeout);
+        if (options.range.length > 0) {
+            d->range = options.range;
+            req.setRawHeader("Range", "bytes=" + QByteArray::number(options.range.offset) + "-"
+                                          + QByteArray::number(options.range.offset + options.range.length - 1));
+        }
+        d->reply = m_mgr.get(req);
+        d->reply->setReadBufferSize(kReadBufferSize);
+        d->clock.start();
+        QObject::connect(d->reply, &QNetworkReply::readyRead, d->reply, [this] { schedule({}); });
+        QObject::connect(d->reply, &QNetworkReply::finished, d->reply, [this] { schedule({}); });
+        m_downloads.push_back(std::move(d));
+        return m_lastId;
+    }
+
+    /// @brief Change the rate of a running download (0 = only the global limit)
+    void setRateLimit(quint64 id, qint64 bytesPerSecond) {
+        if (Download* d = find(id)) {
+            d->bucket.setRate(bytesPerSecond);
+            schedule({});
+        }
+    }
+
+    /// @brief Abort a download; its handler runs with error "Cancelled"
+    ///
+    /// Nothing more is written to the device after this returns.
+    void cancel(quint64 id) {
+        if (Download* d = find(id)) {
+            d->cancelled = true;
+            d->result.error = QStringLiteral("Cancelled");
+            d->reply->abort();
+            schedule({});
+        }
+    }
+
+    /// @brief Number of running downloads
+    qsizetype active() const { return static_cast<qsizetype>(m_downloads.size()); }
+
+private:
+    struct Download {
+        DownloadResult result;
+        QNetworkReply* reply = nullptr;
+        QIODevice* out = nullptr;
+        Handler done;
+        BatchPriority priority = BatchPriority::Background;
+        ByteRange range;                             ///< Requested part (length 0 = all)
+        TokenBucket bucket;                          ///< Per-download limit
+        BandwidthThrottle::InteractiveGuard guard;   ///< Held by interactive downloads
+        QElapsedTimer clock;
+        bool cancelled = false;
+    };
+
+    Download* find(quint64 id) {
+        for (const auto& d : m_downloads)
+            if (d->result.id == id)
+                return d.get();
+        return nullptr;
+    }
+
+    /// Run pump() from the event loop after `delay`, unless it runs sooner anyway
+    void schedule(std::chrono::nanoseconds delay) {
+        const auto ms = std::chrono::ceil<std::chrono::milliseconds>(delay);
+        if (!m_timer.isActive() || m_timer.remainingTime() > ms.count())
+            m_timer.start(ms);
+    }
+
+    /// Move data from the replies to the devices as far as the buckets allow
+    void pump() {
+        const auto now = TokenBucket::Clock::now();
+        std::chrono::nanoseconds wait = std::chrono::nanoseconds::max();
+        TokenBucket& global = m_throttle.bucket();
+
+        // Round robin in slices, so one fast reply cannot take the whole budget
+        for (bool progressed = true; progressed;) {
+            progressed = false;
+            for (const auto& d : m_downloads) {
+                const qint64 buffered = d->reply->bytesAvailable();
+                d->result.peakBuffered = std::max(d->result.peakBuffered, buffered);
+                if (buffered <= 0 || !d->result.error.isEmpty())
+                    continue;
+                if (d->result.bytes == 0) {
+                    // Headers are in: an error page or an ignored Range must not reach the device
+                    const int status = d->reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+                    if (status >= 400)
+                        d->result.error = QStringLiteral("Server returned HTTP %1").arg(status);
+                    else if (d->range.length > 0 && status == 200)
+                        d->result.error = QStringLiteral("Server ignored the Range request");
+                    if (!d->result.error.isEmpty()) {
+                        d->reply->abort();
+                        continue;
+                    }
+                }
+                const bool limitedGlobally = d->priority == BatchPriority::Background
+                                             && m_throttle.globalRate() > 0;
+                if (limitedGlobally && m_throttle.paused())
+                    continue;   // resumed through the change handler
+                const qint64 wanted = std::min(buffered, kSlice);
+                qint64 grant = std::min(wanted, d->bucket.available(now));
+                if (limitedGlobally)
+                    grant = std::min(grant, global.available(now));
+                if (grant <= 0) {
+                    auto needed = d->bucket.waitFor(wanted, now);
+                    if (limitedGlobally)
+                        needed = std::max(needed, global.waitFor(wanted, now));
+                    wait = std::min(wait, needed);
+                    continue;
+                }
+                const QByteArray chunk = d->reply->read(grant);
+                d->bucket.consume(chunk.size());
+                if (limitedGlobally)
+                    global.consume(chunk.size());
+                if (d->out->write(chunk) != chunk.size()) {
+                    d->result.error = "Write error: " + d->out->errorString();
+                    d->reply->abort();
+                }
+                d->result.bytes += chunk.size();
+                progressed = true;
+            }
+        }
+
+        // Finish downloads whose data is all written (or that failed)
+        std::vector<std::shared_ptr<Download>> finished;
+        std::erase_if(m_downloads, [&finished](const std::shared_ptr<Download>& d) {
+            const bool drained = d->reply->isFinished() && d->reply->bytesAvailable() == 0;
+            const bool failed = d->reply->isFinished() && d->reply->error() != QNetworkReply::NoError;
+            if (!drained && !failed && d->result.error.isEmpty())
+                return false;
+            finished.push_back(d);
+            return true;
+        });
+        for (const auto& d : finished) {
+            d->reply->deleteLater();
+            d->guard.reset();
+            d->result.elapsed = std::chrono::nanoseconds(d->clock.nsecsElapsed());
+            if (d->cancelled)
+                d->result.error = QStringLiteral("Cancelled");
+            else if (d->result.error.isEmpty() && d->reply->error() != QNetworkReply::NoError)
+                d->result.error = "Network error: " + d->reply->errorString();
+            else if (d->result.error.isEmpty() && d->range.length > 0 && d->result.bytes != d->range.length)
+                d->result.error = QStringLiteral("Range response has %1 bytes instead of %2")
+                                      .arg(d->result.bytes).arg(d->range.length);
+            if (d->done)
+                d->done(d->result);
+        }
+
+        if (wait != std::chrono::nanoseconds::max())
+            schedule(std::max(wait, std::chrono::nanoseconds(std::chrono::milliseconds(1))));
+    }
+
+    BandwidthThrottle m_throttle;
+    QNetworkAccessManager m_mgr;
+    std::vector<std::shared_ptr<Download>> m_downloads;
+    QTimer m_timer;
+    quint64 m_lastId = 0;
+};
+
+} // namespace qtgh
@@ -0,0 +1,781 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: 2026 Zheng-Bote
+//
+// qt_gh-batch-checker.hpp - Asynchronous batch update checks
+//
+// Runs many update checks concurrently over one long-lived
+// QNetworkAccessManager. Jobs can be enqueued while earlier checks are
+// still in flight, which lets producers (e.g. the manifest scanner) feed
+// the checker as a pipeline.
+//
+// The number of concurrent requests is either fixed or adapted to what
+// the server tolerates (setAdaptiveConcurrency(), see AimdLimiter).
+//
+// With a deadline (setDeadline()) the checker gives up when it expires:
+// outstanding requests are aborted and unfinished jobs are reported as
+// timed out, so a caller with a hard time budget gets partial results.
+//
+// Checks are cancelled cooperatively through std::stop_token: per job
+// (BatchJob::stopToken) or all at once (CheckOptions::stopToken). Running
+// requests are aborted at once and reported as cancelled.
+//
+// Interactive jobs (BatchPriority::Interactive, e.g. a user clicked "Check
+// for updates") start ahead of queued background jobs and may preempt a
+// running background request; a starvation limit keeps background sweeps
+// moving under a steady stream of interactive checks.
+//
+// While the host is known to be offline (NetworkStatus) checks fail at
+// once instead of waiting for connect timeouts, or, with
+// OfflinePolicy::Wait, stay queued until connectivity returns.
+//
+// Usage:
+//   #include "qt_gh-batch-checker.hpp"
+//   qtgh::BatchChecker checker(8);
+//   checker.setResultHandler([](const qtgh::BatchResult& r) { ... });
+//   checker.enqueue({"https://github.com/nlohmann/json", "3.0.0"});
+//   checker.closeInput();
+//   checker.waitForFinished();
+
+#pragma once
+#include "qt_gh-concurrency-limiter.hpp"
+#include "qt_gh-network-status.hpp"
+#include "qt_gh-trace.hpp"
+#include "qt_gh-update-checker.hpp"
+#include <QDeadlineTimer>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QHttp1Configuration>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QSet>
+#include <QTimer>
+#include <algorithm>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <stop_token>
+
+namespace qtgh {
+
+// ---------------------------------------------------------
+// Batch Jobs and Results
+// ---------------------------------------------------------
+/// @brief Scheduling class of a batch job
+enum class BatchPriority {
+    Background,   ///< Sweeps and polling; runs when no interactive job waits
+    Interactive   ///< A user is waiting; starts first and may preempt background work
+};
+
+/// @brief What a BatchChecker does with checks while the host is offline
+enum class OfflinePolicy {
+    Fail,   ///< Deliver them as failed at once ("host is offline")
+    Wait    ///< Keep them queued and start them when connectivity returns
+};
+
+/// @brief A single update check submitted to the BatchChecker
+struct BatchJob {
+    QString repoUrl;        ///< GitHub repository URL
+    QString localVersion;   ///< Current version string
+    QString origin;         ///< Free-form caller context (e.g. "CMakeLists.txt:12")
+    std::stop_token stopToken;  ///< Cancels this job only (optional)
+    BatchPriority priority = BatchPriority::Background;
+};
+
+/// @brief Outcome category of a batch check
+enum class BatchStatus {
+    Ok,       ///< Check completed, info is valid
+    Failed,   ///< Check failed, error holds the reason
+    TimedOut, ///< Deadline reached before the check finished
+    Cancelled ///< Stop requested through a stop token
+};
+
+/// @brief Result of a single batch check
+struct BatchResult {
+    BatchJob job;                           ///< The job this result belongs to
+    BatchStatus status = BatchStatus::Failed;
+    UpdateInfo info{};                      ///< Valid if status == Ok
+    QString error;                          ///< Error message if status != Ok
+    bool cached = false;                    ///< Answered by the ReleaseCache, no request sent
+};
+
+// ---------------------------------------------------------
+// Sharding
+// ---------------------------------------------------------
+/// @brief Stable 64-bit FNV-1a hash of a repository slug
+///
+/// Unlike qHash() this is not seeded per process, so every node computes
+/// the same value for the same slug.
+inline quint64 stableSlugHash(const QString& slug) {
+    quint64 hash = 14695981039346656037ULL;
+    for (const char c : slug.toUtf8()) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+/// @brief Assign a key to one of `buckets` shards (jump consistent hash)
+/// @param key Stable key hash (see stableSlugHash())
+/// @param buckets Number of shards (>= 1)
+/// @return Shard index in [0, buckets)
+///
+/// Growing from n to n+1 shards moves only 1/(n+1) of the keys, all of
+/// them to the new shard, so the other nodes' caches stay valid.
+inline int jumpConsistentHash(quint64 key, int buckets) {
+    qint64 b = -1;
+    qint64 j = 0;
+    while (j < buckets) {
+        b = j;
+        key = key * 2862933555777941757ULL + 1;
+        j = static_cast<qint64>(static_cast<double>(b + 1)
+                                * (static_cast<double>(1LL << 31)
+                                   / static_cast<double>((key >> 33) + 1)));
+    }
+    return static_cast<int>(b);
+}
+
+/// @brief One slice of a sharded batch sweep
+///
+/// Repositories are assigned by their normalized slug (toRepoSlug()), so
+/// the assignment does not depend on manifest order, URL spelling or the
+/// other entries of the sweep.
+///
+/// @example
+///   auto shard = qtgh::Shard::parse("2/4");   // second of four shards
+///   if (shard.contains(qtgh::toRepoSlug(url))) checker.enqueue(...);
+struct Shard {
+    int index = 0;      ///< Zero-based shard index
+    int count = 1;      ///< Total number of shards
+
+    /// @brief Parse a one-based "i/n" specification (1 <= i <= n)
+    /// @throws std::runtime_error if the specification is invalid
+    static Shard parse(const QString& spec) {
+        const auto parts = spec.split('/');
+        bool okIndex = false;
+        bool okCount = false;
+        const int i = parts.value(0).toInt(&okIndex);
+        const int n = parts.value(1).toInt(&okCount);
+        if (parts.size() != 2 || !okIndex || !okCount || n < 1 || i < 1 || i > n)
+            throw std::runtime_error(("Invalid shard specification: " + spec).toStdString());
+        return {i - 1, n};
+    }
+
+    /// @brief Whether the repository with this slug belongs to the shard
+    bool contains(const QString& slug) const {
+        return count <= 1 || jumpConsistentHash(stableSlugHash(slug), count) == index;
+    }
+};
+
+// ---------------------------------------------------------
+// BatchChecker
+// ---------------------------------------------------------
+/// @brief Concurrent, event-loop driven update checker
+///
+/// Keeps at most maxInFlight requests (or the adaptive limit) outstanding
+/// and starts queued jobs as earlier ones complete. All methods must be called from the thread
+/// that owns the checker; results are delivered on that thread.
+///
+/// @example
+///   qtgh::BatchChecker checker(16);
+///   checker.setResultHandler([](const qtgh::BatchResult& r) {
+///       if (r.status == qtgh::BatchStatus::Ok && r.info.hasUpdate)
+///           std::cout << r.job.repoUrl.toStdString() << "\n";
+///   });
+///   for (const auto& job : jobs)
+///       checker.enqueue(job);
+///   checker.closeInput();
+///   checker.waitForFinished();
+class BatchChecker {
+public:
+    using ResultHandler = std::function<void(const BatchResult&)>;
+
+    /// @brief Create a checker
+    /// @param maxInFlight Maximum number of concurrent requests (>= 1)
+    explicit BatchChecker(int maxInFlight = 8)
+        : m_maxInFlight(std::max(1, maxInFlight)) {
+        m_deadlineTimer.setSingleShot(true);
+        m_deadlineTimer.setTimerType(Qt::PreciseTimer);
+        QObject::connect(&m_deadlineTimer, &QTimer::timeout, &m_deadlineTimer, [this] { expire(); });
+        m_networkRetry.setSingleShot(true);
+        QObject::connect(&m_networkRetry, &QTimer::timeout, &m_networkRetry, [this] { pump(); });
+    }
+
+    BatchChecker(const BatchChecker&) = delete;
+    BatchChecker& operator=(const BatchChecker&) = delete;
+
+    /// @brief Abort outstanding requests without delivering their results
+    ~BatchChecker() {
+        for (auto* reply : m_mgr.findChildren<QNetworkReply*>()) {
+            QObject::disconnect(reply, nullptr, nullptr, nullptr);
+            reply->abort();
+        }
+    }
+
+    /// @brief Set options shared by all checks (e.g. a ReleaseCache)
+    ///
+    /// Stopping options.stopToken (from any thread) cancels every queued
+    /// and running job; jobs enqueued later are cancelled immediately and
+    /// the checker counts as finished.
+    void setOptions(const CheckOptions& options) {
+        m_stopCallback.reset();
+        m_options = options;
+        if (m_options.stopToken.stop_possible())
+            m_stopCallback.emplace(m_options.stopToken, PostSweep{this});
+    }
+
+    /// @brief Set the callback invoked once per finished job
+    void setResultHandler(ResultHandler handler) { m_handler = std::move(handler); }
+
+    /// @brief Adapt the number of concurrent requests to the server (AIMD)
+    ///
+    /// Replaces maxInFlight by a limit that starts at config.initialLimit
+    /// and moves within [config.minLimit, config.maxLimit]. Requests
+    /// answered with 429 or GitHub's secondary rate limit cut the limit and
+    /// are queued again (up to kMaxOverloadRetries times) instead of failing.
+    void setAdaptiveConcurrency(const AimdLimiter::Config& config) { m_limiter.emplace(config); }
+
+    /// @brief The adaptive limiter, or nullptr if the limit is fixed
+    const AimdLimiter* limiter() const { return m_limiter ? &*m_limiter : nullptr; }
+
+    /// @brief Current maximum number of concurrent requests
+    int concurrencyLimit() const { return m_limiter ? m_limiter->limit() : m_maxInFlight; }
+
+    /// @brief Times an overloaded request is queued again before it fails
+    static constexpr int kMaxOverloadRetries = 3;
+
+    /// @brief Give up on unfinished checks when `deadline` expires
+    ///
+    /// On expiry, outstanding requests are aborted and every queued or
+    /// running job is delivered with BatchStatus::TimedOut; jobs enqueued
+    /// later time out immediately. The checker then counts as finished, so
+    /// waitForFinished() returns even if the input is still open. Results
+    /// delivered before the deadline are unaffected.
+    void setDeadline(QDeadlineTimer deadline) {
+        m_deadline = deadline;
+        if (deadline.isForever()) {
+            m_deadlineTimer.stop();
+            return;
+        }
+        m_deadlineTimer.start(std::chrono::ceil<std::chrono::milliseconds>(
+            deadline.remainingTimeAsDuration()));
+    }
+
+    /// @brief True once the deadline expired
+    bool deadlineExpired() const { return m_expired; }
+
+    /// @brief Let one waiting background job start after this many
+    /// interactive jobs in a row (default 8; 0 = strict priority)
+    void setStarvationLimit(int interactiveStarts) {
+        m_starvationLimit = std::max(0, interactiveStarts);
+    }
+
+    /// @brief Abort running background requests to make room for queued
+    /// interactive jobs (default on)
+    ///
+    /// The most recently started background request is aborted first, as
+    /// it has made the least progress; its job goes back to the head of the
+    /// background queue. A job is preempted at most once, so background
+    /// work still finishes under a steady interactive load.
+    void setPreemption(bool enabled) { m_preemption = enabled; }
+
+    /// @brief Set what happens to checks while the host is offline
+    ///
+    /// Only applies while CheckOptions::offlineFastFail is on (default).
+    /// With OfflinePolicy::Wait, queued jobs start when NetworkStatus
+    /// reports a change, or at the latest a second after connectivity
+    /// returned; a deadline or stop token still ends the wait.
+    void setOfflinePolicy(OfflinePolicy policy) {
+        m_offlinePolicy = policy;
+        pump();
+    }
+
+    /// @brief Number of background requests aborted for interactive jobs
+    quint64 preemptions() const { return m_preemptions; }
+
+    /// @brief Jobs answered by a cached failure, i.e. requests avoided for
+    /// repositories known to fail (see ReleaseCache::lookupFailure())
+    quint64 cachedFailures() const { return m_cachedFailures; }
+
+    /// @brief Queue a job; it starts as soon as a request slot is free
+    ///
+    /// Jobs answered by the ReleaseCache need no request and are delivered
+    /// right away instead of waiting behind network checks. Interactive
+    /// jobs are queued ahead of background jobs (see setStarvationLimit()).
+    void enqueue(BatchJob job) {
+        if (!m_expired && m_deadline.hasExpired())
+            expire();
+        if (isCancelled(job)) {
+            deliver(cancelled(std::move(job)));
+            return;
+        }
+        if (m_expired) {
+            deliver(timedOut(std::move(job)));
+            return;
+        }
+
+        TraceRecorder* trace = TraceRecorder::active();
+        const qint64 enqueued = trace ? TraceRecorder::now() : 0;
+        if (m_options.cache) {
+            CheckTrace times;
+            if (trace) {
+                times.id = trace->nextId();
+                times.enqueued = enqueued;
+            }
+            try {
+                if (deliverCached(job, toRepoSlug(job.repoUrl), trace, times))
+                    return;
+            } catch (const std::exception&) {
+                // Reported by start() like any other invalid job
+            }
+        }
+        const bool interactive = job.priority == BatchPriority::Interactive;
+        queueFor(job).push_back(makeQueued(std::move(job), enqueued, 0));
+        pump();
+        if (interactive)
+            preempt();
+    }
+
+    /// @brief Signal that no further jobs will be enqueued
+    void closeInput() {
+        m_inputClosed = true;
+        maybeFinish();
+    }
+
+    /// @brief Run an event loop until the input is closed and all jobs are done
+    void waitForFinished() {
+        if (isFinished())
+            return;
+        QEventLoop loop;
+        m_loop = &loop;
+        loop.exec();
+        m_loop = nullptr;
+    }
+
+    /// @brief True once the input is closed (or the deadline expired, or
+    /// CheckOptions::stopToken was stopped) and no job is queued or running
+    bool isFinished() const {
+        return (m_inputClosed || m_expired || m_stopped) && pending() == 0 && m_inFlight == 0;
+    }
+
+    /// @brief Number of requests currently in flight
+    int inFlight() const { return m_inFlight; }
+
+    /// @brief Number of jobs waiting for a request slot
+    qsizetype pending() const {
+        return static_cast<qsizetype>(m_interactive.size() + m_background.size());
+    }
+
+    /// @brief Number of QNetworkReply objects alive, including finished
+    /// replies whose deferred deletion is still pending
+    qsizetype openReplies() const { return m_mgr.findChildren<QNetworkReply*>().size(); }
+
+private:
+    /// Per-check timestamps for TraceRecorder spans (ns, 0 = not reached)
+    struct CheckTrace {
+        quint64 id = 0;
+        qint64 enqueued = 0;
+        qint64 started = 0;
+        qint64 connecting = 0;
+        qint64 encrypted = 0;
+        qint64 sent = 0;
+        qint64 headers = 0;
+    };
+
+    /// Runs on the thread calling request_stop(); the sweep itself runs on
+    /// the checker's thread
+    struct PostSweep {
+        BatchChecker* self;
+        void operator()() const {
+            QMetaObject::invokeMethod(&self->m_mgr, [s = self] { s->sweepCancelled(); },
+                                      Qt::QueuedConnection);
+        }
+    };
+
+    struct Queued {
+        BatchJob job;
+        qint64 enqueued = 0;    ///< TraceRecorder::now() when tracing, else 0
+        int attempts = 0;       ///< Earlier attempts answered with an overload response
+        std::shared_ptr<std::stop_callback<PostSweep>> onStop;  ///< Removes a cancelled job early
+        bool preempted = false; ///< Aborted once for an interactive job; not preempted again
+    };
+
+    Queued makeQueued(BatchJob job, qint64 enqueued, int attempts, bool preempted = false) {
+        Queued queued{std::move(job), enqueued, attempts, {}, preempted};
+        if (queued.job.stopToken.stop_possible())
+            queued.onStop = std::make_shared<std::stop_callback<PostSweep>>(queued.job.stopToken,
+                                                                            PostSweep{this});
+        return queued;
+    }
+
+    std::deque<Queued>& queueFor(const BatchJob& job) {
+        return job.priority == BatchPriority::Interactive ? m_interactive : m_background;
+    }
+
+    /// True if the next free slot goes to a waiting background job
+    bool backgroundStarving() const {
+        return !m_background.empty() && m_starvationLimit > 0
+               && m_interactiveStreak >= m_starvationLimit;
+    }
+
+    void pump() {
+        if (m_inFlight < concurrencyLimit() && pending() > 0 && waitingForNetwork())
+            return;
+        while (m_inFlight < concurrencyLimit() && pending() > 0) {
+            const bool interactive = !m_interactive.empty() && !backgroundStarving();
+            std::deque<Queued>& queue = interactive ? m_interactive : m_background;
+            if (!interactive)
+                m_interactiveStreak = 0;
+            else if (!m_background.empty())
+                ++m_interactiveStreak;
+            Queued next = std::move(queue.front());
+            queue.pop_front();
+            start(std::move(next.job), next.enqueued, next.attempts, next.preempted);
+        }
+    }
+
+    /// With OfflinePolicy::Wait, hold the queue while offline and look again
+    /// when the reachability changes or after a second
+    bool waitingForNetwork() {
+        if (m_offlinePolicy != OfflinePolicy::Wait || !m_options.offlineFastFail
+            || !NetworkStatus::isKnownOffline(m_options.apiBaseUrl))
+            return false;
+        if (!m_watchingNetwork)
+            m_watchingNetwork = NetworkStatus::onChange(&m_networkRetry, [this] { pump(); });
+        if (!m_networkRetry.isActive())
+            m_networkRetry.start(std::chrono::seconds(1));
+        return true;
+    }
+
+    /// Abort the youngest preemptible background requests while interactive
+    /// jobs wait for a slot; the finished handler requeues them
+    void preempt() {
+        while (m_preemption && !m_preemptible.empty() && !backgroundStarving()
+               && m_interactive.size() > static_cast<std::size_t>(m_preempted.size())) {
+            QNetworkReply* victim = m_preemptible.back();
+            m_preemptible.pop_back();
+            m_preempted.insert(victim);
+            ++m_preemptions;
+            victim->abort();
+        }
+    }
+
+    void start(BatchJob job, qint64 enqueued, int attempts, bool preempted) {
+        if (isCancelled(job)) {
+            deliver(cancelled(std::move(job)));
+            return;
+        }
+        TraceRecorder* trace = TraceRecorder::active();
+        CheckTrace times;
+        if (trace) {
+            times.id = trace->nextId();
+            times.enqueued = enqueued ? enqueued : TraceRecorder::now();
+            times.started = TraceRecorder::now();
+            trace->async("queue", times.id, times.enqueued, times.started);
+        }
+
+        QString apiUrl;
+        QString slug;
+        try {
+            apiUrl = toGithubApiUrl(job.repoUrl, m_options.apiBaseUrl);
+            if (m_options.cache) {
+                slug = toRepoSlug(job.repoUrl);
+                if (deliverCached(job, slug, trace, times))
+                    return;
+            }
+        } catch (const std::exception& e) {
+            deliver(BatchResult{std::move(job), BatchStatus::Failed, {},
+                                QString::fromUtf8(e.what())});
+            return;
+        }
+        if (m_options.offlineFastFail && NetworkStatus::isKnownOffline(apiUrl)) {
+            deliver(BatchResult{std::move(job), BatchStatus::Failed, {},
+                                QString::fromUtf8(OfflineError().what())});
+            return;
+        }
+
+        ++m_inFlight;
+        const AimdLimiter::Ticket ticket = m_limiter ? m_limiter->ticket() : 0;
+        QElapsedTimer latency;
+        latency.start();
+        // Qt opens at most 6 HTTP/1.1 connections per host by default, which
+        // would cap the concurrency against a caching proxy (HTTP/2 multiplexes)
+        QNetworkRequest request = makeGithubRequest(apiUrl);
+        if (m_options.timeout.count() > 0)
+            request.setTransferTimeout(m_options.timeout);
+        QHttp1Configuration http1;
+        http1.setNumberOfConnectionsPerHost(
+            std::max(6, m_limiter ? m_limiter->config().maxLimit : m_maxInFlight));
+        request.setHttp1Configuration(http1);
+        QNetworkReply* reply = m_mgr.get(request);
+        QTGH_PROBE2(request_start, reply, apiUrl.toUtf8().constData());
+        std::shared_ptr<detail::AbortOnStop> abortOnStop;
+        if (job.stopToken.stop_possible())
+            abortOnStop = std::make_shared<detail::AbortOnStop>(reply, job.stopToken);
+        if (job.priority == BatchPriority::Background && !preempted)
+            m_preemptible.push_back(reply);
+
+        // Connection phases are only observed while tracing
+        std::shared_ptr<CheckTrace> phases;
+        if (trace) {
+            phases = std::make_shared<CheckTrace>(times);
+            auto mark = [phases](qint64 CheckTrace::*field) {
+                return [phases, field] {
+                    if (!((*phases).*field))
+                        (*phases).*field = TraceRecorder::now();
+                };
+            };
+            QObject::connect(reply, &QNetworkReply::socketStartedConnecting, reply,
+                             mark(&CheckTrace::connecting));
+            QObject::connect(reply, &QNetworkReply::encrypted, reply, mark(&CheckTrace::encrypted));
+            QObject::connect(reply, &QNetworkReply::requestSent, reply, mark(&CheckTrace::sent));
+            QObject::connect(reply, &QNetworkReply::metaDataChanged, reply, mark(&CheckTrace::headers));
+        }
+
+        QObject::connect(reply, &QNetworkReply::finished, reply,
+                         [this, reply, slug, phases, ticket, latency, attempts, preempted,
+                          abortOnStop, job = std::move(job)]() mutable {
+            abortOnStop.reset();
+            reply->deleteLater();
+            --m_inFlight;
+            std::erase(m_preemptible, reply);
+            TraceRecorder* trace = phases ? TraceRecorder::active() : nullptr;
+            const qint64 finished = trace ? TraceRecorder::now() : 0;
+            const int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+            const QByteArray data = reply->readAll();
+
+            if (m_preempted.remove(reply) && !m_expired && !isCancelled(job)) {
+                QTGH_PROBE3(request_done, reply, status, -1);
+                m_background.push_front(makeQueued(std::move(job), phases ? phases->enqueued : 0,
+                                                   attempts, true));
+                pump();
+                return;
+            }
+
+            if (m_limiter) {
+                if (isOverloaded(status, *reply, data)) {
+                    m_limiter->onOverload(ticket);
+                    if (attempts < kMaxOverloadRetries && !m_expired && !isCancelled(job)) {
+                        QTGH_PROBE3(request_done, reply, status, -1);
+                        QTGH_PROBE3(retry, reply, attempts + 1, status);
+                        queueFor(job).push_front(makeQueued(std::move(job),
+                                                            phases ? phases->enqueued : 0,
+                                                            attempts + 1, preempted));
+                        pump();
+                        return;
+                    }
+                } else if (reply->error() == QNetworkReply::NoError) {
+                    m_limiter->onSuccess(ticket, std::chrono::nanoseconds(latency.nsecsElapsed()),
+                                         m_inFlight + 1);
+                }
+            }
+
+            BatchResult result;
+            result.job = std::move(job);
+            if (reply->error() != QNetworkReply::NoError) {
+                QTGH_PROBE3(request_done, reply, status, -1);
+                const bool aborted = reply->error() == QNetworkReply::OperationCanceledError;
+                if (aborted && isCancelled(result.job))
+                    result = cancelled(std::move(result.job));
+                else if (aborted && m_expired)
+                    result = timedOut(std::move(result.job));
+                else
+                    result.error = "Network error: " + reply->errorString();
+                if (const auto kind = failureKindForStatus(status); kind && m_options.cache)
+                    m_options.cache->recordFailure(slug, *kind, result.error);
+            } else {
+                try {
+                    QTGH_PROBE3(request_done, reply, status, static_cast<long long>(data.size()));
+                    const qint64 parseStart = trace ? TraceRecorder::now() : 0;
+                    ReleaseRecord release = parseRelease(data);
+                    if (trace)
+                        trace->complete("parse", parseStart, TraceRecorder::now());
+                    if (m_options.cache) {
+                        release.fetchedAt = QDateTime::currentDateTimeUtc();
+                        release.expiresAt = release.fetchedAt.addSecs(m_options.maxAge.count());
+                        m_options.cache->store(slug, release);
+                    }
+                    result.info = compare(release, result.job.localVersion, trace);
+                    result.status = BatchStatus::Ok;
+                } catch (const CheckFailure& e) {
+                    result.error = QString::fromUtf8(e.what());
+                    if (m_options.cache)
+                        m_options.cache->recordFailure(slug, e.kind(), result.error);
+                } catch (const std::exception& e) {
+                    result.error = QString::fromUtf8(e.what());
+                }
+            }
+
+            if (trace)
+                recordPhases(*trace, *phases, finished, result);
+            deliver(result);
+            pump();
+            maybeFinish();
+        });
+    }
+
+    /// 429, or the 403 GitHub sends for its secondary rate limit (unlike the
+    /// primary limit it carries Retry-After or says so in the message)
+    static bool isOverloaded(int status, const QNetworkReply& reply, const QByteArray& body) {
+        return status == 429
+               || (status == 403
+                   && (reply.hasRawHeader("Retry-After") || body.contains("secondary rate limit")));
+    }
+
+    /// Deliver the result for a cached release or failure; false on a cache miss
+    /// @throws std::runtime_error if a version cannot be parsed
+    bool deliverCached(const BatchJob& job, const QString& slug, TraceRecorder* trace,
+                       const CheckTrace& times) {
+        const auto hit = m_options.cache->lookup(slug);
+        if (!hit) {
+            if (auto failure = m_options.cache->lookupFailure(slug)) {
+                QTGH_PROBE1(cache_hit, slug.toUtf8().constData());
+                ++m_cachedFailures;
+                if (trace)
+                    trace->async("check", times.id, times.enqueued, TraceRecorder::now(),
+                                 job.repoUrl + QStringLiteral(" (cached failure)"));
+                deliver(BatchResult{job, BatchStatus::Failed, {}, failure->error, true});
+                return true;
+            }
+            QTGH_PROBE1(cache_miss, slug.toUtf8().constData());
+            return false;
+        }
+        QTGH_PROBE1(cache_hit, slug.toUtf8().constData());
+        BatchResult result{job, BatchStatus::Ok, compare(*hit, job.localVersion, trace), {}, true};
+        if (trace)
+            trace->async("check", times.id, times.enqueued, TraceRecorder::now(),
+                         job.repoUrl + QStringLiteral(" (cache hit)"));
+        deliver(result);
+        return true;
+    }
+
+    /// Abort everything still pending once the deadline expired
+    void expire() {
+        if (m_expired)
+            return;
+        m_expired = true;
+        m_deadlineTimer.stop();
+        for (auto* queue : {&m_interactive, &m_background})
+            for (auto& queued : std::exchange(*queue, {}))
+                deliver(timedOut(std::move(queued.job)));
+        // abort() emits finished(); its handler reports the job as timed out
+        for (auto* reply : m_mgr.findChildren<QNetworkReply*>())
+            if (reply->isRunning())
+                reply->abort();
+        maybeFinish();
+    }
+
+    static BatchResult timedOut(BatchJob job) {
+        return {std::move(job), BatchStatus::TimedOut, {},
+                QStringLiteral("Deadline reached before the check finished")};
+    }
+
+    /// Deliver queued jobs whose token was stopped; stopping the checker's
+    /// own token also aborts every running reply
+    void sweepCancelled() {
+        if (m_options.stopToken.stop_requested()) {
+            m_stopped = true;
+            for (auto* queue : {&m_interactive, &m_background})
+                for (auto& queued : std::exchange(*queue, {}))
+                    deliver(cancelled(std::move(queued.job)));
+            // abort() emits finished(); its handler reports the job as cancelled
+            for (auto* reply : m_mgr.findChildren<QNetworkReply*>())
+                if (reply->isRunning())
+                    reply->abort();
+        } else {
+            for (auto* queue : {&m_interactive, &m_background}) {
+                std::deque<Queued> keep;
+                for (auto& queued : std::exchange(*queue, {})) {
+                    if (queued.job.stopToken.stop_requested())
+                        deliver(cancelled(std::move(queued.job)));
+                    else
+                        keep.push_back(std::move(queued));
+                }
+                *queue = std::move(keep);
+            }
+        }
+        maybeFinish();
+    }
+
+    bool isCancelled(const BatchJob& job) const {
+        return job.stopToken.stop_requested() || m_options.stopToken.stop_requested();
+    }
+
+    static BatchResult cancelled(BatchJob job) {
+        return {std::move(job), BatchStatus::Cancelled, {}, QStringLiteral("Cancelled")};
+    }
+
+    static UpdateInfo compare(const ReleaseRecord& release, const QString& localVersion,
+                              TraceRecorder* trace) {
+        if (!trace)
+            return compareRelease(release, localVersion);
+        const qint64 begin = TraceRecorder::now();
+        UpdateInfo info = compareRelease(release, localVersion);
+        trace->complete("compare", begin, TraceRecorder::now());
+        return info;
+    }
+
+    /// Emit the async spans of a finished network check
+    static void recordPhases(TraceRecorder& trace, const CheckTrace& t, qint64 finished,
+                             const BatchResult& result) {
+        // Qt reports no separate DNS/TCP events: "connect" covers DNS, TCP
+        // and (for https) the TLS handshake, which ends at encrypted().
+        const qint64 sent = t.sent ? t.sent : finished;
+        if (t.connecting) {
+            const qint64 connected = t.encrypted ? t.encrypted : sent;
+            trace.async("connect", t.id, t.connecting, connected);
+            if (t.encrypted && t.encrypted < sent)
+                trace.async("send", t.id, t.encrypted, sent);
+        } else if (t.started < sent) {
+            trace.async("send", t.id, t.started, sent);
+        }
+        const qint64 headers = t.headers ? t.headers : finished;
+        trace.async("request", t.id, sent, headers);
+        trace.async("download", t.id, headers, finished);
+
+        QString detail = result.job.repoUrl;
+        if (result.status != BatchStatus::Ok)
+            detail += QStringLiteral(" (") + result.error + QLatin1Char(')');
+        trace.async("check", t.id, t.enqueued, TraceRecorder::now(), detail);
+    }
+
+    void deliver(const BatchResult& result) {
+        if (m_handler)
+            m_handler(result);
+    }
+
+    void maybeFinish() {
+        if (m_loop && isFinished())
+            m_loop->quit();
+    }
+
+    QNetworkAccessManager m_mgr;
+    CheckOptions m_options;
+    std::deque<Queued> m_interactive;
+    std::deque<Queued> m_background;
+    std::deque<QNetworkReply*> m_preemptible;   ///< Running background requests, oldest first
+    QSet<QNetworkReply*> m_preempted;           ///< Aborted by preempt(), finished() pending
+    int m_starvationLimit = 8;
+    int m_interactiveStreak = 0;                ///< Interactive starts since the last background one
+    bool m_preemption = true;
+    quint64 m_preemptions = 0;
+    quint64 m_cachedFailures = 0;
+    ResultHandler m_handler;
+    QEventLoop* m_loop = nullptr;
+    std::optional<AimdLimiter> m_limiter;
+    QDeadlineTimer m_deadline{QDeadlineTimer::Forever};
+    QTimer m_deadlineTimer;
+    QTimer m_networkRetry;
+    OfflinePolicy m_offlinePolicy = OfflinePolicy::Fail;
+    bool m_watchingNetwork = false;
+    bool m_expired = false;
+    bool m_stopped = false;
+    int m_maxInFlight;
+    int m_inFlight = 0;
+    bool m_inputClosed = false;
+    // Last, so it is unregistered before the members its sweep touches
+    std::optional<std::stop_callback<PostSweep>> m_stopCallback;
+};
+
+} // namespace qtgh
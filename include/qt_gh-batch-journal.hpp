@@ -0,0 +1,366 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: 2026 Zheng-Bote
+//
+// qt_gh-batch-journal.hpp - Write-ahead progress journal for batch sweeps
+//
+// Appends every completed batch result to a compact binary journal so a
+// sweep that is killed (OOM, preemption) can be resumed: completed jobs
+// are skipped and their results replayed instead of checked again.
+//
+// File format (little endian):
+//   header  "QTGHJNL" + format version byte
+//   record  u32 payload length | u32 CRC-32 of payload | payload
+//   payload key, repoUrl, localVersion, origin, latestVersion (varint
+//           length + UTF-8 each) | u8 flags | i64 publishedAt (ms since
+//           epoch, INT64_MIN if unknown)
+//
+// A record torn by a crash fails its length or CRC check; it and
+// everything after it are truncated when the journal is reopened.
+//
+// Usage:
+//   #include "qt_gh-batch-journal.hpp"
+//   qtgh::BatchJournal journal("sweep.journal");
+//   for (const auto& done : journal.open(/*resume=*/true)) print(done);
+//   if (!journal.contains(qtgh::BatchJournal::keyOf(job))) checker.enqueue(job);
+//   // in the result handler:
+//   journal.append(result);
+
+#pragma once
+#include "qt_gh-batch-checker.hpp"
+#include <QElapsedTimer>
+#include <QFile>
+#include <QSet>
+#include <QTimeZone>
+#include <QTimer>
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <limits>
+
+#if defined(Q_OS_UNIX)
+#include <unistd.h>
+#elif defined(Q_OS_WIN)
+#include <io.h>
+#endif
+
+namespace qtgh {
+
+namespace detail {
+
+/// @brief CRC-32 (IEEE 802.3) of a byte range
+inline quint32 crc32(const char* data, qsizetype size) {
+    static constexpr auto table = [] {
+        std::array<quint32, 256> t{};
+        for (quint32 i = 0; i < 256; ++i) {
+            quint32 c = i;
+            for (int k = 0; k < 8; ++k)
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            t[i] = c;
+        }
+        return t;
+    }();
+    quint32 crc = 0xFFFFFFFFu;
+    for (qsizetype i = 0; i < size; ++i)
+        crc = table[(crc ^ static_cast<unsigned char>(data[i])) & 0xFF] ^ (crc >> 8);
+    return crc ^ 0xFFFFFFFFu;
+}
+
+/// @brief Little-endian encoder for journal records
+class JournalWriter {
+public:
+    explicit JournalWriter(QByteArray& out) : m_out(out) {}
+
+    void u8(quint8 v) { m_out.append(static_cast<char>(v)); }
+
+    void fixed(quint64 v, int bytes) {
+        for (int i = 0; i < bytes; ++i)
+            u8(static_cast<quint8>(v >> (8 * i)));
+    }
+
+    void varint(quint64 v) {
+        while (v >= 0x80) {
+            u8(static_cast<quint8>(v | 0x80));
+            v >>= 7;
+        }
+        u8(static_cast<quint8>(v));
+    }
+
+    void string(const QString& s) {
+        const QByteArray utf8 = s.toUtf8();
+        varint(static_cast<quint64>(utf8.size()));
+        m_out.append(utf8);
+    }
+
+private:
+    QByteArray& m_out;
+};
+
+/// @brief Bounds-checked little-endian decoder for journal records
+class JournalReader {
+public:
+    JournalReader(const char* data, qsizetype size) : m_data(data), m_size(size) {}
+
+    bool ok() const { return m_ok; }
+    bool atEnd() const { return m_pos == m_size; }
+
+    quint8 u8() {
+        if (m_pos >= m_size) {
+            m_ok = false;
+            return 0;
+        }
+        return static_cast<quint8>(m_data[m_pos++]);
+    }
+
+    quint64 fixed(int bytes) {
+        quint64 v = 0;
+        for (int i = 0; i < bytes; ++i)
+            v |= static_cast<quint64>(u8()) << (8 * i);
+        return v;
+    }
+
+    quint64 varint() {
+        quint64 v = 0;
+        for (int shift = 0; shift < 64 && m_ok; shift += 7) {
+            const quint8 b = u8();
+            v |= static_cast<quint64>(b & 0x7F) << shift;
+            if (!(b & 0x80))
+                return v;
+        }
+        m_ok = false;
+        return 0;
+    }
+
+    QString string() {
+        const quint64 len = varint();
+        if (!m_ok || len > static_cast<quint64>(m_size - m_pos)) {
+            m_ok = false;
+            return {};
+        }
+        const QString s = QString::fromUtf8(m_data + m_pos, static_cast<qsizetype>(len));
+        m_pos += static_cast<qsizetype>(len);
+        return s;
+    }
+
+private:
+    const char* m_data;
+    qsizetype m_size;
+    qsizetype m_pos = 0;
+    bool m_ok = true;
+};
+
+} // namespace detail
+
+// ---------------------------------------------------------
+// BatchJournal
+// ---------------------------------------------------------
+/// @brief Append-only journal of completed batch results
+///
+/// Only successful results are journaled; failed checks (network errors,
+/// rate limiting) are retried when the sweep is resumed. Each record is
+/// handed to the OS with one unbuffered write(), so it survives the
+/// process being killed; fdatasync() makes it survive a power loss and
+/// runs at most syncInterval() after the record was appended, driven by a
+/// timer in the owning thread's event loop. Jobs are identified by
+/// keyOf() (repository slug and local version), which matches the
+/// de-duplication of the "scan" command.
+///
+/// Write and sync errors are sticky: once one occurred, append() and
+/// sync() return false and errorString() describes the first failure.
+///
+/// Not thread-safe: use it from the thread delivering batch results.
+///
+/// @example
+///   qtgh::BatchJournal journal(path);
+///   const auto replayed = journal.open(resume);
+///   for (const auto& r : replayed) handler(r);
+///   checker.setResultHandler([&](const qtgh::BatchResult& r) {
+///       if (!journal.append(r))
+///           qWarning() << journal.errorString();
+///       handler(r);
+///   });
+class BatchJournal {
+public:
+    explicit BatchJournal(const QString& path) : m_file(path) {
+        m_syncTimer.setSingleShot(true);
+        QObject::connect(&m_syncTimer, &QTimer::timeout, &m_syncTimer, [this] { sync(); });
+    }
+
+    BatchJournal(const BatchJournal&) = delete;
+    BatchJournal& operator=(const BatchJournal&) = delete;
+
+    ~BatchJournal() {
+        if (m_file.isOpen())
+            sync();
+    }
+
+    /// @brief Key identifying a job in the journal ("owner/repo@version")
+    static QString keyOf(const BatchJob& job) {
+        return toRepoSlug(job.repoUrl) + QLatin1Char('@') + job.localVersion;
+    }
+
+    /// @brief Open the journal for appending
+    /// @param resume Keep and replay existing records (false: start a new journal)
+    /// @return Results recorded by the previous run, in completion order
+    /// @throws std::runtime_error if the file cannot be opened or is not a journal
+    QList<BatchResult> open(bool resume) {
+        QList<BatchResult> replayed;
+        m_keys.clear();
+        m_error.clear();
+
+        const bool existing = resume && m_file.exists() && m_file.size() > 0;
+        const QIODevice::OpenMode mode = existing ? QIODevice::OpenMode(QIODevice::ReadWrite)
+                                                  : QIODevice::WriteOnly | QIODevice::Truncate;
+        if (!m_file.open(mode | QIODevice::Unbuffered))
+            throw std::runtime_error(("Cannot open journal " + m_file.fileName() + ": "
+                                      + m_file.errorString()).toStdString());
+
+        if (!existing) {
+            if (m_file.write(kMagic, sizeof(kMagic)) != sizeof(kMagic))
+                fail("Cannot write journal " + m_file.fileName() + ": " + m_file.errorString());
+            if (!sync()) {
+                m_file.close();
+                throw std::runtime_error(m_error.toStdString());
+            }
+        } else {
+            const QByteArray data = m_file.readAll();
+            if (!data.startsWith(QByteArray::fromRawData(kMagic, sizeof(kMagic)))) {
+                m_file.close();
+                throw std::runtime_error(("Not a batch journal: " + m_file.fileName()).toStdString());
+            }
+
+            qsizetype pos = sizeof(kMagic);
+            while (data.size() - pos >= 8) {
+                detail::JournalReader head(data.constData() + pos, 8);
+                const auto length = static_cast<qsizetype>(head.fixed(4));
+                const auto crc = static_cast<quint32>(head.fixed(4));
+                if (length > data.size() - pos - 8
+                    || detail::crc32(data.constData() + pos + 8, length) != crc)
+                    break;
+
+                QString key;
+                BatchResult result;
+                if (!decode(data.constData() + pos + 8, length, key, result))
+                    break;
+                m_keys.insert(key);
+                replayed.append(std::move(result));
+                pos += 8 + length;
+            }
+
+            // Drop a torn tail so new records follow the last intact one
+            if (pos < data.size())
+                m_file.resize(pos);
+            m_file.seek(pos);
+        }
+
+        m_lastSync.start();
+        return replayed;
+    }
+
+    /// @brief Whether a result for this key was already recorded
+    bool contains(const QString& key) const { return m_keys.contains(key); }
+
+    /// @brief Number of recorded results
+    qsizetype size() const { return m_keys.size(); }
+
+    /// @brief Maximum time a record stays without fdatasync() (default 1 s, 0 = every record)
+    void setSyncInterval(std::chrono::milliseconds interval) { m_syncInterval = interval; }
+
+    /// @brief Description of the first write or sync error (empty if none)
+    QString errorString() const { return m_error; }
+
+    /// @brief Record a completed result (failed results are ignored)
+    /// @return false if the journal is not open or the record could not be
+    ///   written, or an earlier write or sync failed (see errorString())
+    bool append(const BatchResult& result) {
+        if (result.status != BatchStatus::Ok)
+            return m_error.isEmpty();
+        if (!m_file.isOpen())
+            return fail("Journal " + m_file.fileName() + " is not open");
+        if (!m_error.isEmpty())
+            return false;   // records after a failed one would not be replayed
+
+        const QString key = keyOf(result.job);
+        m_record.clear();
+        detail::JournalWriter w(m_record);
+        w.fixed(0, 8);      // length + CRC, filled in below
+        w.string(key);
+        w.string(result.job.repoUrl);
+        w.string(result.job.localVersion);
+        w.string(result.job.origin);
+        w.string(result.info.latestVersion);
+        w.u8(result.info.hasUpdate ? kFlagUpdate : 0);
+        w.fixed(static_cast<quint64>(result.info.publishedAt.isValid()
+                                         ? result.info.publishedAt.toMSecsSinceEpoch()
+                                         : std::numeric_limits<qint64>::min()), 8);
+
+        const qsizetype length = m_record.size() - 8;
+        const quint32 crc = detail::crc32(m_record.constData() + 8, length);
+        for (int i = 0; i < 4; ++i) {
+            m_record[i] = static_cast<char>(static_cast<quint32>(length) >> (8 * i));
+            m_record[4 + i] = static_cast<char>(crc >> (8 * i));
+        }
+
+        if (m_file.write(m_record) != m_record.size())
+            return fail("Cannot write journal " + m_file.fileName() + ": " + m_file.errorString());
+        m_keys.insert(key);
+        if (m_syncInterval.count() == 0 || m_lastSync.hasExpired(m_syncInterval.count()))
+            return sync();
+        if (!m_syncTimer.isActive())
+            m_syncTimer.start(m_syncInterval);
+        return true;
+    }
+
+    /// @brief Make all appended records durable
+    /// @return false if this or an earlier write or sync failed (see errorString())
+    bool sync() {
+        m_syncTimer.stop();
+        m_lastSync.start();
+        if (!m_file.isOpen())
+            return fail("Journal " + m_file.fileName() + " is not open");
+#if defined(Q_OS_UNIX)
+        if (::fdatasync(m_file.handle()) != 0)
+            return fail("Cannot sync journal " + m_file.fileName() + ": "
+                        + QString::fromLocal8Bit(std::strerror(errno)));
+#elif defined(Q_OS_WIN)
+        if (::_commit(m_file.handle()) != 0)
+            return fail("Cannot sync journal " + m_file.fileName() + ": "
+                        + QString::fromLocal8Bit(std::strerror(errno)));
+#endif
+        return m_error.isEmpty();
+    }
+
+private:
+    static constexpr char kMagic[8] = {'Q', 'T', 'G', 'H', 'J', 'N', 'L', 1};
+    static constexpr quint8 kFlagUpdate = 0x01;
+
+    bool fail(const QString& message) {
+        if (m_error.isEmpty())
+            m_error = message;
+        return false;
+    }
+
+    static bool decode(const char* data, qsizetype size, QString& key, BatchResult& result) {
+        detail::JournalReader r(data, size);
+        key = r.string();
+        result.job.repoUrl = r.string();
+        result.job.localVersion = r.string();
+        result.job.origin = r.string();
+        result.info.latestVersion = r.string();
+        result.info.hasUpdate = r.u8() & kFlagUpdate;
+        const auto published = static_cast<qint64>(r.fixed(8));
+        if (published != std::numeric_limits<qint64>::min())
+            result.info.publishedAt = QDateTime::fromMSecsSinceEpoch(published, QTimeZone::UTC);
+        result.status = BatchStatus::Ok;
+        return r.ok() && r.atEnd();
+    }
+
+    QFile m_file;
+    QSet<QString> m_keys;
+    QByteArray m_record;
+    QElapsedTimer m_lastSync;
+    QTimer m_syncTimer;
+    std::chrono::milliseconds m_syncInterval = std::chrono::seconds(1);
+    QString m_error;
+};
+
+} // namespace qtgh
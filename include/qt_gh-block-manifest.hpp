@@ -0,0 +1,353 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: 2026 Zheng-Bote
+//
+// qt_gh-block-manifest.hpp - Block checksums for delta downloads
+//
+// A BlockManifest describes a release asset as fixed-size blocks, each
+// with two checksums, the same way zsync does:
+//
+// - a weak rolling checksum (rsync's two 16-bit sums) that can be moved
+//   along a file one byte at a time, so every offset of the previously
+//   installed file can be tried as the start of a block
+// - a strong one (the first 16 bytes of SHA-256) that confirms a weak hit
+//
+// planDelta() slides the rolling checksum over the old file and records
+// where each block of the new file can be copied from; only the blocks
+// left over have to be downloaded (see qt_gh-delta-download.hpp). Both
+// building a manifest and matching split the file across threads.
+//
+// Manifests are stored as one CBOR map (usually "<asset>.blocksums"):
+//
+//   format "qtgh-blocksums", version 1, length, block_size,
+//   sha256 (whole file), weak (4 bytes big-endian per block),
+//   strong (16 bytes per block)
+//
+// Usage:
+//   #include "qt_gh-block-manifest.hpp"
+//   const auto manifest = qtgh::buildBlockManifest("app-1.4.1.img");   // at release time
+//   file.write(manifest.toCbor());
+//
+//   const auto plan = qtgh::planDelta(manifest, oldData, oldSize);      // on the device
+//   for (const auto& range : plan.missingRanges(manifest)) fetch(range);
+
+#pragma once
+#include "qt_gh-byte-range.hpp"
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QCborMap>
+#include <QCborValue>
+#include <QCryptographicHash>
+#include <QFile>
+#include <QList>
+#include <QString>
+#include <QtEndian>
+#include <algorithm>
+#include <bit>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace qtgh {
+
+// ---------------------------------------------------------
+// RollingChecksum
+// ---------------------------------------------------------
+/// @brief rsync's weak checksum over a window that moves one byte at a time
+///
+/// a is the sum of the window's bytes, b the sum weighted by the distance
+/// to the window's end, both modulo 2^16; value() is a | b << 16.
+class RollingChecksum {
+public:
+    RollingChecksum() = default;
+
+    /// @brief Checksum of the window `data[0, length)`
+    RollingChecksum(const uchar* data, qsizetype length) : m_length(static_cast<quint32>(length)) {
+        for (qsizetype i = 0; i < length; ++i) {
+            m_a += data[i];
+            m_b += static_cast<quint32>(length - i) * data[i];
+        }
+    }
+
+    /// @brief Move the window one byte: drop `out` at its start, append `in`
+    void roll(uchar out, uchar in) {
+        m_a += static_cast<quint32>(in) - out;
+        m_b += m_a - m_length * out;
+    }
+
+    quint32 value() const { return (m_a & 0xffff) | (m_b << 16); }
+
+private:
+    quint32 m_a = 0;
+    quint32 m_b = 0;
+    quint32 m_length = 0;
+};
+
+// ---------------------------------------------------------
+// BlockManifest
+// ---------------------------------------------------------
+/// @brief Block checksums of one file
+struct BlockManifest {
+    /// @brief Block size used by buildBlockManifest() unless given
+    static constexpr int kDefaultBlockSize = 4096;
+    /// @brief Bytes of SHA-256 kept per block
+    static constexpr int kStrongBytes = 16;
+
+    qint64 length = 0;                  ///< File size in bytes
+    int blockSize = kDefaultBlockSize;  ///< The last block may be shorter
+    QByteArray sha256;                  ///< Hash of the whole file
+    std::vector<quint32> weak;          ///< RollingChecksum per block
+    QByteArray strong;                  ///< kStrongBytes per block
+
+    qsizetype blockCount() const { return static_cast<qsizetype>(weak.size()); }
+    qint64 blockOffset(qsizetype block) const { return block * static_cast<qint64>(blockSize); }
+    qint64 blockLength(qsizetype block) const {
+        return std::min<qint64>(blockSize, length - blockOffset(block));
+    }
+    QByteArrayView strongHash(qsizetype block) const {
+        return QByteArrayView(strong).sliced(block * kStrongBytes, kStrongBytes);
+    }
+
+    /// @brief Strong checksum of a block's worth of data
+    static QByteArray strongHashOf(QByteArrayView data) {
+        return QCryptographicHash::hash(data, QCryptographicHash::Sha256).first(kStrongBytes);
+    }
+
+    /// @brief Whether `data` is block `block`
+    bool matches(qsizetype block, QByteArrayView data) const {
+        return data.size() == blockLength(block) && strongHashOf(data) == strongHash(block);
+    }
+
+    /// @brief Serialise as a CBOR map (see the file comment)
+    QByteArray toCbor() const {
+        QByteArray weakBytes(blockCount() * 4, Qt::Uninitialized);
+        for (qsizetype i = 0; i < blockCount(); ++i)
+            qToBigEndian(weak[i], weakBytes.data() + i * 4);
+        QCborMap map;
+        map.insert(QStringLiteral("format"), QStringLiteral("qtgh-blocksums"));
+        map.insert(QStringLiteral("version"), 1);
+        map.insert(QStringLiteral("length"), length);
+        map.insert(QStringLiteral("block_size"), blockSize);
+        map.insert(QStringLiteral("sha256"), sha256);
+        map.insert(QStringLiteral("weak"), weakBytes);
+        map.insert(QStringLiteral("strong"), strong);
+        return map.toCborValue().toCbor();
+    }
+
+    /// @brief Parse what toCbor() wrote
+    /// @throws std::runtime_error if the data is not a consistent manifest
+    static BlockManifest fromCbor(const QByteArray& data) {
+        const QCborMap map = QCborValue::fromCbor(data).toMap();
+        if (map.value(QStringLiteral("format")).toString() != QLatin1String("qtgh-blocksums"))
+            throw std::runtime_error("Not a block manifest");
+        if (map.value(QStringLiteral("version")).toInteger() != 1)
+            throw std::runtime_error("Unsupported block manifest version");
+
+        BlockManifest manifest;
+        manifest.length = map.value(QStringLiteral("length")).toInteger(-1);
+        manifest.blockSize = static_cast<int>(map.value(QStringLiteral("block_size")).toInteger());
+        manifest.sha256 = map.value(QStringLiteral("sha256")).toByteArray();
+        manifest.strong = map.value(QStringLiteral("strong")).toByteArray();
+        const QByteArray weakBytes = map.value(QStringLiteral("weak")).toByteArray();
+        if (manifest.length < 0 || manifest.blockSize <= 0 || manifest.sha256.size() != 32)
+            throw std::runtime_error("Invalid block manifest header");
+        const qint64 blocks = (manifest.length + manifest.blockSize - 1) / manifest.blockSize;
+        if (weakBytes.size() != blocks * 4 || manifest.strong.size() != blocks * kStrongBytes)
+            throw std::runtime_error("Block manifest checksums do not match its length");
+        manifest.weak.resize(static_cast<std::size_t>(blocks));
+        for (qsizetype i = 0; i < blocks; ++i)
+            manifest.weak[i] = qFromBigEndian<quint32>(weakBytes.constData() + i * 4);
+        return manifest;
+    }
+};
+
+namespace detail {
+
+/// Split [0, count) into one contiguous part per thread and run `part(begin, end)` on each
+inline void forEachPart(qint64 count, unsigned threads, const std::function<void(qint64, qint64)>& part) {
+    if (threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = static_cast<unsigned>(std::clamp<qint64>(count, 1, threads));
+    std::vector<std::thread> pool;
+    pool.reserve(threads - 1);
+    for (unsigned t = 1; t < threads; ++t)
+        pool.emplace_back(part, count * t / threads, count * (t + 1) / threads);
+    part(0, count / threads);
+    for (auto& thread : pool)
+        thread.join();
+}
+
+} // namespace detail
+
+/// @brief Checksum `data` block by block
+/// @param threads Threads hashing blocks (0 = one per core)
+///
+/// The blocks are split across threads; the calling thread also computes
+/// the whole-file SHA-256 while they run.
+inline BlockManifest buildBlockManifest(const uchar* data, qint64 size,
+                                        int blockSize = BlockManifest::kDefaultBlockSize,
+                                        unsigned threads = 0) {
+    if (blockSize <= 0)
+        throw std::runtime_error("Block size must be positive");
+    BlockManifest manifest;
+    manifest.length = size;
+    manifest.blockSize = blockSize;
+    const qint64 blocks = (size + blockSize - 1) / blockSize;
+    manifest.weak.resize(static_cast<std::size_t>(blocks));
+    manifest.strong.resize(blocks * BlockManifest::kStrongBytes);
+
+    std::thread whole([&] {
+        manifest.sha256 = QCryptographicHash::hash(
+            QByteArrayView(data, size), QCryptographicHash::Sha256);
+    });
+    detail::forEachPart(blocks, threads, [&](qint64 begin, qint64 end) {
+        QCryptographicHash hash(QCryptographicHash::Sha256);
+        for (qint64 i = begin; i < end; ++i) {
+            const qint64 length = manifest.blockLength(i);
+            const uchar* block = data + manifest.blockOffset(i);
+            manifest.weak[i] = RollingChecksum(block, length).value();
+            hash.reset();
+            hash.addData(QByteArrayView(block, length));
+            std::copy_n(hash.resultView().data(), BlockManifest::kStrongBytes,
+                        manifest.strong.data() + i * BlockManifest::kStrongBytes);
+        }
+    });
+    whole.join();
+    return manifest;
+}
+
+/// @brief Checksum a file block by block
+/// @throws std::runtime_error if the file cannot be read
+inline BlockManifest buildBlockManifest(const QString& path,
+                                        int blockSize = BlockManifest::kDefaultBlockSize,
+                                        unsigned threads = 0) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+        throw std::runtime_error(("Cannot open " + path + ": " + file.errorString()).toStdString());
+    if (file.size() == 0)
+        return buildBlockManifest(nullptr, 0, blockSize, threads);
+    const uchar* mapped = file.map(0, file.size());
+    if (!mapped)
+        throw std::runtime_error(("Cannot map " + path + ": " + file.errorString()).toStdString());
+    return buildBlockManifest(mapped, file.size(), blockSize, threads);
+}
+
+// ---------------------------------------------------------
+// planDelta
+// ---------------------------------------------------------
+/// @brief Where each block of a new file comes from
+struct BlockPlan {
+    std::vector<qint64> source;     ///< Per block: offset in the old file, or -1 to download
+    qint64 reusedBytes = 0;         ///< Bytes found in the old file
+
+    /// @brief Byte ranges of the blocks to download, adjacent blocks merged
+    /// @param maxLength Longest range (rounded down to whole blocks; 0 = no limit)
+    QList<ByteRange> missingRanges(const BlockManifest& manifest, qint64 maxLength = 0) const {
+        const qint64 maxBlocks = maxLength > 0 ? std::max<qint64>(1, maxLength / manifest.blockSize)
+                                               : manifest.blockCount();
+        QList<ByteRange> ranges;
+        qint64 first = -1;
+        for (qsizetype i = 0; i <= manifest.blockCount(); ++i) {
+            const bool missing = i < manifest.blockCount() && source[i] < 0;
+            if (first >= 0 && (!missing || i - first == maxBlocks)) {
+                ranges.append({manifest.blockOffset(first),
+                               manifest.blockOffset(i - 1) + manifest.blockLength(i - 1)
+                                   - manifest.blockOffset(first)});
+                first = -1;
+            }
+            if (missing && first < 0)
+                first = i;
+        }
+        return ranges;
+    }
+};
+
+/// @brief Find the blocks of `manifest` in an old version of the file
+/// @param threads Threads scanning the old file (0 = one per core)
+///
+/// Every offset of the old file is tried: its rolling checksum is looked
+/// up in a hash table of the blocks' weak checksums, and only hits are
+/// confirmed with the strong hash. After a match the scan continues behind
+/// the matched block. The old file is split into one part per thread; a
+/// block found by several threads is copied from the lowest offset. A
+/// short last block is only looked for at the end of the old file.
+inline BlockPlan planDelta(const BlockManifest& manifest, const uchar* old, qint64 oldSize,
+                           unsigned threads = 0) {
+    const qsizetype blocks = manifest.blockCount();
+    const qint64 L = manifest.blockSize;
+    BlockPlan plan;
+    plan.source.assign(static_cast<std::size_t>(blocks), -1);
+    if (blocks == 0)
+        return plan;
+
+    // Chained hash table of the full-size blocks' weak checksums
+    const qsizetype fullBlocks = manifest.blockLength(blocks - 1) == L ? blocks : blocks - 1;
+    const int bits = std::max(4, static_cast<int>(std::bit_width(static_cast<quint64>(fullBlocks))) + 1);
+    auto slot = [bits](quint32 weak) { return (weak * 0x9E3779B1u) >> (32 - bits); };
+    std::vector<qint32> head(std::size_t(1) << bits, -1);
+    std::vector<qint32> next(static_cast<std::size_t>(fullBlocks), -1);
+    for (qsizetype i = fullBlocks - 1; i >= 0; --i) {
+        next[i] = head[slot(manifest.weak[i])];
+        head[slot(manifest.weak[i])] = static_cast<qint32>(i);
+    }
+
+    // Each thread records the first offset of each block in its part
+    const qint64 starts = oldSize >= L && fullBlocks > 0 ? oldSize - L + 1 : 0;
+    std::vector<std::vector<qint64>> found;
+    std::mutex mutex;
+    detail::forEachPart(starts, threads, [&](qint64 begin, qint64 end) {
+        if (begin >= end)
+            return;
+        std::vector<qint64> local(static_cast<std::size_t>(blocks), -1);
+        QCryptographicHash hash(QCryptographicHash::Sha256);
+        qint64 pos = begin;
+        RollingChecksum sum(old + pos, L);
+        while (pos < end) {
+            const quint32 weak = sum.value();
+            bool matched = false;
+            QByteArrayView strong;
+            for (qint32 i = head[slot(weak)]; i >= 0; i = next[i]) {
+                if (manifest.weak[i] != weak)
+                    continue;
+                if (strong.isNull()) {
+                    hash.reset();
+                    hash.addData(QByteArrayView(old + pos, L));
+                    strong = hash.resultView().first(BlockManifest::kStrongBytes);
+                }
+                if (strong == manifest.strongHash(i)) {
+                    matched = true;
+                    if (local[i] < 0)
+                        local[i] = pos;
+                }
+            }
+            if (matched) {
+                pos += L;
+                if (pos < end)
+                    sum = RollingChecksum(old + pos, L);
+            } else if (++pos < end) {
+                sum.roll(old[pos - 1], old[pos + L - 1]);
+            }
+        }
+        std::lock_guard lock(mutex);
+        found.push_back(std::move(local));
+    });
+    for (const auto& local : found)
+        for (qsizetype i = 0; i < blocks; ++i)
+            if (local[i] >= 0 && (plan.source[i] < 0 || local[i] < plan.source[i]))
+                plan.source[i] = local[i];
+
+    // A short last block: unchanged if the old file ends with it
+    if (fullBlocks < blocks) {
+        const qint64 tail = manifest.blockLength(blocks - 1);
+        if (oldSize >= tail && manifest.matches(blocks - 1, QByteArrayView(old + oldSize - tail, tail)))
+            plan.source[blocks - 1] = oldSize - tail;
+    }
+
+    for (qsizetype i = 0; i < blocks; ++i)
+        if (plan.source[i] >= 0)
+            plan.reusedBytes += manifest.blockLength(i);
+    return plan;
+}
+
+} // namespace qtgh
@@ -0,0 +1,30 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: 2026 Zheng-Bote
+//
+// qt_gh-byte-range.hpp - Byte ranges of a file
+//
+// Shared by AssetDownloader (HTTP Range requests) and BlockManifest
+// (blocks missing from a delta update) without either header pulling in
+// the other.
+//
+// Usage:
+//   #include "qt_gh-byte-range.hpp"
+//   qtgh::ByteRange range{4096, 8192};    // bytes 4096..12287
+
+#pragma once
+#include <QtGlobal>
+
+namespace qtgh {
+
+// ---------------------------------------------------------
+// ByteRange
+// ---------------------------------------------------------
+/// @brief A contiguous part of a file
+struct ByteRange {
+    qint64 offset = 0;
+    qint64 length = 0;
+
+    bool operator==(const ByteRange&) const = default;
+};
+
+} // namespace qtgh
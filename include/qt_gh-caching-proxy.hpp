@@ -0,0 +1,296 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: 2026 Zheng-Bote
+//
+// qt_gh-caching-proxy.hpp - Caching reverse proxy for the releases API
+//
+// Serves GET /repos/{owner}/{repo}/releases/latest from an in-memory
+// cache so that many clients behind one IP share a single upstream
+// request budget:
+// - fresh entries are answered locally (If-None-Match -> 304)
+// - concurrent misses for the same repository are coalesced into one
+//   upstream request
+// - stale entries are revalidated upstream with If-None-Match; GitHub
+//   answers 304 without counting against the rate limit for
+//   authenticated requests
+// - upstream failures are answered from a stale entry when one exists;
+//   it is served for retryInterval() before upstream is tried again, so
+//   an outage does not turn every client request into an upstream one
+// - at most maxEntries() repositories are cached; expired entries, then
+//   the least recently fetched one, make room for new ones
+//
+// Clients are pointed at the proxy through the library's API base URL:
+//   export QTGH_API_BASE_URL=http://proxy-host:8080
+//
+// Usage:
+//   #include "qt_gh-caching-proxy.hpp"
+//   qtgh::CachingProxy proxy;
+//   proxy.setUpstreamToken(qgetenv("GITHUB_TOKEN"));
+//   proxy.listen(QHostAddress::Any, 8080);
+
+#pragma once
+#include "qt_gh-http-server.hpp"
+#include "qt_gh-update-checker.hpp"
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QRegularExpression>
+#include <algorithm>
+#include <utility>
+
+namespace qtgh {
+
+// ---------------------------------------------------------
+// CachingProxy
+// ---------------------------------------------------------
+/// @brief HTTP caching proxy for /repos/{owner}/{repo}/releases/latest
+///
+/// Successful and 404 responses are cached for ttl(); 404s are cached too
+/// because release-less repositories are requested as often as any other.
+class CachingProxy {
+public:
+    /// @brief Counters for monitoring and benchmarks
+    struct Stats {
+        quint64 requests = 0;       ///< Requests received
+        quint64 hits = 0;           ///< Answered from a fresh cache entry
+        quint64 coalesced = 0;      ///< Waited for an upstream request already in flight
+        quint64 upstream = 0;       ///< Upstream requests sent
+        quint64 revalidated = 0;    ///< Upstream answered 304 Not Modified
+        quint64 staleServed = 0;    ///< Responses from a stale entry after an upstream failure
+        quint64 evicted = 0;        ///< Entries dropped to stay within maxEntries()
+    };
+
+    CachingProxy()
+        : m_server([this](const HttpRequest& req, HttpServer::Responder respond) {
+              handle(req, std::move(respond));
+          }) {}
+
+    CachingProxy(const CachingProxy&) = delete;
+    CachingProxy& operator=(const CachingProxy&) = delete;
+
+    ~CachingProxy() {
+        for (auto* reply : m_mgr.findChildren<QNetworkReply*>()) {
+            QObject::disconnect(reply, nullptr, nullptr, nullptr);
+            reply->abort();
+        }
+    }
+
+    /// @brief Start listening (see HttpServer::listen())
+    bool listen(const QHostAddress& address = QHostAddress::LocalHost, quint16 port = 0) {
+        return m_server.listen(address, port);
+    }
+
+    quint16 serverPort() const { return m_server.serverPort(); }
+    QString errorString() const { return m_server.errorString(); }
+
+    /// @brief Upstream API base URL (default "https://api.github.com")
+    void setUpstreamBaseUrl(const QString& url) {
+        m_upstream = url;
+        while (m_upstream.endsWith('/'))
+            m_upstream.chop(1);
+    }
+
+    /// @brief Token sent upstream as "Authorization: Bearer <token>" (optional)
+    void setUpstreamToken(const QByteArray& token) { m_token = token; }
+
+    /// @brief Time a cached response is served without revalidation (default 5 min)
+    void setTtl(std::chrono::seconds ttl) { m_ttl = ttl; }
+    std::chrono::seconds ttl() const { return m_ttl; }
+
+    /// @brief Time a stale entry is served after an upstream failure before
+    ///   the next upstream attempt (default 30 s)
+    void setRetryInterval(std::chrono::seconds interval) { m_retryInterval = interval; }
+    std::chrono::seconds retryInterval() const { return m_retryInterval; }
+
+    /// @brief Maximum number of cached repositories, 404s included (default 10000)
+    ///
+    /// Bounds the memory any client can make the proxy use by asking for
+    /// many different repositories. Requests that need a new entry while
+    /// every entry waits for upstream are answered with 503.
+    void setMaxEntries(qsizetype maxEntries) { m_maxEntries = std::max<qsizetype>(1, maxEntries); }
+    qsizetype maxEntries() const { return m_maxEntries; }
+
+    const Stats& stats() const { return m_stats; }
+    qsizetype cachedEntries() const { return m_entries.size(); }
+
+private:
+    struct Entry {
+        int status = 0;                     ///< Cached upstream status (0 = nothing cached)
+        QByteArray body;
+        QByteArray etag;
+        QDateTime fetchedAt;
+        QDateTime retryAt;                  ///< After an upstream failure: no new attempt before
+        bool inFlight = false;
+        QList<HttpServer::Responder> waiters;
+    };
+
+    void handle(const HttpRequest& req, HttpServer::Responder respond) {
+        ++m_stats.requests;
+        static const QRegularExpression route(
+            R"(^/repos/([A-Za-z0-9_.-]+)/([A-Za-z0-9_.-]+)/releases/latest(?:\?.*)?$)");
+        const auto m = route.match(QString::fromUtf8(req.path));
+        if (!m.hasMatch()) {
+            respond({404, "application/json", {}, R"({"message":"Not Found"})"});
+            return;
+        }
+        if (req.method != "GET" && req.method != "HEAD") {
+            respond({405, "application/json", {{"Allow", "GET, HEAD"}},
+                      R"({"message":"Method Not Allowed"})"});
+            return;
+        }
+
+        const QString key = (m.captured(1) + QLatin1Char('/') + m.captured(2)).toLower();
+        auto found = m_entries.find(key);
+        if (found == m_entries.end()) {
+            if (!makeRoom()) {
+                respond({503, "application/json", {{"Retry-After", "1"}},
+                         R"({"message":"Proxy cache full"})"});
+                return;
+            }
+            found = m_entries.insert(key, Entry{});
+        }
+        Entry& entry = *found;
+        const QByteArray clientEtag = req.header("if-none-match");
+
+        if (entry.status != 0) {
+            const QDateTime now = QDateTime::currentDateTimeUtc();
+            if (entry.fetchedAt.addSecs(m_ttl.count()) > now) {
+                ++m_stats.hits;
+                respond(makeResponse(entry, clientEtag));
+                return;
+            }
+            if (entry.retryAt.isValid() && entry.retryAt > now) {
+                ++m_stats.staleServed;
+                respond(makeResponse(entry, clientEtag));
+                return;
+            }
+        }
+
+        // Miss or stale: wait for the (possibly already running) upstream request.
+        // Waiters receive either the upstream failure or status 0, meaning the
+        // entry has been updated and is answered from the cache.
+        entry.waiters.append([this, key, clientEtag, respond](const HttpResponse& result) {
+            const auto it = m_entries.constFind(key);
+            if (result.status != 0 || it == m_entries.cend())
+                respond(result);
+            else
+                respond(makeResponse(*it, clientEtag));
+        });
+        if (entry.inFlight) {
+            ++m_stats.coalesced;
+            return;
+        }
+        fetch(key);
+    }
+
+    /// The upstream request is built from the cache key, not the client's
+    /// path: the response is shared by every spelling of the repository,
+    /// so the first client's case or query string must not select it.
+    void fetch(const QString& key) {
+        Entry& entry = m_entries[key];
+        entry.inFlight = true;
+        ++m_stats.upstream;
+
+        QNetworkRequest req = makeGithubRequest(m_upstream + "/repos/" + key + "/releases/latest");
+        req.setRawHeader("Accept", "application/vnd.github+json");
+        if (!m_token.isEmpty())
+            req.setRawHeader("Authorization", "Bearer " + m_token);
+        if (entry.status == 200 && !entry.etag.isEmpty())
+            req.setRawHeader("If-None-Match", entry.etag);
+
+        QNetworkReply* reply = m_mgr.get(req);
+        QObject::connect(reply, &QNetworkReply::finished, reply, [this, reply, key] {
+            reply->deleteLater();
+            Entry& e = m_entries[key];
+            e.inFlight = false;
+
+            const int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+            const QDateTime now = QDateTime::currentDateTimeUtc();
+            if (status == 304 && e.status != 0) {
+                ++m_stats.revalidated;
+                e.fetchedAt = now;
+                e.retryAt = {};
+            } else if (status == 200 || status == 404) {
+                e.status = status;
+                e.body = reply->readAll();
+                e.etag = reply->rawHeader("ETag");
+                e.fetchedAt = now;
+                e.retryAt = {};
+            } else if (e.status != 0) {
+                // Serve stale, and keep serving it until the retry interval has passed
+                m_stats.staleServed += static_cast<quint64>(e.waiters.size());
+                e.retryAt = now.addSecs(m_retryInterval.count());
+            } else {
+                // Nothing to fall back to: pass the upstream failure through once
+                HttpResponse failure{status >= 400 ? status : 502, "application/json", {},
+                                     reply->readAll()};
+                if (failure.body.isEmpty())
+                    failure.body = R"({"message":"Bad Gateway"})";
+                const auto waiters = std::exchange(e.waiters, {});
+                m_entries.remove(key);
+                for (const auto& respond : waiters)
+                    respond(failure);
+                return;
+            }
+
+            const auto waiters = std::exchange(e.waiters, {});
+            for (const auto& respond : waiters)
+                respond({0, {}, {}, {}});
+        });
+    }
+
+    /// Make room for one more entry: drop expired entries, or else the least
+    /// recently fetched one. Entries waiting for upstream are kept.
+    /// @return false if every entry is waiting for upstream
+    bool makeRoom() {
+        if (m_entries.size() < m_maxEntries)
+            return true;
+        const QDateTime now = QDateTime::currentDateTimeUtc();
+        const qsizetype expired = m_entries.removeIf([this, &now](QHash<QString, Entry>::iterator it) {
+            const Entry& e = it.value();
+            return !e.inFlight && e.fetchedAt.addSecs(m_ttl.count()) <= now
+                && !(e.retryAt.isValid() && e.retryAt > now);
+        });
+        m_stats.evicted += static_cast<quint64>(expired);
+        if (m_entries.size() < m_maxEntries)
+            return true;
+        QString oldest;
+        QDateTime oldestAt;
+        for (auto it = m_entries.cbegin(); it != m_entries.cend(); ++it) {
+            if (!it->inFlight && (oldest.isNull() || it->fetchedAt < oldestAt)) {
+                oldest = it.key();
+                oldestAt = it->fetchedAt;
+            }
+        }
+        if (oldest.isNull())
+            return false;
+        m_entries.remove(oldest);
+        ++m_stats.evicted;
+        return true;
+    }
+
+    static HttpResponse makeResponse(const Entry& entry, const QByteArray& clientEtag) {
+        HttpResponse response;
+        response.contentType = "application/json; charset=utf-8";
+        if (!entry.etag.isEmpty())
+            response.headers.append({"ETag", entry.etag});
+        if (entry.status == 200 && !clientEtag.isEmpty() && clientEtag == entry.etag) {
+            response.status = 304;
+            return response;
+        }
+        response.status = entry.status;
+        response.body = entry.body;     // HttpServer omits it for HEAD
+        return response;
+    }
+
+    HttpServer m_server;
+    QNetworkAccessManager m_mgr;
+    QHash<QString, Entry> m_entries;
+    QString m_upstream = QStringLiteral("https://api.github.com");
+    QByteArray m_token;
+    std::chrono::seconds m_ttl = std::chrono::minutes(5);
+    std::chrono::seconds m_retryInterval = std::chrono::seconds(30);
+    qsizetype m_maxEntries = 10000;
+    Stats m_stats;
+};
+
+} // namespace qtgh
@@ -0,0 +1,164 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: 2026 Zheng-Bote
+//
+// qt_gh-concurrency-limiter.hpp - Adaptive concurrency limit (AIMD)
+//
+// Finds the number of concurrent requests a server tolerates the way TCP
+// congestion control finds a link's capacity: the limit grows by about one
+// request per round trip while responses are healthy and is cut
+// multiplicatively when the server signals overload (HTTP 429, GitHub's
+// secondary rate limit) or latency rises well above its baseline.
+//
+// The limiter only does the bookkeeping; BatchChecker consults it before
+// starting a request and reports every outcome back.
+//
+// Usage:
+//   #include "qt_gh-concurrency-limiter.hpp"
+//   qtgh::AimdLimiter limiter;
+//   if (inFlight < limiter.limit()) {
+//       const auto ticket = limiter.ticket();
+//       ... send request, measure latency ...
+//       limiter.onSuccess(ticket, latency, inFlight);   // or onOverload(ticket)
+//   }
+
+#pragma once
+#include <QtGlobal>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+
+namespace qtgh {
+
+// ---------------------------------------------------------
+// AimdLimiter
+// ---------------------------------------------------------
+/// @brief Additive-increase / multiplicative-decrease concurrency limit
+///
+/// Every successful response that completes while the limit is in use
+/// adds additiveIncrease / limit, i.e. roughly additiveIncrease per round
+/// trip of a full window. Overload responses and latency spikes multiply
+/// the limit by backoffFactor. Responses to requests started before the
+/// last decrease (an older ticket()) cannot trigger another decrease, so a
+/// burst of 429s from one window cuts the limit only once.
+///
+/// The latency baseline is the minimum observed over the last
+/// baselineWindow samples, which follows changes of the path (e.g. a new
+/// proxy) within a few hundred responses. Not thread-safe.
+///
+/// @example
+///   qtgh::AimdLimiter::Config config;
+///   config.maxLimit = 32;
+///   qtgh::AimdLimiter limiter(config);
+///   limiter.onOverload(limiter.ticket());   // limit 4 -> 2
+class AimdLimiter {
+public:
+    using Ticket = quint64;
+
+    /// @brief Tuning parameters
+    struct Config {
+        int initialLimit        = 4;
+        int minLimit            = 1;
+        int maxLimit            = 64;
+        double additiveIncrease = 1.0;  ///< Growth per round trip of a full window
+        double backoffFactor    = 0.5;  ///< Multiplier applied on overload
+        double latencyTolerance = 2.0;  ///< Spike if latency > tolerance * baseline (0 = off)
+        int baselineWindow      = 256;  ///< Samples per baseline (minimum latency) window
+        int minBaselineSamples  = 8;    ///< Samples needed before latency spikes count
+    };
+
+    /// @brief Counters for monitoring and benchmarks
+    struct Stats {
+        quint64 successes = 0;
+        quint64 overloads = 0;          ///< onOverload() calls
+        quint64 latencySpikes = 0;      ///< Successes slower than the tolerance
+        quint64 decreases = 0;          ///< Times the limit was cut
+    };
+
+    AimdLimiter() : AimdLimiter(Config{}) {}
+
+    explicit AimdLimiter(const Config& config)
+        : m_config(config),
+          m_window(std::clamp<double>(config.initialLimit, lowest(), highest())) {}
+
+    /// @brief Current number of requests that may be in flight (>= 1)
+    int limit() const { return static_cast<int>(m_window); }
+
+    /// @brief Token to pass to onSuccess()/onOverload() for a request started now
+    Ticket ticket() const { return m_generation; }
+
+    /// @brief Report a successful response
+    /// @param ticket ticket() taken when the request was started
+    /// @param latency Time from sending the request to its completion
+    /// @param inFlight Requests in flight when it completed, including this one
+    void onSuccess(Ticket ticket, std::chrono::nanoseconds latency, int inFlight) {
+        ++m_stats.successes;
+        const qint64 ns = latency.count();
+
+        const auto needed = static_cast<quint64>(std::max(0, m_config.minBaselineSamples));
+        const bool spike = m_config.latencyTolerance > 0 && m_samples >= needed
+                           && static_cast<double>(ns)
+                                  > m_config.latencyTolerance * static_cast<double>(baseline());
+        recordLatency(ns);
+
+        if (spike) {
+            ++m_stats.latencySpikes;
+            decrease(ticket);
+            return;
+        }
+        // Only a limit that is actually used has proven to be safe
+        if (inFlight >= limit())
+            m_window = std::min<double>(m_window + m_config.additiveIncrease / m_window, highest());
+    }
+
+    /// @brief Report an overload response (429, secondary rate limit)
+    void onOverload(Ticket ticket) {
+        ++m_stats.overloads;
+        decrease(ticket);
+    }
+
+    /// @brief Minimum latency of the current baseline, 0 before the first sample
+    std::chrono::nanoseconds baselineLatency() const {
+        return std::chrono::nanoseconds(m_samples ? baseline() : 0);
+    }
+
+    const Config& config() const { return m_config; }
+    const Stats& stats() const { return m_stats; }
+
+private:
+    int lowest() const { return std::max(1, m_config.minLimit); }
+    int highest() const { return std::max(lowest(), m_config.maxLimit); }
+
+    void decrease(Ticket ticket) {
+        if (ticket != m_generation)
+            return;     // Sent before the last cut; its window is already gone
+        m_window = std::max<double>(lowest(), std::floor(m_window * m_config.backoffFactor));
+        ++m_generation;
+        ++m_stats.decreases;
+    }
+
+    void recordLatency(qint64 ns) {
+        m_currentMin = std::min(m_currentMin, ns);
+        ++m_samples;
+        if (++m_windowSamples >= std::max(1, m_config.baselineWindow)) {
+            m_previousMin = m_currentMin;
+            m_currentMin = std::numeric_limits<qint64>::max();
+            m_windowSamples = 0;
+        }
+    }
+
+    /// Minimum of the current and the previous window, so a new window
+    /// does not start without a baseline
+    qint64 baseline() const { return std::min(m_previousMin, m_currentMin); }
+
+    Config m_config;
+    double m_window;
+    Ticket m_generation = 0;
+    qint64 m_currentMin = std::numeric_limits<qint64>::max();
+    qint64 m_previousMin = std::numeric_limits<qint64>::max();
+    int m_windowSamples = 0;
+    quint64 m_samples = 0;
+    Stats m_stats;
+};
+
+} // namespace qtgh
@@ -0,0 +1,574 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: 2026 Zheng-Bote
+//
+// qt_gh-core.hpp - Qt-free core: versions, repository URLs, release JSON
+//
+// The string handling behind an update check, with no dependency beyond
+// the C++23 standard library, for services with their own I/O stack:
+// - SemVer parsing and comparison (Version, findVersion(), parseVersion())
+// - GitHub repository URL normalization (repoSlug(), apiUrl())
+// - Extraction of tag_name / published_at / message from a "latest
+//   release" response without building a document (extractRelease())
+//
+// The Qt layer (qt_gh-update-checker.hpp) is built on these functions; the
+// scanners are templates over the character type so it can run them on
+// UTF-16 QStrings directly.
+//
+// Usage:
+//   #include "qt_gh-core.hpp"
+//   auto release = qtgh::core::extractRelease(body);    // std::string_view
+//   if (release && release->tag
+//       && qtgh::core::isNewer(*release->tag, "1.0.0"))
+//       ...
+
+#pragma once
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace qtgh::core {
+
+// ---------------------------------------------------------
+// Versions
+// ---------------------------------------------------------
+/// @brief Semantic version (major.minor.patch), compared field by field
+struct Version {
+    int major = 0;  ///< Major version number
+    int minor = 0;  ///< Minor version number
+    int patch = 0;  ///< Patch version number
+
+    auto operator<=>(const Version&) const = default;
+};
+
+/// @brief Find the first "major.minor[.patch]" in a string (ASCII digits)
+/// @return The version, or nullopt if there is none
+///
+/// Accepts any prefix or suffix ("v1.2", "release-1.2.3-rc1"); the patch
+/// defaults to 0. Numbers that do not fit into an int are read as 0.
+/// Does not allocate.
+template <typename CharT>
+constexpr std::optional<Version> findVersion(std::basic_string_view<CharT> v) noexcept {
+    const std::size_t n = v.size();
+    auto isDigit = [](CharT c) { return c >= CharT('0') && c <= CharT('9'); };
+    auto digitsEnd = [&](std::size_t i) {
+        while (i < n && isDigit(v[i]))
+            ++i;
+        return i;
+    };
+    auto number = [&](std::size_t from, std::size_t to) {
+        std::int64_t value = 0;
+        for (std::size_t i = from; i < to; ++i) {
+            value = value * 10 + (v[i] - CharT('0'));
+            if (value > std::numeric_limits<int>::max())
+                return 0;
+        }
+        return static_cast<int>(value);
+    };
+
+    for (std::size_t i = 0; i < n;) {
+        if (!isDigit(v[i])) {
+            ++i;
+            continue;
+        }
+        const std::size_t majorEnd = digitsEnd(i);
+        if (majorEnd + 1 < n && v[majorEnd] == CharT('.') && isDigit(v[majorEnd + 1])) {
+            Version version;
+            version.major = number(i, majorEnd);
+            const std::size_t minorEnd = digitsEnd(majorEnd + 1);
+            version.minor = number(majorEnd + 1, minorEnd);
+            if (minorEnd + 1 < n && v[minorEnd] == CharT('.') && isDigit(v[minorEnd + 1]))
+                version.patch = number(minorEnd + 1, digitsEnd(minorEnd + 1));
+            return version;
+        }
+        i = majorEnd;
+    }
+    return std::nullopt;
+}
+
+/// @brief Parse a version string (see findVersion())
+/// @throws std::runtime_error if the string contains no version
+inline Version parseVersion(std::string_view v) {
+    if (const auto version = findVersion(v))
+        return *version;
+    throw std::runtime_error("Invalid SemVer: " + std::string(v));
+}
+
+/// @brief Whether release tag `tag` is newer than `localVersion`
+/// @throws std::runtime_error if either string contains no version
+inline bool isNewer(std::string_view tag, std::string_view localVersion) {
+    return parseVersion(tag) > parseVersion(localVersion);
+}
+
+// ---------------------------------------------------------
+// Repository URLs
+// ---------------------------------------------------------
+/// @brief Positions of the owner and repository names within a URL
+struct RepoSpan {
+    std::size_t owner = 0;
+    std::size_t ownerEnd = 0;
+    std::size_t repo = 0;
+    std::size_t repoEnd = 0;    ///< Excludes a ".git" suffix
+};
+
+namespace detail {
+
+/// Same set as QChar::isSpace(): ASCII and Unicode separators
+template <typename CharT>
+constexpr bool isSpace(CharT c) noexcept {
+    const auto u = static_cast<std::uint32_t>(static_cast<std::make_unsigned_t<CharT>>(c));
+    if (u == 0x20 || (u >= 0x09 && u <= 0x0d))
+        return true;
+    if constexpr (sizeof(CharT) > 1)
+        return u == 0x85 || u == 0xa0 || u == 0x1680 || (u >= 0x2000 && u <= 0x200a)
+            || u == 0x2028 || u == 0x2029 || u == 0x202f || u == 0x205f || u == 0x3000;
+    return false;
+}
+
+template <typename CharT>
+constexpr bool startsWithAt(std::basic_string_view<CharT> s, std::size_t at,
+                            std::string_view prefix) noexcept {
+    if (s.size() - at < prefix.size())
+        return false;
+    for (std::size_t k = 0; k < prefix.size(); ++k) {
+        if (s[at + k] != CharT(prefix[k]))
+            return false;
+    }
+    return true;
+}
+
+template <typename CharT>
+constexpr std::size_t stripGitSuffix(std::basic_string_view<CharT> s, std::size_t repo,
+                                     std::size_t repoEnd) noexcept {
+    if (repoEnd - repo >= 4 && startsWithAt(s, repoEnd - 4, ".git"))
+        return repoEnd - 4;
+    return repoEnd;
+}
+
+} // namespace detail
+
+/// @brief Find owner and repository in any supported URL form
+///
+/// Accepts web URLs (https://github.com/owner/repo[.git]), SSH URLs
+/// (git@github.com:owner/repo.git) and API URLs
+/// (https://api.github.com/repos/owner/repo/...). Equivalent to searching
+/// for `(?:api\.github\.com/repos|github\.com)[/:]([^/\s]+)/([^/\s#?]+)`.
+template <typename CharT>
+constexpr std::optional<RepoSpan> findRepoSlug(std::basic_string_view<CharT> u) noexcept {
+    const std::size_t n = u.size();
+    for (std::size_t i = 0; i < n; ++i) {
+        for (const std::string_view prefix : {std::string_view("api.github.com/repos"),
+                                              std::string_view("github.com")}) {
+            if (!detail::startsWithAt(u, i, prefix))
+                continue;
+            std::size_t p = i + prefix.size();
+            if (p >= n || (u[p] != CharT('/') && u[p] != CharT(':')))
+                continue;
+            RepoSpan span;
+            span.owner = ++p;
+            while (p < n && u[p] != CharT('/') && !detail::isSpace(u[p]))
+                ++p;
+            if (p == span.owner || p >= n || u[p] != CharT('/'))
+                continue;
+            span.ownerEnd = p;
+            span.repo = ++p;
+            while (p < n && u[p] != CharT('/') && u[p] != CharT('#') && u[p] != CharT('?')
+                   && !detail::isSpace(u[p]))
+                ++p;
+            if (p == span.repo)
+                continue;
+            span.repoEnd = detail::stripGitSuffix(u, span.repo, p);
+            return span;
+        }
+    }
+    return std::nullopt;
+}
+
+/// @brief Find owner and repository of a web URL (https://github.com/owner/repo)
+///
+/// Equivalent to searching for `https://github\.com/([^/]+)/([^/]+)`; the
+/// repository runs up to the next '/', so a query or fragment stays part
+/// of it. Used to build API URLs.
+template <typename CharT>
+constexpr std::optional<RepoSpan> findWebRepo(std::basic_string_view<CharT> u) noexcept {
+    constexpr std::string_view prefix = "https://github.com/";
+    const std::size_t n = u.size();
+    for (std::size_t i = 0; i < n; ++i) {
+        if (!detail::startsWithAt(u, i, prefix))
+            continue;
+        RepoSpan span;
+        std::size_t p = span.owner = i + prefix.size();
+        while (p < n && u[p] != CharT('/'))
+            ++p;
+        if (p == span.owner || p >= n)
+            continue;
+        span.ownerEnd = p;
+        span.repo = ++p;
+        while (p < n && u[p] != CharT('/'))
+            ++p;
+        if (p == span.repo)
+            continue;
+        span.repoEnd = detail::stripGitSuffix(u, span.repo, p);
+        return span;
+    }
+    return std::nullopt;
+}
+
+/// @brief Normalize a repository URL to its lower-case "owner/repo" slug
+/// @return The slug (ASCII letters lowered), or nullopt if the URL names no repository
+inline std::optional<std::string> repoSlug(std::string_view url) {
+    const auto span = findRepoSlug(url);
+    if (!span)
+        return std::nullopt;
+    auto lower = [](char c) { return c >= 'A' && c <= 'Z' ? static_cast<char>(c + 32) : c; };
+    std::string slug;
+    slug.reserve(span->ownerEnd - span->owner + 1 + span->repoEnd - span->repo);
+    for (std::size_t k = span->owner; k < span->ownerEnd; ++k)
+        slug.push_back(lower(url[k]));
+    slug.push_back('/');
+    for (std::size_t k = span->repo; k < span->repoEnd; ++k)
+        slug.push_back(lower(url[k]));
+    return slug;
+}
+
+/// @brief "Latest release" API URL of a repository URL
+/// @param apiBaseUrl API base URL without trailing slash
+/// @return URLs already pointing at api.github.com unchanged; nullopt if
+///   `url` is not a GitHub web URL
+inline std::optional<std::string> apiUrl(std::string_view url,
+                                         std::string_view apiBaseUrl = "https://api.github.com") {
+    if (url.find("api.github.com") != std::string_view::npos)
+        return std::string(url);
+    const auto span = findWebRepo(url);
+    if (!span)
+        return std::nullopt;
+    std::string out;
+    out.reserve(apiBaseUrl.size() + 7 + url.size() + 16);
+    out.append(apiBaseUrl).append("/repos/");
+    out.append(url.substr(span->owner, span->ownerEnd - span->owner)).push_back('/');
+    out.append(url.substr(span->repo, span->repoEnd - span->repo)).append("/releases/latest");
+    return out;
+}
+
+// ---------------------------------------------------------
+// Release JSON
+// ---------------------------------------------------------
+/// @brief Fields of a "latest release" response the update check uses
+///
+/// A field is nullopt if it is absent or not a string; for repeated keys
+/// the last occurrence counts. Strings are UTF-8 with escapes resolved.
+struct ReleaseFields {
+    std::optional<std::string> tag;          ///< "tag_name"
+    std::optional<std::string> publishedAt;  ///< "published_at" (ISO 8601)
+    std::optional<std::string> message;      ///< "message" of an API error
+};
+
+namespace detail {
+
+/// @brief Validating single-pass JSON scanner (RFC 8259)
+///
+/// Only the requested top-level string members are decoded; everything
+/// else is checked and skipped, so large release bodies and asset lists
+/// cost no allocations.
+class JsonScanner {
+public:
+    /// Same nesting limit as Qt's JSON parser
+    static constexpr int kMaxDepth = 1024;
+
+    explicit JsonScanner(std::string_view json) : m_s(json) {}
+
+    std::optional<ReleaseFields> release() {
+        ReleaseFields fields;
+        skipSpace();
+        if (!consume('{'))
+            return std::nullopt;
+        skipSpace();
+        if (!consume('}')) {
+            std::string key;
+            do {
+                skipSpace();
+                key.clear();
+                if (!string(&key))
+                    return std::nullopt;
+                skipSpace();
+                if (!consume(':'))
+                    return std::nullopt;
+                skipSpace();
+                std::optional<std::string>* target = key == "tag_name"       ? &fields.tag
+                                                     : key == "published_at" ? &fields.publishedAt
+                                                     : key == "message"      ? &fields.message
+                                                                             : nullptr;
+                if (target && peek() == '"') {
+                    target->emplace();
+                    if (!string(&**target))
+                        return std::nullopt;
+                } else {
+                    if (target)
+                        target->reset();
+                    if (!value(1))
+                        return std::nullopt;
+                }
+                skipSpace();
+            } while (consume(','));
+            if (!consume('}'))
+                return std::nullopt;
+        }
+        skipSpace();
+        if (m_pos != m_s.size())
+            return std::nullopt;    // garbage after the object
+        return fields;
+    }
+
+private:
+    char peek() const { return m_pos < m_s.size() ? m_s[m_pos] : '\0'; }
+
+    bool consume(char c) {
+        if (m_pos < m_s.size() && m_s[m_pos] == c) {
+            ++m_pos;
+            return true;
+        }
+        return false;
+    }
+
+    void skipSpace() {
+        while (m_pos < m_s.size()
+               && (m_s[m_pos] == ' ' || m_s[m_pos] == '\t' || m_s[m_pos] == '\n'
+                   || m_s[m_pos] == '\r'))
+            ++m_pos;
+    }
+
+    bool value(int depth) {
+        if (depth > kMaxDepth)
+            return false;
+        switch (peek()) {
+        case '{': return object(depth);
+        case '[': return array(depth);
+        case '"': return string(nullptr);
+        case 't': return literal("true");
+        case 'f': return literal("false");
+        case 'n': return literal("null");
+        default:  return number();
+        }
+    }
+
+    bool object(int depth) {
+        ++m_pos;
+        skipSpace();
+        if (consume('}'))
+            return true;
+        do {
+            skipSpace();
+            if (!string(nullptr))
+                return false;
+            skipSpace();
+            if (!consume(':'))
+                return false;
+            skipSpace();
+            if (!value(depth + 1))
+                return false;
+            skipSpace();
+        } while (consume(','));
+        return consume('}');
+    }
+
+    bool array(int depth) {
+        ++m_pos;
+        skipSpace();
+        if (consume(']'))
+            return true;
+        do {
+            skipSpace();
+            if (!value(depth + 1))
+                return false;
+            skipSpace();
+        } while (consume(','));
+        return consume(']');
+    }
+
+    bool literal(std::string_view word) {
+        if (m_s.substr(m_pos, word.size()) != word)
+            return false;
+        m_pos += word.size();
+        return true;
+    }
+
+    bool number() {
+        auto digits = [this] {
+            const std::size_t start = m_pos;
+            while (m_pos < m_s.size() && m_s[m_pos] >= '0' && m_s[m_pos] <= '9')
+                ++m_pos;
+            return m_pos > start;
+        };
+        consume('-');
+        if (consume('0')) {
+            // no leading zeros
+        } else if (!digits()) {
+            return false;
+        }
+        if (consume('.') && !digits())
+            return false;
+        if (consume('e') || consume('E')) {
+            if (!consume('+'))
+                consume('-');
+            if (!digits())
+                return false;
+        }
+        return true;
+    }
+
+    /// Parse a string at m_pos, appending its UTF-8 value to `out` if given
+    bool string(std::string* out) {
+        if (!consume('"'))
+            return false;
+        while (m_pos < m_s.size()) {
+            const auto c = static_cast<unsigned char>(m_s[m_pos]);
+            if (c == '"') {
+                ++m_pos;
+                return true;
+            }
+            if (c < 0x20)
+                return false;
+            if (c == '\\') {
+                if (!escape(out))
+                    return false;
+            } else if (c < 0x80) {
+                if (out)
+                    out->push_back(static_cast<char>(c));
+                ++m_pos;
+            } else {
+                const std::size_t length = utf8Length();
+                if (length == 0)
+                    return false;
+                if (out)
+                    out->append(m_s.substr(m_pos, length));
+                m_pos += length;
+            }
+        }
+        return false;
+    }
+
+    bool escape(std::string* out) {
+        ++m_pos;    // backslash
+        if (m_pos >= m_s.size())
+            return false;
+        char decoded = 0;
+        switch (m_s[m_pos++]) {
+        case '"':  decoded = '"'; break;
+        case '\\': decoded = '\\'; break;
+        case '/':  decoded = '/'; break;
+        case 'b':  decoded = '\b'; break;
+        case 'f':  decoded = '\f'; break;
+        case 'n':  decoded = '\n'; break;
+        case 'r':  decoded = '\r'; break;
+        case 't':  decoded = '\t'; break;
+        case 'u': {
+            std::uint32_t cp = 0;
+            if (!hex4(&cp))
+                return false;
+            if (cp >= 0xd800 && cp <= 0xdbff && m_s.substr(m_pos, 2) == "\\u") {
+                const std::size_t save = m_pos;
+                m_pos += 2;
+                std::uint32_t low = 0;
+                if (hex4(&low) && low >= 0xdc00 && low <= 0xdfff)
+                    cp = 0x10000 + ((cp - 0xd800) << 10) + (low - 0xdc00);
+                else
+                    m_pos = save;
+            }
+            if (cp >= 0xd800 && cp <= 0xdfff)
+                cp = 0xfffd;    // unpaired surrogate
+            if (out)
+                appendUtf8(out, cp);
+            return true;
+        }
+        default:
+            return false;
+        }
+        if (out)
+            out->push_back(decoded);
+        return true;
+    }
+
+    bool hex4(std::uint32_t* cp) {
+        if (m_s.size() - m_pos < 4)
+            return false;
+        for (int k = 0; k < 4; ++k) {
+            const char h = m_s[m_pos++];
+            std::uint32_t digit;
+            if (h >= '0' && h <= '9')
+                digit = static_cast<std::uint32_t>(h - '0');
+            else if (h >= 'a' && h <= 'f')
+                digit = static_cast<std::uint32_t>(h - 'a' + 10);
+            else if (h >= 'A' && h <= 'F')
+                digit = static_cast<std::uint32_t>(h - 'A' + 10);
+            else
+                return false;
+            *cp = *cp * 16 + digit;
+        }
+        return true;
+    }
+
+    /// Length of a well-formed multi-byte UTF-8 sequence at m_pos, 0 if invalid
+    std::size_t utf8Length() const {
+        auto byte = [this](std::size_t k) {
+            return m_pos + k < m_s.size() ? static_cast<unsigned char>(m_s[m_pos + k]) : 0u;
+        };
+        auto continuation = [](unsigned b) { return (b & 0xc0) == 0x80; };
+        const unsigned b0 = byte(0);
+        const unsigned b1 = byte(1);
+        if (b0 >= 0xc2 && b0 <= 0xdf)
+            return continuation(b1) ? 2 : 0;
+        if (b0 >= 0xe0 && b0 <= 0xef) {
+            // no overlongs (E0 80..9F) and no surrogates (ED A0..BF)
+            if ((b0 == 0xe0 && b1 < 0xa0) || (b0 == 0xed && b1 > 0x9f))
+                return 0;
+            return continuation(b1) && continuation(byte(2)) ? 3 : 0;
+        }
+        if (b0 >= 0xf0 && b0 <= 0xf4) {
+            // no overlongs (F0 80..8F) and nothing above U+10FFFF (F4 90..)
+            if ((b0 == 0xf0 && b1 < 0x90) || (b0 == 0xf4 && b1 > 0x8f))
+                return 0;
+            return continuation(b1) && continuation(byte(2)) && continuation(byte(3)) ? 4 : 0;
+        }
+        return 0;
+    }
+
+    static void appendUtf8(std::string* out, std::uint32_t cp) {
+        if (cp < 0x80) {
+            out->push_back(static_cast<char>(cp));
+        } else if (cp < 0x800) {
+            out->push_back(static_cast<char>(0xc0 | (cp >> 6)));
+            out->push_back(static_cast<char>(0x80 | (cp & 0x3f)));
+        } else if (cp < 0x10000) {
+            out->push_back(static_cast<char>(0xe0 | (cp >> 12)));
+            out->push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3f)));
+            out->push_back(static_cast<char>(0x80 | (cp & 0x3f)));
+        } else {
+            out->push_back(static_cast<char>(0xf0 | (cp >> 18)));
+            out->push_back(static_cast<char>(0x80 | ((cp >> 12) & 0x3f)));
+            out->push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3f)));
+            out->push_back(static_cast<char>(0x80 | (cp & 0x3f)));
+        }
+    }
+
+    std::string_view m_s;
+    std::size_t m_pos = 0;
+};
+
+} // namespace detail
+
+/// @brief Extract the release fields from a "latest release" API response
+/// @param json Raw response body (UTF-8)
+/// @return The fields, or nullopt if `json` is not a well-formed JSON object
+///
+/// The whole document is validated (syntax, UTF-8, nesting up to 1024
+/// levels), but only the three top-level strings are decoded.
+inline std::optional<ReleaseFields> extractRelease(std::string_view json) {
+    return detail::JsonScanner(json).release();
+}
+
+} // namespace qtgh::core
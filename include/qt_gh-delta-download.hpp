@@ -0,0 +1,414 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: 2026 Zheng-Bote
+//
+// qt_gh-delta-download.hpp - Delta downloads of release assets
+//
+// Updates a previously installed asset to a new release by downloading
+// only the blocks that changed, zsync-style:
+//
+//   1. fetch the block manifest published next to the asset
+//      (qt_gh-block-manifest.hpp, built e.g. by "qt_gh-update-checker
+//      blocksums")
+//   2. scan the old file with the rolling checksum on a worker thread
+//      (itself split across cores) and copy every block found into
+//      "<target>.part"
+//   3. fetch the remaining blocks with HTTP Range requests, adjacent
+//      blocks merged into one request of at most maxRangeLength() bytes,
+//      parallelRanges() at a time; each block is checked against its
+//      strong hash before it is written
+//   4. check the SHA-256 of the whole file, fsync it and rename it to the
+//      target; the directory is synced after the rename (POSIX), so after
+//      a power loss the target is either the old or the complete new file
+//
+// Range requests go through an AssetDownloader, so its bandwidth limits
+// apply. Without an old file every block is fetched, which costs about as
+// much as a plain download.
+//
+// Usage:
+//   #include "qt_gh-delta-download.hpp"
+//   qtgh::DeltaDownloader delta;
+//   delta.update({assetUrl + ".blocksums", assetUrl, "/opt/app/app.img", "/opt/app/app.img.new"},
+//                [](const qtgh::DeltaResult& r) { ... r.fetchedBytes, r.error ... });
+
+#pragma once
+#include "qt_gh-asset-downloader.hpp"
+#include "qt_gh-block-manifest.hpp"
+#include <QBuffer>
+#include <QFile>
+#include <QFileInfo>
+#include <cerrno>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#if defined(Q_OS_UNIX)
+#include <fcntl.h>
+#include <unistd.h>
+#elif defined(Q_OS_WIN)
+#include <io.h>
+#endif
+
+namespace qtgh {
+
+// ---------------------------------------------------------
+// DeltaDownloader
+// ---------------------------------------------------------
+/// @brief One asset to update
+struct DeltaJob {
+    QString manifestUrl;    ///< Block manifest of the new asset
+    QString assetUrl;       ///< The new asset; the server must answer Range requests
+    QString basisPath;      ///< The previously installed version (need not exist)
+    QString targetPath;     ///< Where the new version is written (may equal basisPath)
+};
+
+/// @brief Outcome of an update
+struct DeltaResult {
+    DeltaJob job;
+    qint64 length = 0;          ///< Size of the new file
+    qint64 reusedBytes = 0;     ///< Copied from the old file
+    qint64 fetchedBytes = 0;    ///< Downloaded with Range requests
+    qint64 manifestBytes = 0;   ///< Size of the block manifest
+    int rangeRequests = 0;
+    std::chrono::nanoseconds elapsed{0};
+    QString error;              ///< Empty on success; the target is untouched on errors
+};
+
+/// @brief Rebuilds new asset versions from old ones and the changed blocks
+///
+/// Lives on one thread with an event loop; all members must be called
+/// there. The destructor waits for running scans of old files and drops
+/// their updates without calling the handlers.
+///
+/// @example
+///   qtgh::AssetDownloader downloads;
+///   downloads.throttle().setGlobalRate(1024 * 1024);
+///   qtgh::DeltaDownloader delta(&downloads);            // shares the limit
+///   delta.update(job, [](const qtgh::DeltaResult& r) { ... });
+class DeltaDownloader {
+public:
+    using Handler = std::function<void(const DeltaResult&)>;
+
+    /// @brief Longest Range request by default
+    static constexpr qint64 kMaxRangeLength = 4 * 1024 * 1024;
+
+    /// @param downloader Downloader for the manifest and the ranges (nullptr = an own one)
+    explicit DeltaDownloader(AssetDownloader* downloader = nullptr)
+        : m_own(downloader ? nullptr : std::make_unique<AssetDownloader>()),
+          m_downloader(downloader ? downloader : m_own.get()) {}
+
+    DeltaDownloader(const DeltaDownloader&) = delete;
+    DeltaDownloader& operator=(const DeltaDownloader&) = delete;
+
+    ~DeltaDownloader() {
+        for (const auto& u : m_updates) {
+            if (u->worker.joinable())
+                u->worker.join();
+            if (u->manifestId)
+                m_downloader->cancel(u->manifestId);
+            for (const auto& fetch : u->fetches)
+                m_downloader->cancel(fetch->id);
+            u->part.close();
+            QFile::remove(partPath(*u));
+        }
+    }
+
+    /// @brief Threads scanning old files and hashing (0 = one per core)
+    void setThreads(unsigned threads) { m_threads = threads; }
+
+    /// @brief Longest Range request; adjacent missing blocks are merged up to it
+    void setMaxRangeLength(qint64 bytes) { m_maxRangeLength = std::max<qint64>(1, bytes); }
+    qint64 maxRangeLength() const { return m_maxRangeLength; }
+
+    /// @brief Range requests per update at once (default 4)
+    void setParallelRanges(int count) { m_parallelRanges = std::max(1, count); }
+    int parallelRanges() const { return m_parallelRanges; }
+
+    /// @brief Priority, rate limit and timeout of the requests (the range is set per request)
+    void setDownloadOptions(const DownloadOptions& options) { m_options = options; }
+
+    /// @brief Fetch the manifest, then update as below
+    void update(const DeltaJob& job, Handler done) {
+        auto u = start(job, std::move(done));
+        u->manifestData.open(QIODevice::WriteOnly);
+        DownloadOptions options = m_options;
+        options.range = {};
+        u->manifestId = m_downloader->download(job.manifestUrl, &u->manifestData,
+            [this, weak = std::weak_ptr<Update>(u)](const DownloadResult& r) {
+                auto u = weak.lock();
+                if (!u)
+                    return;
+                u->manifestId = 0;
+                u->result.manifestBytes = r.bytes;
+                if (!r.error.isEmpty()) {
+                    finish(u, "Block manifest: " + r.error);
+                    return;
+                }
+                try {
+                    u->manifest = BlockManifest::fromCbor(u->manifestData.data());
+                } catch (const std::exception& e) {
+                    finish(u, QString::fromUtf8(e.what()));
+                    return;
+                }
+                u->manifestData.close();
+                u->manifestData.setData({});
+                plan(u);
+            },
+            options);
+    }
+
+    /// @brief Update `job.targetPath` with an already known manifest
+    void update(const DeltaJob& job, const BlockManifest& manifest, Handler done) {
+        auto u = start(job, std::move(done));
+        u->manifest = manifest;
+        plan(u);
+    }
+
+    /// @brief Number of running updates
+    qsizetype active() const { return static_cast<qsizetype>(m_updates.size()); }
+
+private:
+    struct Fetch {
+        ByteRange range;
+        QBuffer data;
+        quint64 id = 0;
+    };
+
+    struct Update {
+        DeltaResult result;
+        Handler done;
+        QElapsedTimer clock;
+        BlockManifest manifest;
+        QBuffer manifestData;
+        quint64 manifestId = 0;
+        std::thread worker;                             ///< Scan or final check
+        QFile part;                                     ///< "<target>.part", written by fetches
+        std::deque<ByteRange> pending;                  ///< Ranges not requested yet
+        std::vector<std::unique_ptr<Fetch>> fetches;    ///< Requested ranges
+    };
+
+    static QString partPath(const Update& u) { return u.result.job.targetPath + QStringLiteral(".part"); }
+
+    std::shared_ptr<Update> start(const DeltaJob& job, Handler done) {
+        auto u = std::make_shared<Update>();
+        u->result.job = job;
+        u->done = std::move(done);
+        u->clock.start();
+        m_updates.push_back(u);
+        return u;
+    }
+
+    /// Run `work` on the update's worker thread, then `then` on this thread
+    template <typename Work, typename Then>
+    void runWorker(const std::shared_ptr<Update>& u, Work work, Then then) {
+        u->worker = std::thread([this, raw = u.get(), weak = std::weak_ptr<Update>(u), work, then] {
+            auto outcome = work(*raw);
+            QMetaObject::invokeMethod(&m_context, [this, weak, then, outcome = std::move(outcome)] {
+                auto u = weak.lock();
+                if (!u)
+                    return;
+                u->worker.join();
+                (this->*then)(u, outcome);
+            }, Qt::QueuedConnection);
+        });
+    }
+
+    struct Planned {
+        BlockPlan plan;
+        QString error;
+    };
+
+    /// Scan the old file and copy the blocks found into the part file
+    void plan(const std::shared_ptr<Update>& u) {
+        u->result.length = u->manifest.length;
+        const unsigned threads = m_threads;
+        runWorker(u, [threads](const Update& update) {
+            Planned out;
+            const BlockManifest& manifest = update.manifest;
+            QFile basis(update.result.job.basisPath);
+            const uchar* old = nullptr;
+            if (basis.open(QIODevice::ReadOnly) && basis.size() > 0)
+                old = basis.map(0, basis.size());
+            out.plan = planDelta(manifest, old, old ? basis.size() : 0, threads);
+
+            QFile part(partPath(update));
+            if (!part.open(QIODevice::WriteOnly | QIODevice::Truncate) || !part.resize(manifest.length)) {
+                out.error = "Cannot create " + part.fileName() + ": " + part.errorString();
+                return out;
+            }
+            // Runs of blocks that are also consecutive in the old file are copied at once
+            for (qsizetype i = 0; i < manifest.blockCount();) {
+                if (out.plan.source[i] < 0) {
+                    ++i;
+                    continue;
+                }
+                qsizetype end = i + 1;
+                while (end < manifest.blockCount()
+                       && out.plan.source[end] == out.plan.source[i] + manifest.blockOffset(end - i))
+                    ++end;
+                const qint64 length = manifest.blockOffset(end - 1) + manifest.blockLength(end - 1)
+                                      - manifest.blockOffset(i);
+                if (!part.seek(manifest.blockOffset(i))
+                    || part.write(reinterpret_cast<const char*>(old + out.plan.source[i]), length) != length) {
+                    out.error = "Cannot write " + part.fileName() + ": " + part.errorString();
+                    return out;
+                }
+                i = end;
+            }
+            if (!part.flush())
+                out.error = "Cannot write " + part.fileName() + ": " + part.errorString();
+            return out;
+        }, &DeltaDownloader::planned);
+    }
+
+    void planned(const std::shared_ptr<Update>& u, const Planned& out) {
+        if (!out.error.isEmpty()) {
+            finish(u, out.error);
+            return;
+        }
+        u->result.reusedBytes = out.plan.reusedBytes;
+        const auto ranges = out.plan.missingRanges(u->manifest, m_maxRangeLength);
+        u->pending.assign(ranges.begin(), ranges.end());
+        u->part.setFileName(partPath(*u));
+        if (!u->part.open(QIODevice::ReadWrite)) {
+            finish(u, "Cannot open " + u->part.fileName() + ": " + u->part.errorString());
+            return;
+        }
+        fetchMore(u);
+    }
+
+    /// Keep parallelRanges() requests running; verify once all arrived
+    void fetchMore(const std::shared_ptr<Update>& u) {
+        while (!u->pending.empty() && std::ssize(u->fetches) < m_parallelRanges) {
+            auto fetch = std::make_unique<Fetch>();
+            fetch->range = u->pending.front();
+            u->pending.pop_front();
+            fetch->data.open(QIODevice::WriteOnly);
+            DownloadOptions options = m_options;
+            options.range = fetch->range;
+            Fetch* raw = fetch.get();
+            u->fetches.push_back(std::move(fetch));
+            ++u->result.rangeRequests;
+            raw->id = m_downloader->download(u->result.job.assetUrl, &raw->data,
+                [this, raw, weak = std::weak_ptr<Update>(u)](const DownloadResult& r) {
+                    if (auto u = weak.lock())
+                        fetched(u, raw, r);
+                },
+                options);
+        }
+        if (u->pending.empty() && u->fetches.empty()) {
+            u->part.close();
+            runWorker(u, [](const Update& update) -> QString {
+                QFile file(partPath(update));
+                QCryptographicHash hash(QCryptographicHash::Sha256);
+                if (!file.open(QIODevice::ReadWrite) || !hash.addData(&file))
+                    return "Cannot read " + file.fileName() + ": " + file.errorString();
+                if (hash.result() != update.manifest.sha256)
+                    return QStringLiteral("The rebuilt file does not match the manifest's SHA-256");
+                if (!syncFile(file))
+                    return "Cannot sync " + file.fileName() + ": " + QString::fromLocal8Bit(std::strerror(errno));
+                return {};
+            }, &DeltaDownloader::verified);
+        }
+    }
+
+    /// Check a range block by block and write it into the part file
+    void fetched(const std::shared_ptr<Update>& u, Fetch* fetch, const DownloadResult& r) {
+        std::unique_ptr<Fetch> owned;
+        for (auto it = u->fetches.begin(); it != u->fetches.end(); ++it) {
+            if (it->get() == fetch) {
+                owned = std::move(*it);
+                u->fetches.erase(it);
+                break;
+            }
+        }
+        u->result.fetchedBytes += r.bytes;
+        if (!r.error.isEmpty()) {
+            finish(u, QStringLiteral("Range %1-%2: ").arg(fetch->range.offset)
+                          .arg(fetch->range.offset + fetch->range.length - 1) + r.error);
+            return;
+        }
+        const BlockManifest& manifest = u->manifest;
+        const QByteArrayView data(fetch->data.data());
+        for (qint64 offset = 0; offset < data.size(); offset += manifest.blockSize) {
+            const qsizetype block = (fetch->range.offset + offset) / manifest.blockSize;
+            if (!manifest.matches(block, data.sliced(offset, manifest.blockLength(block)))) {
+                finish(u, QStringLiteral("Block %1 does not match the manifest").arg(block));
+                return;
+            }
+        }
+        if (!u->part.seek(fetch->range.offset) || u->part.write(fetch->data.data()) != data.size()) {
+            finish(u, "Cannot write " + u->part.fileName() + ": " + u->part.errorString());
+            return;
+        }
+        fetchMore(u);
+    }
+
+    void verified(const std::shared_ptr<Update>& u, const QString& error) {
+        if (!error.isEmpty()) {
+            finish(u, error);
+            return;
+        }
+        std::error_code ec;
+        std::filesystem::rename(std::filesystem::path(partPath(*u).toStdU16String()),
+                                std::filesystem::path(u->result.job.targetPath.toStdU16String()), ec);
+        if (!ec)
+            syncDirectory(QFileInfo(u->result.job.targetPath).absolutePath());
+        finish(u, ec ? QStringLiteral("Cannot replace %1: %2").arg(u->result.job.targetPath,
+                                                                    QString::fromStdString(ec.message()))
+                     : QString());
+    }
+
+    /// Flush a file opened for writing to the device, before it is renamed
+    static bool syncFile(QFile& file) {
+#if defined(Q_OS_UNIX)
+        return ::fsync(file.handle()) == 0;
+#elif defined(Q_OS_WIN)
+        return ::_commit(file.handle()) == 0;
+#else
+        return true;
+#endif
+    }
+
+    /// Make a rename in `dir` durable; best effort, as not every file system
+    /// supports syncing directories (nothing to do outside POSIX)
+    static void syncDirectory(const QString& dir) {
+#if defined(Q_OS_UNIX)
+        const int fd = ::open(QFile::encodeName(dir).constData(), O_RDONLY | O_DIRECTORY);
+        if (fd >= 0) {
+            ::fsync(fd);
+            ::close(fd);
+        }
+#else
+        Q_UNUSED(dir);
+#endif
+    }
+
+    /// Report the outcome; on errors the part file is removed
+    void finish(const std::shared_ptr<Update>& u, const QString& error) {
+        std::erase(m_updates, u);
+        for (const auto& fetch : u->fetches)
+            m_downloader->cancel(fetch->id);
+        u->fetches.clear();
+        u->part.close();
+        if (!error.isEmpty())
+            QFile::remove(partPath(*u));
+        u->result.error = error;
+        u->result.elapsed = std::chrono::nanoseconds(u->clock.nsecsElapsed());
+        if (u->done)
+            u->done(u->result);
+    }
+
+    std::unique_ptr<AssetDownloader> m_own;
+    AssetDownloader* m_downloader;
+    QObject m_context;                              ///< Receives the workers' results
+    std::vector<std::shared_ptr<Update>> m_updates;
+    DownloadOptions m_options;
+    qint64 m_maxRangeLength = kMaxRangeLength;
+    int m_parallelRanges = 4;
+    unsigned m_threads = 0;
+};
+
+} // namespace qtgh
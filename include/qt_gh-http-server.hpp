@@ -0,0 +1,251 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: 2026 Zheng-Bote
+//
+// qt_gh-http-server.hpp - Minimal embedded HTTP/1.1 server
+//
+// A small QTcpServer based HTTP/1.1 server for the library's optional
+// service endpoints (webhook receiver, caching proxy). Supports
+// Content-Length request bodies and keep-alive connections; responses may
+// be produced asynchronously. It is not meant to face the internet
+// directly: put a TLS-terminating reverse proxy in front of it.
+//
+// Usage:
+//   #include "qt_gh-http-server.hpp"
+//   qtgh::HttpServer server([](const qtgh::HttpRequest& req, qtgh::HttpServer::Responder respond) {
+//       respond({200, "text/plain", {}, "hello\n"});
+//   });
+//   server.listen(QHostAddress::LocalHost, 8080);
+
+#pragma once
+#include <QByteArray>
+#include <QHash>
+#include <QHostAddress>
+#include <QList>
+#include <QPair>
+#include <QPointer>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <functional>
+#include <memory>
+
+namespace qtgh {
+
+// ---------------------------------------------------------
+// Requests and Responses
+// ---------------------------------------------------------
+/// @brief A parsed HTTP request
+struct HttpRequest {
+    QByteArray method;                      ///< e.g. "GET", "POST"
+    QByteArray path;                        ///< Request target including query
+    QHash<QByteArray, QByteArray> headers;  ///< Header fields, names in lower case
+    QByteArray body;                        ///< Request body
+
+    /// @brief Header value by lower-case name (empty if absent)
+    QByteArray header(const QByteArray& name) const { return headers.value(name); }
+};
+
+/// @brief An HTTP response to be written by the server
+struct HttpResponse {
+    int status = 200;                               ///< Status code
+    QByteArray contentType;                         ///< Content-Type (omitted if empty)
+    QList<QPair<QByteArray, QByteArray>> headers;   ///< Additional header fields
+    QByteArray body;                                ///< Response body
+};
+
+// ---------------------------------------------------------
+// HttpServer
+// ---------------------------------------------------------
+/// @brief Minimal HTTP/1.1 server with asynchronous handlers
+///
+/// The handler receives each request together with a Responder that must
+/// be called exactly once, either immediately or later (e.g. after an
+/// upstream request finished). Requests on one connection are processed
+/// in order; the next request is parsed after the previous response was
+/// written. Responses to HEAD requests carry the Content-Length of the
+/// body the handler produced, without the body itself. Chunked request
+/// bodies are rejected with 411. After a request
+/// that cannot be parsed (400, 411, 413, 431) the connection is closed and
+/// any further input on it is discarded.
+class HttpServer {
+public:
+    using Responder = std::function<void(const HttpResponse&)>;
+    using Handler   = std::function<void(const HttpRequest&, Responder)>;
+
+    explicit HttpServer(Handler handler) : m_handler(std::move(handler)) {
+        QObject::connect(&m_server, &QTcpServer::newConnection, &m_server,
+                         [this] { acceptConnections(); });
+    }
+
+    HttpServer(const HttpServer&) = delete;
+    HttpServer& operator=(const HttpServer&) = delete;
+
+    /// @brief Start listening
+    /// @param address Bind address (default: loopback only)
+    /// @param port TCP port (0 = pick a free port, see serverPort())
+    /// @return true on success
+    bool listen(const QHostAddress& address = QHostAddress::LocalHost, quint16 port = 0) {
+        return m_server.listen(address, port);
+    }
+
+    /// @brief Stop listening; open connections stay until they are closed
+    void close() { m_server.close(); }
+
+    bool isListening() const { return m_server.isListening(); }
+    quint16 serverPort() const { return m_server.serverPort(); }
+    QString errorString() const { return m_server.errorString(); }
+
+    /// @brief Maximum accepted request body size in bytes (default 1 MiB)
+    void setMaxBodySize(qsizetype bytes) { m_maxBodySize = bytes; }
+
+    /// @brief Standard reason phrase for the status codes used by the library
+    static QByteArray reasonPhrase(int status) {
+        switch (status) {
+        case 200: return "OK";
+        case 202: return "Accepted";
+        case 204: return "No Content";
+        case 206: return "Partial Content";
+        case 304: return "Not Modified";
+        case 400: return "Bad Request";
+        case 401: return "Unauthorized";
+        case 404: return "Not Found";
+        case 405: return "Method Not Allowed";
+        case 411: return "Length Required";
+        case 413: return "Content Too Large";
+        case 416: return "Range Not Satisfiable";
+        case 431: return "Request Header Fields Too Large";
+        case 500: return "Internal Server Error";
+        case 502: return "Bad Gateway";
+        case 503: return "Service Unavailable";
+        case 504: return "Gateway Timeout";
+        default:  return "Unknown";
+        }
+    }
+
+private:
+    struct Connection {
+        QByteArray buffer;
+        bool busy = false;      ///< A response is outstanding
+        bool closed = false;    ///< Connection: close was sent; further input is discarded
+    };
+
+    static constexpr qsizetype kMaxHeaderSize = 16 * 1024;
+
+    void acceptConnections() {
+        while (QTcpSocket* socket = m_server.nextPendingConnection()) {
+            auto conn = std::make_shared<Connection>();
+            QObject::connect(socket, &QTcpSocket::readyRead, socket, [this, socket, conn] {
+                if (conn->closed) {
+                    socket->readAll();
+                    return;
+                }
+                conn->buffer.append(socket->readAll());
+                process(socket, conn);
+            });
+            QObject::connect(socket, &QTcpSocket::disconnected, socket, &QObject::deleteLater);
+        }
+    }
+
+    void process(QTcpSocket* socket, const std::shared_ptr<Connection>& conn) {
+        if (conn->busy || conn->closed)
+            return;
+
+        const qsizetype headerEnd = conn->buffer.indexOf("\r\n\r\n");
+        if (headerEnd < 0) {
+            if (conn->buffer.size() > kMaxHeaderSize)
+                reject(socket, conn, {431, "text/plain", {}, "Header too large\n"});
+            return;
+        }
+
+        HttpRequest req;
+        const QList<QByteArray> lines = conn->buffer.left(headerEnd).split('\n');
+        const QList<QByteArray> requestLine = lines.value(0).trimmed().split(' ');
+        if (requestLine.size() != 3 || !requestLine.at(2).startsWith("HTTP/1.")) {
+            reject(socket, conn, {400, "text/plain", {}, "Malformed request line\n"});
+            return;
+        }
+        req.method = requestLine.at(0);
+        req.path   = requestLine.at(1);
+        for (qsizetype i = 1; i < lines.size(); ++i) {
+            const qsizetype colon = lines.at(i).indexOf(':');
+            if (colon > 0)
+                req.headers.insert(lines.at(i).left(colon).trimmed().toLower(),
+                                   lines.at(i).mid(colon + 1).trimmed());
+        }
+
+        if (req.header("transfer-encoding").toLower().contains("chunked")) {
+            reject(socket, conn, {411, "text/plain", {}, "Chunked bodies are not supported\n"});
+            return;
+        }
+
+        bool ok = true;
+        const QByteArray lengthField = req.header("content-length");
+        const qsizetype length = lengthField.isEmpty() ? 0 : lengthField.toLongLong(&ok);
+        if (!ok || length < 0) {
+            reject(socket, conn, {400, "text/plain", {}, "Invalid Content-Length\n"});
+            return;
+        }
+        if (length > m_maxBodySize) {
+            reject(socket, conn, {413, "text/plain", {}, "Body too large\n"});
+            return;
+        }
+        if (conn->buffer.size() < headerEnd + 4 + length)
+            return;     // wait for the rest of the body
+
+        req.body = conn->buffer.mid(headerEnd + 4, length);
+        conn->buffer.remove(0, headerEnd + 4 + length);
+
+        const QByteArray connection = req.header("connection").toLower();
+        const bool keepAlive = requestLine.at(2) == "HTTP/1.1" ? connection != "close"
+                                                                : connection == "keep-alive";
+        const bool head = req.method == "HEAD";
+
+        conn->busy = true;
+        QPointer<QTcpSocket> guard(socket);
+        m_handler(req, [this, guard, conn, keepAlive, head](const HttpResponse& response) {
+            if (!guard)
+                return;
+            conn->busy = false;
+            if (!keepAlive) {
+                conn->closed = true;
+                conn->buffer.clear();
+            }
+            writeResponse(guard, response, keepAlive, head);
+            if (keepAlive && !conn->buffer.isEmpty())
+                process(guard, conn);
+        });
+    }
+
+    /// Answer a request that cannot be parsed and close the connection;
+    /// whatever the client sends afterwards is discarded
+    static void reject(QTcpSocket* socket, const std::shared_ptr<Connection>& conn,
+                       const HttpResponse& response) {
+        conn->closed = true;
+        conn->buffer.clear();
+        writeResponse(socket, response, false);
+    }
+
+    static void writeResponse(QTcpSocket* socket, const HttpResponse& response, bool keepAlive,
+                              bool head = false) {
+        QByteArray out;
+        out.reserve(128 + response.body.size());
+        out += "HTTP/1.1 " + QByteArray::number(response.status) + ' '
+             + reasonPhrase(response.status) + "\r\n";
+        if (!response.contentType.isEmpty())
+            out += "Content-Type: " + response.contentType + "\r\n";
+        for (const auto& [name, value] : response.headers)
+            out += name + ": " + value + "\r\n";
+        out += "Content-Length: " + QByteArray::number(response.body.size()) + "\r\n";
+        out += keepAlive ? "Connection: keep-alive\r\n\r\n" : "Connection: close\r\n\r\n";
+        if (!head)
+            out += response.body;
+        socket->write(out);
+        if (!keepAlive)
+            socket->disconnectFromHost();
+    }
+
+    QTcpServer m_server;
+    Handler m_handler;
+    qsizetype m_maxBodySize = 1024 * 1024;
+};
+
+} // namespace qtgh
@@ -0,0 +1,694 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: 2026 Zheng-Bote
+//
+// qt_gh-manifest-scanner.hpp - Build manifest scanner
+//
+// Walks a source tree in parallel and extracts GitHub repository + pinned
+// version pairs from build manifests, so they can be fed to the update
+// checker.
+//
+// Recognized manifests:
+// - CMakeLists.txt / *.cmake: FetchContent_Declare, ExternalProject_Add,
+//   CPMAddPackage and vcpkg_from_github (portfile.cmake)
+// - vcpkg.json: "homepage" on GitHub plus "version*" field (overlay ports)
+// - conanfile.py: "homepage"/"url" on GitHub plus "version" attribute
+// - conandata.yml: GitHub source archive URLs
+// - .gitmodules: submodule "url" (version taken from "branch" if it is a tag)
+//
+// Usage:
+//   #include "qt_gh-manifest-scanner.hpp"
+//   qtgh::ManifestScanner scanner;
+//   auto stats = scanner.scan("/path/to/src", [](const qtgh::ManifestEntry& e) {
+//       // called concurrently from worker threads
+//   });
+
+#pragma once
+#include <QByteArray>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QString>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace qtgh {
+
+// ---------------------------------------------------------
+// Manifest Entries
+// ---------------------------------------------------------
+/// @brief Kind of manifest an entry was extracted from
+enum class ManifestKind {
+    CMake,          ///< CMakeLists.txt or *.cmake
+    Vcpkg,          ///< vcpkg.json
+    Conan,          ///< conanfile.py or conandata.yml
+    GitSubmodule    ///< .gitmodules
+};
+
+/// @brief A GitHub dependency declaration found in a manifest
+struct ManifestEntry {
+    QString repoUrl;    ///< Canonical https://github.com/owner/repo URL
+    QString version;    ///< Pinned version or tag (empty if none is pinned)
+    QString file;       ///< Manifest file path
+    int line = 0;       ///< 1-based line of the declaration
+    ManifestKind kind = ManifestKind::CMake;
+};
+
+/// @brief Counters reported by ManifestScanner::scan()
+struct ScanStats {
+    std::size_t directories = 0;    ///< Directories visited
+    std::size_t files = 0;          ///< Regular files visited
+    std::size_t manifests = 0;      ///< Candidate manifest files parsed
+    std::size_t entries = 0;        ///< Entries emitted
+    std::chrono::milliseconds elapsed{0};
+};
+
+namespace detail {
+
+// ---------------------------------------------------------
+// String helpers (operate on the memory-mapped file content)
+// ---------------------------------------------------------
+inline char asciiLower(char c) {
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+/// Case-insensitive find of an ASCII needle
+inline std::size_t ifind(std::string_view hay, std::string_view needle,
+                         std::size_t pos = 0) {
+    if (needle.empty() || hay.size() < needle.size())
+        return std::string_view::npos;
+    const char first = asciiLower(needle.front());
+    for (std::size_t i = pos; i + needle.size() <= hay.size(); ++i) {
+        if (asciiLower(hay[i]) != first)
+            continue;
+        std::size_t k = 1;
+        while (k < needle.size() && asciiLower(hay[i + k]) == asciiLower(needle[k]))
+            ++k;
+        if (k == needle.size())
+            return i;
+    }
+    return std::string_view::npos;
+}
+
+inline bool iequals(std::string_view a, std::string_view b) {
+    return a.size() == b.size() && ifind(a, b) == 0;
+}
+
+inline bool isSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+inline std::string_view trim(std::string_view s) {
+    while (!s.empty() && isSpace(s.front()))
+        s.remove_prefix(1);
+    while (!s.empty() && isSpace(s.back()))
+        s.remove_suffix(1);
+    return s;
+}
+
+inline std::string_view unquote(std::string_view s) {
+    s = trim(s);
+    if (s.size() >= 2 && (s.front() == '"' || s.front() == '\'') && s.back() == s.front())
+        s = s.substr(1, s.size() - 2);
+    return s;
+}
+
+inline QString toQString(std::string_view s) {
+    return QString::fromUtf8(s.data(), static_cast<qsizetype>(s.size()));
+}
+
+/// True if pos lies behind a '#' on the same line (CMake/Python/YAML comment)
+inline bool inLineComment(std::string_view text, std::size_t pos) {
+    for (std::size_t i = pos; i > 0; --i) {
+        const char c = text[i - 1];
+        if (c == '\n')
+            return false;
+        if (c == '#')
+            return true;
+    }
+    return false;
+}
+
+/// Line counter that advances monotonically through a buffer
+class LineCounter {
+public:
+    explicit LineCounter(std::string_view text) : m_text(text) {}
+    int lineAt(std::size_t pos) {
+        if (pos < m_pos) {
+            m_pos = 0;
+            m_line = 1;
+        }
+        m_line += static_cast<int>(std::count(m_text.begin() + static_cast<std::ptrdiff_t>(m_pos),
+                                              m_text.begin() + static_cast<std::ptrdiff_t>(pos), '\n'));
+        m_pos = pos;
+        return m_line;
+    }
+private:
+    std::string_view m_text;
+    std::size_t m_pos = 0;
+    int m_line = 1;
+};
+
+/// A GitHub repository reference parsed out of a URL
+struct GithubRef {
+    std::string_view owner;
+    std::string_view repo;
+    std::string_view tag;   ///< Tag from an archive/release URL, if any
+};
+
+inline bool isUrlTerminator(char c) {
+    return isSpace(c) || c == '"' || c == '\'' || c == ')' || c == '#'
+        || c == '?' || c == ',' || c == ']';
+}
+
+/// Parse https://github.com/owner/repo[.git][/archive/...] and
+/// git@github.com:owner/repo.git
+inline std::optional<GithubRef> parseGithubUrl(std::string_view s) {
+    auto at = ifind(s, "github.com");
+    if (at == std::string_view::npos)
+        return std::nullopt;
+    // Reject api.github.com, raw.githubusercontent.com etc.
+    if (at > 0 && s[at - 1] != '/' && s[at - 1] != '@' && s[at - 1] != '.')
+        return std::nullopt;
+    if (at >= 4 && s.substr(at - 4, 4) == "api.")
+        return std::nullopt;
+    std::size_t p = at + 10;
+    if (p >= s.size() || (s[p] != '/' && s[p] != ':'))
+        return std::nullopt;
+    ++p;
+
+    auto segment = [&](std::size_t& pos) {
+        const std::size_t begin = pos;
+        while (pos < s.size() && s[pos] != '/' && !isUrlTerminator(s[pos]))
+            ++pos;
+        return s.substr(begin, pos - begin);
+    };
+
+    GithubRef ref;
+    ref.owner = segment(p);
+    if (p >= s.size() || s[p] != '/')
+        return std::nullopt;
+    ++p;
+    ref.repo = segment(p);
+    if (ref.repo.size() > 4 && ref.repo.substr(ref.repo.size() - 4) == ".git")
+        ref.repo.remove_suffix(4);
+    if (ref.owner.empty() || ref.repo.empty())
+        return std::nullopt;
+
+    if (p < s.size() && s[p] == '/') {
+        std::size_t end = p;
+        while (end < s.size() && !isUrlTerminator(s[end]))
+            ++end;
+        std::string_view rest = s.substr(p + 1, end - p - 1);
+
+        auto stripArchiveExt = [](std::string_view t) {
+            for (std::string_view ext : {".tar.gz", ".tar.bz2", ".tar.xz", ".tgz", ".zip"}) {
+                if (t.size() > ext.size() && t.substr(t.size() - ext.size()) == ext)
+                    return t.substr(0, t.size() - ext.size());
+            }
+            return t;
+        };
+
+        if (rest.starts_with("archive/refs/tags/")) {
+            ref.tag = stripArchiveExt(rest.substr(18));
+        } else if (rest.starts_with("archive/")) {
+            ref.tag = stripArchiveExt(rest.substr(8));
+        } else if (rest.starts_with("releases/download/")) {
+            rest.remove_prefix(18);
+            ref.tag = rest.substr(0, rest.find('/'));
+        }
+    }
+    return ref;
+}
+
+/// Parse an "owner/repo" slug (vcpkg REPO, CPM "gh:", GITHUB_REPOSITORY);
+/// both parts must be non-empty and free of '/' and URL terminators
+inline std::optional<GithubRef> parseRepoSlug(std::string_view s) {
+    const auto slash = s.find('/');
+    if (slash == std::string_view::npos)
+        return std::nullopt;
+    GithubRef ref{s.substr(0, slash), s.substr(slash + 1), {}};
+    if (ref.repo.size() > 4 && ref.repo.substr(ref.repo.size() - 4) == ".git")
+        ref.repo.remove_suffix(4);
+    auto valid = [](std::string_view part) {
+        return !part.empty() && std::none_of(part.begin(), part.end(), [](char c) {
+            return c == '/' || isUrlTerminator(c);
+        });
+    };
+    if (!valid(ref.owner) || !valid(ref.repo))
+        return std::nullopt;
+    return ref;
+}
+
+inline QString canonicalRepoUrl(const GithubRef& ref) {
+    return QStringLiteral("https://github.com/%1/%2")
+        .arg(toQString(ref.owner), toQString(ref.repo));
+}
+
+/// Split the argument list of a CMake command invocation into tokens
+inline std::vector<std::string_view> cmakeArgs(std::string_view args) {
+    std::vector<std::string_view> out;
+    std::size_t i = 0;
+    while (i < args.size()) {
+        while (i < args.size() && isSpace(args[i]))
+            ++i;
+        if (i >= args.size())
+            break;
+        if (args[i] == '#') {
+            while (i < args.size() && args[i] != '\n')
+                ++i;
+            continue;
+        }
+        if (args[i] == '"') {
+            const std::size_t end = args.find('"', i + 1);
+            const std::size_t stop = end == std::string_view::npos ? args.size() : end;
+            out.push_back(args.substr(i + 1, stop - i - 1));
+            i = stop + 1;
+            continue;
+        }
+        const std::size_t begin = i;
+        while (i < args.size() && !isSpace(args[i]))
+            ++i;
+        out.push_back(args.substr(begin, i - begin));
+    }
+    return out;
+}
+
+/// Value following keyword in a CMake argument list
+inline std::string_view cmakeKeyword(const std::vector<std::string_view>& args,
+                                     std::string_view keyword) {
+    for (std::size_t i = 0; i + 1 < args.size(); ++i) {
+        if (args[i] == keyword)
+            return args[i + 1];
+    }
+    return {};
+}
+
+/// Extract `name = "value"` (Python/INI style) at the start of a line
+inline std::optional<std::pair<std::string_view, std::size_t>>
+assignment(std::string_view text, std::string_view name, std::size_t from = 0) {
+    std::size_t pos = from;
+    while ((pos = text.find(name, pos)) != std::string_view::npos) {
+        const std::size_t hit = pos;
+        pos += name.size();
+        std::size_t ls = hit;
+        while (ls > 0 && (text[ls - 1] == ' ' || text[ls - 1] == '\t'))
+            --ls;
+        if (ls > 0 && text[ls - 1] != '\n')
+            continue;
+        std::size_t p = hit + name.size();
+        while (p < text.size() && (text[p] == ' ' || text[p] == '\t'))
+            ++p;
+        if (p >= text.size() || text[p] != '=')
+            continue;
+        const std::size_t eol = std::min(text.find('\n', p), text.size());
+        return std::pair{unquote(text.substr(p + 1, eol - p - 1)), hit};
+    }
+    return std::nullopt;
+}
+
+// ---------------------------------------------------------
+// Per-format parsers
+// ---------------------------------------------------------
+template <typename Emit>
+void parseCMake(std::string_view text, Emit&& emit) {
+    LineCounter lines(text);
+    for (std::string_view command : {"fetchcontent_declare", "externalproject_add",
+                                     "cpmaddpackage", "vcpkg_from_github"}) {
+        std::size_t pos = 0;
+        while ((pos = ifind(text, command, pos)) != std::string_view::npos) {
+            const std::size_t hit = pos;
+            pos += command.size();
+            if (inLineComment(text, hit))
+                continue;
+            std::size_t open = pos;
+            while (open < text.size() && isSpace(text[open]))
+                ++open;
+            if (open >= text.size() || text[open] != '(')
+                continue;
+            std::size_t close = open + 1;
+            int depth = 1;
+            for (; close < text.size() && depth > 0; ++close) {
+                if (text[close] == '(')
+                    ++depth;
+                else if (text[close] == ')')
+                    --depth;
+            }
+            const auto args = cmakeArgs(text.substr(open + 1, close - open - 2));
+            pos = close;
+
+            std::optional<GithubRef> ref;
+            std::string_view version;
+            if (command == "vcpkg_from_github") {
+                ref = parseRepoSlug(cmakeKeyword(args, "REPO"));
+                if (!ref)
+                    continue;
+                version = cmakeKeyword(args, "REF");
+            } else if (command == "cpmaddpackage" && !args.empty()
+                       && args.front().starts_with("gh:")) {
+                // CPMAddPackage("gh:owner/repo@1.2.3")
+                auto spec = args.front().substr(3);
+                const auto atSign = spec.find('@');
+                if (atSign != std::string_view::npos) {
+                    version = spec.substr(atSign + 1);
+                    spec = spec.substr(0, atSign);
+                }
+                ref = parseRepoSlug(spec);
+                if (!ref)
+                    continue;
+            } else {
+                if (auto gh = cmakeKeyword(args, "GITHUB_REPOSITORY"); !gh.empty())
+                    ref = parseRepoSlug(gh);
+                if (!ref)
+                    ref = parseGithubUrl(cmakeKeyword(args, "GIT_REPOSITORY"));
+                if (!ref)
+                    ref = parseGithubUrl(cmakeKeyword(args, "URL"));
+                if (!ref)
+                    continue;
+                version = cmakeKeyword(args, "GIT_TAG");
+                if (version.empty())
+                    version = cmakeKeyword(args, "VERSION");
+                if (version.empty())
+                    version = ref->tag;
+            }
+            emit(canonicalRepoUrl(*ref), toQString(version), lines.lineAt(hit));
+        }
+    }
+}
+
+template <typename Emit>
+void parseVcpkgJson(std::string_view text, Emit&& emit) {
+    const auto doc = QJsonDocument::fromJson(
+        QByteArray::fromRawData(text.data(), static_cast<qsizetype>(text.size())));
+    if (!doc.isObject())
+        return;
+    const auto obj = doc.object();
+    const QByteArray homepage = obj.value("homepage").toString().toUtf8();
+    const auto ref = parseGithubUrl(std::string_view(homepage.constData(),
+                                                     static_cast<std::size_t>(homepage.size())));
+    if (!ref)
+        return;
+    QString version;
+    for (const char* key : {"version-semver", "version", "version-string"}) {
+        version = obj.value(QLatin1StringView(key)).toString();
+        if (!version.isEmpty())
+            break;
+    }
+    emit(canonicalRepoUrl(*ref), version, 1);
+}
+
+template <typename Emit>
+void parseConanfile(std::string_view text, Emit&& emit) {
+    std::optional<GithubRef> ref;
+    std::size_t at = 0;
+    for (std::string_view attr : {"homepage", "url"}) {
+        if (auto value = assignment(text, attr)) {
+            ref = parseGithubUrl(value->first);
+            at = value->second;
+            if (ref)
+                break;
+        }
+    }
+    if (!ref)
+        return;
+    const auto version = assignment(text, "version");
+    LineCounter lines(text);
+    emit(canonicalRepoUrl(*ref), version ? toQString(version->first) : QString(),
+         lines.lineAt(at));
+}
+
+template <typename Emit>
+void parseConandata(std::string_view text, Emit&& emit) {
+    LineCounter lines(text);
+    std::size_t pos = 0;
+    while ((pos = ifind(text, "github.com/", pos)) != std::string_view::npos) {
+        std::size_t begin = pos;
+        while (begin > 0 && !isUrlTerminator(text[begin - 1]))
+            --begin;
+        pos += 11;
+        if (inLineComment(text, begin))
+            continue;
+        const auto ref = parseGithubUrl(text.substr(begin));
+        if (ref && !ref->tag.empty())
+            emit(canonicalRepoUrl(*ref), toQString(ref->tag), lines.lineAt(begin));
+    }
+}
+
+template <typename Emit>
+void parseGitmodules(std::string_view text, Emit&& emit) {
+    LineCounter lines(text);
+    std::size_t section = text.find("[submodule");
+    while (section != std::string_view::npos) {
+        const std::size_t next = text.find("[submodule", section + 1);
+        const std::string_view body = text.substr(section, next == std::string_view::npos
+                                                               ? std::string_view::npos
+                                                               : next - section);
+        if (auto url = assignment(body, "url")) {
+            if (const auto ref = parseGithubUrl(url->first)) {
+                std::string_view version;
+                if (auto branch = assignment(body, "branch")) {
+                    const auto b = branch->first;
+                    const std::size_t digit = (!b.empty() && (b.front() == 'v' || b.front() == 'V')) ? 1 : 0;
+                    if (b.size() > digit && b[digit] >= '0' && b[digit] <= '9')
+                        version = b;
+                }
+                emit(canonicalRepoUrl(*ref), toQString(version),
+                     lines.lineAt(section + url->second));
+            }
+        }
+        section = next;
+    }
+}
+
+} // namespace detail
+
+// ---------------------------------------------------------
+// ManifestScanner
+// ---------------------------------------------------------
+/// @brief Parallel directory walker that extracts GitHub dependencies
+///
+/// Directories are distributed over a pool of worker threads through a
+/// shared work stack; candidate files are memory-mapped and parsed in
+/// place without copying. Entries are handed to the sink as soon as they
+/// are found, so consumers can start checking while the walk continues.
+///
+/// @example
+///   qtgh::ManifestScanner scanner;
+///   std::mutex m;
+///   QList<qtgh::ManifestEntry> all;
+///   scanner.scan("src", [&](const qtgh::ManifestEntry& e) {
+///       std::lock_guard lock(m);
+///       all.append(e);
+///   });
+class ManifestScanner {
+public:
+    using Sink = std::function<void(const ManifestEntry&)>;
+
+    /// @brief Create a scanner
+    /// @param threads Number of walker threads (0 = hardware concurrency)
+    explicit ManifestScanner(unsigned threads = 0)
+        : m_threads(threads ? threads : std::max(1u, std::thread::hardware_concurrency())) {}
+
+    /// @brief Directory names that are never descended into
+    /// Defaults to ".git", ".svn", ".hg" and "node_modules".
+    void setExcludedDirectories(std::vector<std::string> names) {
+        m_excluded = std::move(names);
+    }
+
+    /// @brief Stop a running scan() after the directories being read
+    ///
+    /// Thread-safe. A cancelled scanner stays cancelled; later scans return
+    /// immediately.
+    void cancel() {
+        {
+            std::lock_guard lock(m_mutex);
+            m_cancelled = true;
+        }
+        m_wake.notify_all();
+    }
+
+    /// @brief Classify a file name as a manifest
+    /// @return The manifest kind, or std::nullopt if the file is not a candidate
+    static std::optional<ManifestKind> classify(std::string_view fileName) {
+        if (fileName == "CMakeLists.txt" || (fileName.size() > 6
+                && detail::iequals(fileName.substr(fileName.size() - 6), ".cmake")))
+            return ManifestKind::CMake;
+        if (fileName == "vcpkg.json")
+            return ManifestKind::Vcpkg;
+        if (fileName == "conanfile.py" || fileName == "conandata.yml")
+            return ManifestKind::Conan;
+        if (fileName == ".gitmodules")
+            return ManifestKind::GitSubmodule;
+        return std::nullopt;
+    }
+
+    /// @brief Extract entries from manifest content
+    /// @param kind Manifest kind (see classify())
+    /// @param fileName File name, used to distinguish conanfile.py/conandata.yml
+    /// @param content Raw file content
+    /// @param filePath Path stored in the emitted entries
+    /// @param sink Receives each entry
+    /// @return Number of entries emitted
+    static std::size_t parse(ManifestKind kind, std::string_view fileName,
+                             std::string_view content, const QString& filePath,
+                             const Sink& sink) {
+        std::size_t count = 0;
+        auto emit = [&](QString repoUrl, QString version, int line) {
+            sink(ManifestEntry{std::move(repoUrl), std::move(version), filePath, line, kind});
+            ++count;
+        };
+        switch (kind) {
+        case ManifestKind::CMake:        detail::parseCMake(content, emit); break;
+        case ManifestKind::Vcpkg:        detail::parseVcpkgJson(content, emit); break;
+        case ManifestKind::GitSubmodule: detail::parseGitmodules(content, emit); break;
+        case ManifestKind::Conan:
+            if (fileName == "conandata.yml")
+                detail::parseConandata(content, emit);
+            else
+                detail::parseConanfile(content, emit);
+            break;
+        }
+        return count;
+    }
+
+    /// @brief Walk a directory tree and report every GitHub dependency found
+    /// @param root Root directory of the scan
+    /// @param sink Receives each entry; called concurrently from worker threads
+    /// @return Scan statistics
+    /// @throws std::runtime_error if root is not a directory
+    /// @throws The first exception thrown by `sink`; the walk stops at the
+    ///   directories being read, as on cancel()
+    ScanStats scan(const QString& root, const Sink& sink) const {
+        namespace fs = std::filesystem;
+        const fs::path rootPath = root.toStdU16String();
+        std::error_code ec;
+        if (!fs::is_directory(rootPath, ec))
+            throw std::runtime_error(("Not a directory: " + root).toStdString());
+
+        const auto started = std::chrono::steady_clock::now();
+
+        // The scanner's mutex and condition variable, so cancel() can wake idle workers
+        std::mutex& mutex = m_mutex;
+        std::condition_variable& cv = m_wake;
+        std::vector<fs::path> work{rootPath};
+        unsigned busy = 0;
+        std::exception_ptr sinkError;
+        std::atomic<std::size_t> dirs{0}, files{0}, manifests{0}, entries{0};
+
+        auto worker = [&] {
+            std::vector<fs::path> found;
+            for (;;) {
+                fs::path dir;
+                {
+                    std::unique_lock lock(mutex);
+                    cv.wait(lock, [&] { return !work.empty() || busy == 0 || m_cancelled || sinkError; });
+                    if (work.empty() || m_cancelled || sinkError)
+                        return;
+                    dir = std::move(work.back());
+                    work.pop_back();
+                    ++busy;
+                }
+
+                ++dirs;
+                found.clear();
+                std::error_code iterEc;
+                for (fs::directory_iterator it(dir, fs::directory_options::skip_permission_denied, iterEc), end;
+                     !iterEc && it != end; it.increment(iterEc)) {
+                    const auto& de = *it;
+                    std::error_code typeEc;
+                    if (de.is_symlink(typeEc))
+                        continue;
+                    const std::string name = de.path().filename().string();
+                    if (de.is_directory(typeEc)) {
+                        if (std::find(m_excluded.begin(), m_excluded.end(), name) == m_excluded.end())
+                            found.push_back(de.path());
+                    } else if (de.is_regular_file(typeEc)) {
+                        ++files;
+                        if (const auto kind = classify(name)) {
+                            ++manifests;
+                            try {
+                                entries += scanFile(de.path(), *kind, name, sink);
+                            } catch (...) {
+                                {
+                                    std::lock_guard lock(mutex);
+                                    if (!sinkError)
+                                        sinkError = std::current_exception();
+                                    --busy;
+                                }
+                                cv.notify_all();
+                                return;
+                            }
+                        }
+                    }
+                }
+
+                {
+                    std::lock_guard lock(mutex);
+                    for (auto& sub : found)
+                        work.push_back(std::move(sub));
+                    --busy;
+                }
+                cv.notify_all();
+            }
+        };
+
+        std::vector<std::thread> pool;
+        pool.reserve(m_threads);
+        for (unsigned i = 0; i < m_threads; ++i)
+            pool.emplace_back(worker);
+        for (auto& t : pool)
+            t.join();
+        if (sinkError)
+            std::rethrow_exception(sinkError);
+
+        ScanStats stats;
+        stats.directories = dirs;
+        stats.files = files;
+        stats.manifests = manifests;
+        stats.entries = entries;
+        stats.elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - started);
+        return stats;
+    }
+
+private:
+    static std::size_t scanFile(const std::filesystem::path& path, ManifestKind kind,
+                                std::string_view name, const Sink& sink) {
+        QFile file(path);
+        if (!file.open(QIODevice::ReadOnly) || file.size() == 0)
+            return 0;
+
+        const QString filePath = QString::fromStdU16String(path.u16string());
+        if (uchar* mapped = file.map(0, file.size())) {
+            const std::string_view content(reinterpret_cast<const char*>(mapped),
+                                           static_cast<std::size_t>(file.size()));
+            const std::size_t n = parse(kind, name, content, filePath, sink);
+            file.unmap(mapped);
+            return n;
+        }
+
+        // Fall back to a regular read on file systems without mmap support
+        const QByteArray data = file.readAll();
+        return parse(kind, name, std::string_view(data.constData(),
+                                                  static_cast<std::size_t>(data.size())),
+                     filePath, sink);
+    }
+
+    unsigned m_threads;
+    std::vector<std::string> m_excluded{".git", ".svn", ".hg", "node_modules"};
+    std::atomic<bool> m_cancelled{false};
+    mutable std::mutex m_mutex;             ///< Guards the work stack of running scans
+    mutable std::condition_variable m_wake; ///< Wakes idle workers
+};
+
+} // namespace qtgh
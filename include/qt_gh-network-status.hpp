@@ -0,0 +1,178 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: 2026 Zheng-Bote
+//
+// qt_gh-network-status.hpp - Offline detection without sending a request
+//
+// On a laptop without Wi-Fi or an air-gapped host a check would otherwise
+// wait for DNS and connect timeouts before failing. NetworkStatus answers
+// "is the API reachable at all?" from what the system already knows:
+// - QNetworkInformation reachability (NetworkManager, netlink, ...), if a
+//   backend is available
+// - otherwise a cheap local probe: is any non-loopback interface up with
+//   an address? (cached for a second)
+//
+// Loopback targets (a caching proxy on this host) are never offline, and
+// only a disconnected host makes other targets offline. With local or
+// site connectivity, targets on the local network (private addresses,
+// single-label or .local names) are reachable and everything else is
+// unknown: the internet may still be reachable through a corporate
+// proxy, which the platform reports as local connectivity. No state is
+// kept, so the first check after connectivity returns goes out again.
+//
+// Usage:
+//   #include "qt_gh-network-status.hpp"
+//   if (qtgh::NetworkStatus::isKnownOffline(apiUrl))
+//       ... fail or serve cached data now ...
+
+#pragma once
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QHostAddress>
+#include <QMutex>
+#include <QNetworkInformation>
+#include <QNetworkInterface>
+#include <QThread>
+#include <QUrl>
+#include <atomic>
+#include <optional>
+
+namespace qtgh {
+
+// ---------------------------------------------------------
+// NetworkStatus
+// ---------------------------------------------------------
+/// @brief Reachability of check targets, answered without network traffic
+///
+/// All functions are static and thread-safe. The QNetworkInformation
+/// backend is loaded on first use from the application's main thread;
+/// calls from other threads before that fall back to the interface probe.
+///
+/// @example
+///   if (qtgh::NetworkStatus::isKnownOffline("https://api.github.com"))
+///       return showCachedResult();
+class NetworkStatus {
+public:
+    enum class State {
+        Online,     ///< Reachable as far as the system knows
+        Offline,    ///< Known to be unreachable; a request would only time out
+        Unknown     ///< No information (no backend and the probe was inconclusive)
+    };
+
+    /// @brief Reachability of a target URL
+    static State state(const QUrl& target) {
+        if (const int forced = s_override.load(std::memory_order_acquire); forced >= 0)
+            return static_cast<State>(forced);
+        if (isLoopback(target))
+            return State::Online;
+
+        ensureBackend();
+        if (auto* info = QNetworkInformation::instance();
+            info && info->supports(QNetworkInformation::Feature::Reachability)) {
+            const auto reachability = info->reachability();
+            if (reachability != QNetworkInformation::Reachability::Unknown)
+                return classify(reachability, target);
+        }
+        return interfacesUp() ? State::Unknown : State::Offline;
+    }
+
+    /// @brief True if a request to `target` cannot succeed right now
+    static bool isKnownOffline(const QString& target) {
+        return state(QUrl(target)) == State::Offline;
+    }
+
+    /// @brief Reachability policy for a known system state
+    ///
+    /// Disconnected is offline for every non-loopback target. With only
+    /// local or site connectivity, targets on the local network are online
+    /// and all others unknown, so requests through a proxy are still sent.
+    static State classify(QNetworkInformation::Reachability reachability, const QUrl& target) {
+        using R = QNetworkInformation::Reachability;
+        if (isLoopback(target))
+            return State::Online;
+        switch (reachability) {
+        case R::Disconnected:
+            return State::Offline;
+        case R::Local:
+        case R::Site:
+            return isLocalNetwork(target) ? State::Online : State::Unknown;
+        case R::Online:
+            return State::Online;
+        case R::Unknown:
+            break;
+        }
+        return State::Unknown;
+    }
+
+    /// @brief Force a state for every target (tests, benchmarks); nullopt restores detection
+    static void setOverride(std::optional<State> state) {
+        s_override.store(state ? static_cast<int>(*state) : -1, std::memory_order_release);
+    }
+
+    /// @brief Call `f` on `context`'s thread when the system reachability changes
+    /// @return false if no QNetworkInformation backend reports changes
+    template <typename Functor>
+    static bool onChange(QObject* context, Functor f) {
+        ensureBackend();
+        auto* info = QNetworkInformation::instance();
+        if (!info || !info->supports(QNetworkInformation::Feature::Reachability))
+            return false;
+        QObject::connect(info, &QNetworkInformation::reachabilityChanged, context,
+                         [f = std::move(f)](QNetworkInformation::Reachability) { f(); });
+        return true;
+    }
+
+private:
+    /// Load the platform backend once, from the main thread only
+    static void ensureBackend() {
+        if (s_backendTried.load(std::memory_order_acquire))
+            return;
+        auto* app = QCoreApplication::instance();
+        if (!app || QThread::currentThread() != app->thread())
+            return;
+        s_backendTried.store(true, std::memory_order_release);
+        if (!QNetworkInformation::instance())
+            QNetworkInformation::loadBackendByFeatures(QNetworkInformation::Feature::Reachability);
+    }
+
+    static bool isLoopback(const QUrl& target) {
+        const QString host = target.host();
+        if (host.compare(QLatin1String("localhost"), Qt::CaseInsensitive) == 0)
+            return true;
+        const QHostAddress address(host);
+        return !address.isNull() && address.isLoopback();
+    }
+
+    static bool isLocalNetwork(const QUrl& target) {
+        const QString host = target.host();
+        const QHostAddress address(host);
+        if (!address.isNull())
+            return address.isPrivateUse() || address.isLinkLocal() || address.isUniqueLocalUnicast();
+        return !host.contains(QLatin1Char('.')) || host.endsWith(QLatin1String(".local"));
+    }
+
+    /// Any interface besides loopback that is up and has an address
+    static bool interfacesUp() {
+        QMutexLocker lock(&s_probeLock);
+        if (s_probeTimer.isValid() && s_probeTimer.elapsed() < 1000)
+            return s_probeResult;
+        s_probeResult = false;
+        for (const QNetworkInterface& iface : QNetworkInterface::allInterfaces()) {
+            const auto flags = iface.flags();
+            if ((flags & QNetworkInterface::IsUp) && (flags & QNetworkInterface::IsRunning)
+                && !(flags & QNetworkInterface::IsLoopBack) && !iface.addressEntries().isEmpty()) {
+                s_probeResult = true;
+                break;
+            }
+        }
+        s_probeTimer.start();
+        return s_probeResult;
+    }
+
+    static inline std::atomic<int> s_override{-1};
+    static inline std::atomic<bool> s_backendTried{false};
+    static inline QMutex s_probeLock;
+    static inline QElapsedTimer s_probeTimer;
+    static inline bool s_probeResult = true;
+};
+
+} // namespace qtgh
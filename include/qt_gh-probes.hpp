@@ -0,0 +1,45 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: 2026 Zheng-Bote
+//
+// qt_gh-probes.hpp - Optional USDT static tracepoints
+//
+// When QTGH_ENABLE_USDT is defined (CMake option of the same name) the
+// check pipeline carries SystemTap/USDT probes under the provider "qtgh",
+// usable from perf, bpftrace and SystemTap. Otherwise every QTGH_PROBE*
+// macro expands to nothing and its arguments are not evaluated.
+//
+// Probes (arguments in order):
+//   request_start   id, url             HTTP request sent (http_get, BatchChecker)
+//   request_done    id, status, bytes   Response received; status 0 and
+//                                       bytes -1 on network errors
+//   parse_start     bytes               Release JSON parsing started
+//   parse_done      ok                  JSON document parsed (ok = is object)
+//   compare_start                       SemVer comparison started
+//   compare_done    hasUpdate           SemVer comparison finished
+//   cache_hit       slug                ReleaseCache lookup answered
+//   cache_miss      slug                ReleaseCache lookup missed
+//   retry           id, attempt, status Overloaded request queued again
+//                                       (BatchChecker with adaptive
+//                                       concurrency); attempt counts retries
+//
+// `id` is the address of the QNetworkReply and pairs start/done of one
+// request, also when many are in flight on one thread. Strings are
+// NUL-terminated UTF-8. Example scripts: tools/bpftrace/.
+//
+// Usage:
+//   bpftrace -l 'usdt:./qt_gh-update-checker:qtgh:*'
+
+#pragma once
+
+#if defined(QTGH_ENABLE_USDT)
+#include <sys/sdt.h>
+#define QTGH_PROBE(name)                    DTRACE_PROBE(qtgh, name)
+#define QTGH_PROBE1(name, a1)               DTRACE_PROBE1(qtgh, name, a1)
+#define QTGH_PROBE2(name, a1, a2)           DTRACE_PROBE2(qtgh, name, a1, a2)
+#define QTGH_PROBE3(name, a1, a2, a3)       DTRACE_PROBE3(qtgh, name, a1, a2, a3)
+#else
+#define QTGH_PROBE(name)                    do {} while (false)
+#define QTGH_PROBE1(name, a1)               do {} while (false)
+#define QTGH_PROBE2(name, a1, a2)           do {} while (false)
+#define QTGH_PROBE3(name, a1, a2, a3)       do {} while (false)
+#endif
@@ -0,0 +1,546 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: 2026 Zheng-Bote
+//
+// qt_gh-release-index.hpp - Incremental per-repository release index
+//
+// Questions like "how many releases are we behind" or "best 2.x release"
+// need every release of a repository, not just the latest one. Listing a
+// repository with a long history takes one request per 100 releases, so
+// ReleaseIndex keeps the list and only fetches what is new:
+//
+// - an empty index lists all pages (GET /repos/{owner}/{repo}/releases)
+// - later refreshes request a small first page with the ETag of the
+//   previous one; 304 Not Modified means nothing changed (and does not
+//   count against the rate limit for authenticated requests)
+// - otherwise pages are read newest first until a page contains a
+//   release that is already known; known releases on the pages read are
+//   refreshed, so a pre-release promoted to stable or a re-tagged recent
+//   release is picked up
+//
+// Releases are kept sorted by SemVer, so ReleaseHistory answers queries
+// with a binary search. The index is persisted as JSON with
+// save()/load(). Deleted releases, and edits to releases older than the
+// pages read, are not noticed by an incremental refresh; remove() the
+// repository to rebuild it.
+//
+// Usage:
+//   #include "qt_gh-release-index.hpp"
+//   qtgh::ReleaseIndex index;
+//   index.load(path);
+//   index.refresh("https://github.com/owner/repo", [&](const qtgh::ReleaseIndexRefresh& r) {
+//       auto history = index.history(r.slug);
+//       qDebug() << history->countNewerThan(qtgh::SemVer::parse("1.4.0"));
+//       index.save(path);
+//   });
+
+#pragma once
+#include "qt_gh-update-checker.hpp"
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QReadWriteLock>
+#include <QSaveFile>
+#include <QSet>
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <memory>
+
+namespace qtgh {
+
+// ---------------------------------------------------------
+// Release History
+// ---------------------------------------------------------
+/// @brief One release of a repository
+struct IndexedRelease {
+    qint64 id = 0;            ///< GitHub release id (unchanged when the tag is edited)
+    QString tag;              ///< tag_name
+    SemVer version;           ///< Parsed from the tag (zero if unversioned)
+    bool prerelease = false;  ///< Marked as pre-release on GitHub
+    QDateTime publishedAt;    ///< published_at (invalid if not reported)
+};
+
+/// @brief The known releases of one repository, sorted by SemVer
+///
+/// A value type; copies share their data until one of them is modified,
+/// so ReleaseIndex::history() hands out snapshots without copying the list.
+/// Queries are O(log n).
+///
+/// Releases whose tag contains no version ("nightly") are kept so that
+/// refreshes recognize them, but do not take part in queries.
+class ReleaseHistory {
+public:
+    /// @brief Versioned releases in ascending order, optionally without pre-releases
+    ///
+    /// Equal versions are ordered pre-releases first, then by publication.
+    const QList<IndexedRelease>& releases(bool includePrereleases = true) const {
+        return includePrereleases ? m_all : m_stable;
+    }
+
+    /// @brief Releases whose tag contains no version
+    const QList<IndexedRelease>& unversioned() const { return m_unversioned; }
+
+    /// @brief Number of versioned releases
+    qsizetype size(bool includePrereleases = true) const { return releases(includePrereleases).size(); }
+    bool isEmpty() const { return m_ids.isEmpty(); }
+
+    /// @brief Whether the release with GitHub id `id` is known
+    bool contains(qint64 id) const { return m_ids.contains(id); }
+
+    /// @brief Number of releases with a higher version than `version`
+    /// @example
+    ///   auto behind = history.countNewerThan(qtgh::SemVer::parse("1.4.0"));
+    qsizetype countNewerThan(const SemVer& version, bool includePrereleases = false) const {
+        const auto& list = releases(includePrereleases);
+        return list.cend() - upperBound(list, version);
+    }
+
+    /// @brief The release with the highest version
+    std::optional<IndexedRelease> latest(bool includePrereleases = false) const {
+        const auto& list = releases(includePrereleases);
+        if (list.isEmpty())
+            return std::nullopt;
+        return list.back();
+    }
+
+    /// @brief The highest release of a major (and optionally minor) series
+    /// @param minor Minor version, or -1 for any
+    /// @example
+    ///   auto best2x = history.latestInSeries(2);       // highest 2.y.z
+    ///   auto best24 = history.latestInSeries(2, 4);    // highest 2.4.z
+    std::optional<IndexedRelease> latestInSeries(int major, int minor = -1,
+                                                 bool includePrereleases = false) const {
+        constexpr int top = std::numeric_limits<int>::max();
+        const auto& list = releases(includePrereleases);
+        const auto it = upperBound(list, SemVer{major, minor < 0 ? top : minor, top});
+        if (it == list.cbegin())
+            return std::nullopt;
+        const IndexedRelease& found = *(it - 1);
+        if (found.version.major != major || (minor >= 0 && found.version.minor != minor))
+            return std::nullopt;
+        return found;
+    }
+
+    /// @brief Add releases; ones with a known id are skipped
+    /// @return Number of releases added
+    qsizetype add(QList<IndexedRelease> releases) {
+        QList<IndexedRelease> versioned, stable;
+        qsizetype added = 0;
+        for (IndexedRelease& release : releases) {
+            if (m_ids.contains(release.id))
+                continue;
+            m_ids.insert(release.id);
+            ++added;
+            if (!core::findVersion(std::u16string_view(release.tag.utf16(),
+                                                       static_cast<std::size_t>(release.tag.size())))) {
+                m_unversioned.append(std::move(release));
+                continue;
+            }
+            if (!release.prerelease)
+                stable.append(release);
+            versioned.append(std::move(release));
+        }
+        merge(m_all, std::move(versioned));
+        merge(m_stable, std::move(stable));
+        return added;
+    }
+
+    /// @brief Replace known releases whose tag, pre-release flag or date changed
+    /// @return Number of releases replaced; unknown ids are ignored
+    qsizetype update(const QList<IndexedRelease>& releases) {
+        QList<IndexedRelease> changed;
+        QSet<qint64> ids;
+        for (const IndexedRelease& release : releases) {
+            const IndexedRelease* known = find(release.id);
+            if (known && !ids.contains(release.id)
+                && (known->tag != release.tag || known->prerelease != release.prerelease
+                    || known->publishedAt != release.publishedAt)) {
+                ids.insert(release.id);
+                changed.append(release);
+            }
+        }
+        if (changed.isEmpty())
+            return 0;
+        const auto stale = [&ids](const IndexedRelease& r) { return ids.contains(r.id); };
+        m_all.removeIf(stale);
+        m_stable.removeIf(stale);
+        m_unversioned.removeIf(stale);
+        m_ids.subtract(ids);
+        return add(std::move(changed));
+    }
+
+    /// @brief ETag of the newest page as last fetched (empty if unknown)
+    QByteArray etag() const { return m_etag; }
+    void setEtag(const QByteArray& etag) { m_etag = etag; }
+
+    /// @brief When the history was last compared against GitHub (UTC)
+    QDateTime refreshedAt() const { return m_refreshedAt; }
+    void setRefreshedAt(const QDateTime& at) { m_refreshedAt = at; }
+
+private:
+    const IndexedRelease* find(qint64 id) const {
+        if (!m_ids.contains(id))
+            return nullptr;
+        for (const auto* list : {&m_all, &m_unversioned}) {
+            for (const IndexedRelease& release : *list) {
+                if (release.id == id)
+                    return &release;
+            }
+        }
+        return nullptr;
+    }
+
+    /// Ascending by version; pre-releases before the release; then by date and id
+    static bool before(const IndexedRelease& a, const IndexedRelease& b) {
+        if (a.version != b.version)
+            return a.version < b.version;
+        if (a.prerelease != b.prerelease)
+            return a.prerelease;
+        if (a.publishedAt != b.publishedAt)
+            return a.publishedAt < b.publishedAt;
+        return a.id < b.id;
+    }
+
+    static void merge(QList<IndexedRelease>& list, QList<IndexedRelease> added) {
+        if (added.isEmpty())
+            return;
+        std::sort(added.begin(), added.end(), before);
+        const qsizetype old = list.size();
+        list.append(std::move(added));
+        std::inplace_merge(list.begin(), list.begin() + old, list.end(), before);
+    }
+
+    static QList<IndexedRelease>::const_iterator upperBound(const QList<IndexedRelease>& list,
+                                                            const SemVer& version) {
+        return std::upper_bound(list.cbegin(), list.cend(), version,
+                                [](const SemVer& v, const IndexedRelease& r) { return v < r.version; });
+    }
+
+    QList<IndexedRelease> m_all;
+    QList<IndexedRelease> m_stable;
+    QList<IndexedRelease> m_unversioned;
+    QSet<qint64> m_ids;
+    QByteArray m_etag;
+    QDateTime m_refreshedAt;
+};
+
+// ---------------------------------------------------------
+// Release Index
+// ---------------------------------------------------------
+/// @brief Outcome of ReleaseIndex::refresh()
+struct ReleaseIndexRefresh {
+    QString slug;            ///< Repository slug ("owner/repo")
+    int requests = 0;        ///< API requests sent
+    bool notModified = false;///< The first page was answered with 304
+    qsizetype added = 0;     ///< Releases added to the history
+    qsizetype updated = 0;   ///< Known releases re-tagged, promoted or re-dated
+    qint64 bytes = 0;        ///< Response body bytes received
+    QString error;           ///< Empty on success; the history is unchanged otherwise
+};
+
+/// @brief Persistent, incrementally refreshed release lists of many repositories
+///
+/// Keyed by toRepoSlug(). history() and the other accessors are
+/// thread-safe; refresh() uses the index's QNetworkAccessManager and must
+/// be called on the thread the index was created on, which needs an event
+/// loop.
+///
+/// @example
+///   qtgh::ReleaseIndex index;
+///   index.setToken(qgetenv("GITHUB_TOKEN"));
+///   index.refresh(url, [&](const qtgh::ReleaseIndexRefresh& r) {
+///       if (r.error.isEmpty())
+///           report(index.history(r.slug)->latestInSeries(2));
+///   });
+class ReleaseIndex {
+public:
+    using RefreshHandler = std::function<void(const ReleaseIndexRefresh&)>;
+
+    ReleaseIndex() = default;
+    ReleaseIndex(const ReleaseIndex&) = delete;
+    ReleaseIndex& operator=(const ReleaseIndex&) = delete;
+
+    ~ReleaseIndex() {
+        for (auto* reply : m_mgr.findChildren<QNetworkReply*>()) {
+            QObject::disconnect(reply, nullptr, nullptr, nullptr);
+            reply->abort();
+        }
+    }
+
+    /// @brief API base URL (default defaultApiBaseUrl())
+    void setApiBaseUrl(const QString& url) {
+        m_apiBaseUrl = url;
+        while (m_apiBaseUrl.endsWith('/'))
+            m_apiBaseUrl.chop(1);
+    }
+
+    /// @brief Token sent as "Authorization: Bearer <token>" (optional)
+    void setToken(const QByteArray& token) { m_token = token; }
+
+    /// @brief Releases per page: `probe` for the first page of a refresh of
+    ///   a known repository (default 10), `full` otherwise (default 100, the API maximum)
+    void setPageSizes(int probe, int full) {
+        m_probeSize = std::clamp(probe, 1, 100);
+        m_pageSize = std::clamp(full, 1, 100);
+    }
+
+    /// @brief Fetch the releases of `repoUrl` that are not in its history yet
+    ///
+    /// `done` is called once the history is updated, or with an error and
+    /// the history unchanged. Refreshes of a repository that is already
+    /// being refreshed wait for the running one.
+    /// @throws std::runtime_error if `repoUrl` is not a GitHub repository
+    void refresh(const QString& repoUrl, RefreshHandler done) {
+        const QString slug = toRepoSlug(repoUrl);
+        if (auto running = m_running.value(slug)) {
+            running->waiters.append(std::move(done));
+            return;
+        }
+        auto job = std::make_shared<Job>();
+        job->result.slug = slug;
+        job->history = history(slug).value_or(ReleaseHistory{});
+        job->incremental = !job->history.isEmpty();
+        job->pageSize = job->incremental ? m_probeSize : m_pageSize;
+        job->waiters.append(std::move(done));
+        m_running.insert(slug, job);
+        requestPage(job);
+    }
+
+    /// @brief Snapshot of a repository's releases (nullopt if never refreshed)
+    std::optional<ReleaseHistory> history(const QString& slug) const {
+        QReadLocker lock(&m_lock);
+        const auto it = m_histories.constFind(slug);
+        if (it == m_histories.cend())
+            return std::nullopt;
+        return *it;
+    }
+
+    /// @brief Replace the history of a repository (e.g. built elsewhere)
+    void store(const QString& slug, const ReleaseHistory& history) {
+        QWriteLocker lock(&m_lock);
+        m_histories.insert(slug, history);
+    }
+
+    /// @brief Forget a repository; its next refresh lists all releases again
+    void remove(const QString& slug) {
+        QWriteLocker lock(&m_lock);
+        m_histories.remove(slug);
+    }
+
+    /// @brief Number of indexed repositories
+    qsizetype size() const {
+        QReadLocker lock(&m_lock);
+        return m_histories.size();
+    }
+
+    /// @brief Write all histories to a JSON file (atomically)
+    /// @return false with `error` set if the file cannot be written
+    bool save(const QString& path, QString* error = nullptr) const {
+        QJsonObject root;
+        {
+            QReadLocker lock(&m_lock);
+            for (auto it = m_histories.cbegin(); it != m_histories.cend(); ++it) {
+                QJsonArray releases;
+                auto append = [&releases](const IndexedRelease& r) {
+                    QJsonObject obj{{"id", r.id}, {"tag", r.tag}};
+                    if (r.prerelease)
+                        obj.insert("prerelease", true);
+                    if (r.publishedAt.isValid())
+                        obj.insert("published_at", r.publishedAt.toString(Qt::ISODate));
+                    releases.append(obj);
+                };
+                for (const auto& r : it->releases())
+                    append(r);
+                for (const auto& r : it->unversioned())
+                    append(r);
+                root.insert(it.key(), QJsonObject{
+                    {"etag", QString::fromLatin1(it->etag())},
+                    {"refreshed_at", it->refreshedAt().toString(Qt::ISODate)},
+                    {"releases", releases},
+                });
+            }
+        }
+        QSaveFile file(path);
+        if (!file.open(QIODevice::WriteOnly)
+            || file.write(QJsonDocument(root).toJson(QJsonDocument::Compact)) < 0
+            || !file.commit()) {
+            if (error)
+                *error = file.errorString();
+            return false;
+        }
+        return true;
+    }
+
+    /// @brief Load histories written by save(); a missing file is empty
+    /// @return false with `error` set if the file cannot be read or parsed
+    bool load(const QString& path, QString* error = nullptr) {
+        QFile file(path);
+        if (!file.exists())
+            return true;
+        if (!file.open(QIODevice::ReadOnly)) {
+            if (error)
+                *error = file.errorString();
+            return false;
+        }
+        QJsonParseError parseError;
+        const auto doc = QJsonDocument::fromJson(file.readAll(), &parseError);
+        if (!doc.isObject()) {
+            if (error)
+                *error = parseError.errorString();
+            return false;
+        }
+        const QJsonObject root = doc.object();
+        QHash<QString, ReleaseHistory> loaded;
+        for (auto it = root.begin(); it != root.end(); ++it) {
+            const QJsonObject entry = it.value().toObject();
+            QList<IndexedRelease> releases;
+            for (const QJsonValue& value : entry["releases"].toArray()) {
+                const QJsonObject obj = value.toObject();
+                releases.append(makeRelease(obj["id"].toInteger(), obj["tag"].toString(),
+                                            obj["prerelease"].toBool(),
+                                            obj["published_at"].toString()));
+            }
+            ReleaseHistory history;
+            history.add(std::move(releases));
+            history.setEtag(entry["etag"].toString().toLatin1());
+            history.setRefreshedAt(QDateTime::fromString(entry["refreshed_at"].toString(), Qt::ISODate));
+            loaded.insert(it.key(), std::move(history));
+        }
+        QWriteLocker lock(&m_lock);
+        m_histories.insert(loaded);
+        return true;
+    }
+
+private:
+    struct Job {
+        ReleaseIndexRefresh result;
+        ReleaseHistory history;             ///< Copy being extended
+        QList<IndexedRelease> found;        ///< New releases, newest first
+        QList<IndexedRelease> known;        ///< Known releases as listed now
+        QSet<qint64> seen;                  ///< Ids listed so far (pages may overlap)
+        bool incremental = false;           ///< The history was not empty
+        int pageSize = 100;
+        int page = 1;
+        QByteArray etag;                    ///< ETag of the probe page
+        QList<RefreshHandler> waiters;
+    };
+
+    static IndexedRelease makeRelease(qint64 id, const QString& tag, bool prerelease,
+                                      const QString& publishedAt) {
+        IndexedRelease release{id, tag, {}, prerelease, {}};
+        if (const auto version = core::findVersion(
+                std::u16string_view(tag.utf16(), static_cast<std::size_t>(tag.size()))))
+            release.version = {version->major, version->minor, version->patch};
+        if (!publishedAt.isEmpty())
+            release.publishedAt = QDateTime::fromString(publishedAt, Qt::ISODate);
+        return release;
+    }
+
+    bool isProbe(const Job& job) const { return job.incremental && job.page == 1 && job.pageSize == m_probeSize; }
+
+    void requestPage(const std::shared_ptr<Job>& job) {
+        QNetworkRequest req = makeGithubRequest(QStringLiteral("%1/repos/%2/releases?per_page=%3&page=%4")
+                                                    .arg(m_apiBaseUrl, job->result.slug)
+                                                    .arg(job->pageSize)
+                                                    .arg(job->page));
+        req.setRawHeader("Accept", "application/vnd.github+json");
+        if (!m_token.isEmpty())
+            req.setRawHeader("Authorization", "Bearer " + m_token);
+        if (isProbe(*job) && !job->history.etag().isEmpty())
+            req.setRawHeader("If-None-Match", job->history.etag());
+        ++job->result.requests;
+
+        QNetworkReply* reply = m_mgr.get(req);
+        QObject::connect(reply, &QNetworkReply::finished, reply, [this, reply, job] {
+            reply->deleteLater();
+            const int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+            const QByteArray body = reply->readAll();
+            job->result.bytes += body.size();
+
+            if (status == 304 && isProbe(*job)) {
+                job->result.notModified = true;
+                finish(job);
+                return;
+            }
+            if (status != 200) {
+                job->result.error = reply->error() != QNetworkReply::NoError
+                                        ? "Network error: " + reply->errorString()
+                                        : QStringLiteral("GitHub API returned HTTP %1").arg(status);
+                finish(job);
+                return;
+            }
+            const QJsonDocument doc = QJsonDocument::fromJson(body);
+            if (!doc.isArray()) {
+                job->result.error = QStringLiteral("GitHub API returned no release list");
+                finish(job);
+                return;
+            }
+
+            // Newest first: a known release means everything after it is known
+            bool metKnown = false;
+            const QJsonArray releases = doc.array();
+            for (const QJsonValue& value : releases) {
+                const QJsonObject obj = value.toObject();
+                const qint64 id = obj["id"].toInteger();
+                if (obj["draft"].toBool() || id == 0)
+                    continue;
+                if (job->seen.contains(id))
+                    continue;
+                job->seen.insert(id);
+                IndexedRelease release = makeRelease(id, obj["tag_name"].toString(),
+                                                     obj["prerelease"].toBool(),
+                                                     obj["published_at"].toString());
+                if (job->history.contains(id)) {
+                    metKnown = true;
+                    job->known.append(std::move(release));
+                } else {
+                    job->found.append(std::move(release));
+                }
+            }
+            if (isProbe(*job))
+                job->etag = reply->rawHeader("ETag");
+
+            const QByteArray link = reply->rawHeader("Link");
+            const bool more = link.isEmpty() ? releases.size() >= job->pageSize
+                                             : link.contains("rel=\"next\"");
+            if (metKnown || !more) {
+                finish(job);
+            } else if (isProbe(*job) && m_pageSize > m_probeSize) {
+                job->pageSize = m_pageSize;     // many new releases: continue with full pages
+                requestPage(job);
+            } else {
+                ++job->page;
+                requestPage(job);
+            }
+        });
+    }
+
+    void finish(const std::shared_ptr<Job>& job) {
+        m_running.remove(job->result.slug);
+        if (job->result.error.isEmpty()) {
+            job->result.updated = job->history.update(job->known);
+            job->result.added = job->history.add(std::move(job->found));
+            if (!job->etag.isEmpty())
+                job->history.setEtag(job->etag);
+            job->history.setRefreshedAt(QDateTime::currentDateTimeUtc());
+            store(job->result.slug, job->history);
+        }
+        for (const auto& done : std::as_const(job->waiters))
+            done(job->result);
+    }
+
+    mutable QReadWriteLock m_lock;          ///< Guards m_histories
+    QHash<QString, ReleaseHistory> m_histories;
+    QHash<QString, std::shared_ptr<Job>> m_running;
+    QNetworkAccessManager m_mgr;
+    QString m_apiBaseUrl = defaultApiBaseUrl();
+    QByteArray m_token;
+    int m_probeSize = 10;
+    int m_pageSize = 100;
+};
+
+} // namespace qtgh
@@ -0,0 +1,228 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: 2026 Zheng-Bote
+//
+// qt_gh-release-scheduler.hpp - Adaptive per-repository polling schedule
+//
+// Learns each repository's release cadence from observed tag changes (and
+// the release's published_at time when available) and derives the next
+// check time from it: repositories that release daily are polled often,
+// dormant repositories rarely. Due repositories are kept in a priority
+// queue keyed by their next-due time.
+//
+// Usage:
+//   #include "qt_gh-release-scheduler.hpp"
+//   qtgh::ReleaseScheduler scheduler;
+//   scheduler.addRepo(qtgh::toRepoSlug(url), now);
+//   for (const auto& repo : scheduler.takeDue(now)) {
+//       auto info = ...;  // check the repository
+//       scheduler.recordCheck(repo, info.latestVersion, now,
+//                             qtgh::ReleaseScheduler::fromQDateTime(info.publishedAt));
+//   }
+
+#pragma once
+#include <QDateTime>
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <algorithm>
+#include <chrono>
+#include <optional>
+#include <queue>
+#include <vector>
+
+namespace qtgh {
+
+// ---------------------------------------------------------
+// ReleaseScheduler
+// ---------------------------------------------------------
+/// @brief Adaptive polling scheduler driven by observed release cadence
+///
+/// The mean interval between releases is tracked as an exponentially
+/// weighted moving average. A repository is polled every
+/// pollFraction * max(mean interval, time since last release), clamped to
+/// [minInterval, maxInterval]. Using the time since the last release as a
+/// lower bound makes repositories that went quiet back off automatically.
+/// Until a cadence is known, repositories are polled every initialInterval.
+///
+/// Repositories returned by takeDue() are not rescheduled until the caller
+/// reports the outcome through recordCheck() or recordFailure().
+///
+/// @example
+///   qtgh::ReleaseScheduler scheduler;
+///   scheduler.addRepo("nlohmann/json", now);
+///   auto due = scheduler.takeDue(now);           // {"nlohmann/json"}
+///   scheduler.recordCheck("nlohmann/json", "v3.11.3", now);
+///   auto next = scheduler.nextDueTime();         // now + initialInterval
+class ReleaseScheduler {
+public:
+    using Clock     = std::chrono::system_clock;
+    using TimePoint = Clock::time_point;
+    using Duration  = std::chrono::seconds;
+
+    /// @brief Tuning parameters
+    struct Config {
+        Duration initialInterval = std::chrono::hours(6);   ///< Interval while cadence is unknown
+        Duration minInterval     = std::chrono::minutes(15);
+        Duration maxInterval     = std::chrono::days(7);
+        double pollFraction      = 0.1;   ///< Poll every this fraction of the expected interval
+        double smoothing         = 0.3;   ///< EWMA weight of the newest release interval
+    };
+
+    /// @brief Learned per-repository state
+    struct RepoState {
+        QString lastTag;                  ///< Latest tag seen (empty before the first check)
+        TimePoint lastRelease{};          ///< Publication (or detection) time of lastTag
+        double meanIntervalSec = 0.0;     ///< EWMA of release intervals, 0 if unknown
+        int releasesObserved = 0;         ///< Number of tag changes seen
+        Duration interval{};              ///< Current polling interval
+        TimePoint nextDue{};              ///< Next scheduled check
+        bool checkPending = false;        ///< Handed out by takeDue(), awaiting result
+        quint64 generation = 0;           ///< Invalidates stale queue entries
+    };
+
+    ReleaseScheduler() : ReleaseScheduler(Config{}) {}
+    explicit ReleaseScheduler(Config config) : m_config(config) {}
+
+    /// @brief Start tracking a repository; its first check is due at `now`
+    /// @param key Repository key, normally toRepoSlug(url)
+    void addRepo(const QString& key, TimePoint now) {
+        if (m_repos.contains(key))
+            return;
+        RepoState& st = m_repos[key];
+        st.interval = m_config.initialInterval;
+        schedule(key, st, now);   // first check is due immediately
+    }
+
+    /// @brief Stop tracking a repository
+    void removeRepo(const QString& key) { m_repos.remove(key); }
+
+    bool contains(const QString& key) const { return m_repos.contains(key); }
+    qsizetype size() const { return m_repos.size(); }
+
+    /// @brief Learned state of a repository, or nullptr if unknown
+    const RepoState* state(const QString& key) const {
+        auto it = m_repos.constFind(key);
+        return it == m_repos.cend() ? nullptr : &it.value();
+    }
+
+    /// @brief Earliest next-due time of all scheduled repositories
+    /// @return std::nullopt if nothing is scheduled
+    std::optional<TimePoint> nextDueTime() {
+        dropStale();
+        if (m_queue.empty())
+            return std::nullopt;
+        return m_queue.top().due;
+    }
+
+    /// @brief Remove and return repositories whose check is due
+    /// @param now Current time
+    /// @param max Maximum number of repositories to return (-1 = all)
+    QStringList takeDue(TimePoint now, qsizetype max = -1) {
+        QStringList due;
+        while (max < 0 || due.size() < max) {
+            dropStale();
+            if (m_queue.empty() || m_queue.top().due > now)
+                break;
+            const QString key = m_queue.top().key;
+            m_queue.pop();
+            RepoState& st = m_repos[key];
+            st.checkPending = true;
+            ++st.generation;
+            due.append(key);
+        }
+        return due;
+    }
+
+    /// @brief Report a successful check and reschedule the repository
+    /// @param key Repository key
+    /// @param tag Latest release tag returned by the check
+    /// @param now Time of the check
+    /// @param publishedAt Publication time of the release, if reported
+    void recordCheck(const QString& key, const QString& tag, TimePoint now,
+                     std::optional<TimePoint> publishedAt = std::nullopt) {
+        auto it = m_repos.find(key);
+        if (it == m_repos.end())
+            return;
+        RepoState& st = it.value();
+        const TimePoint released = publishedAt.value_or(now);
+
+        if (st.lastTag.isEmpty()) {
+            st.lastTag = tag;
+            st.lastRelease = released;
+        } else if (tag != st.lastTag) {
+            const double sample = std::chrono::duration<double>(released - st.lastRelease).count();
+            if (sample > 0.0) {
+                st.meanIntervalSec = st.releasesObserved == 0
+                    ? sample
+                    : m_config.smoothing * sample + (1.0 - m_config.smoothing) * st.meanIntervalSec;
+                ++st.releasesObserved;
+            }
+            st.lastTag = tag;
+            st.lastRelease = released;
+        }
+
+        st.interval = pollInterval(st, now, publishedAt.has_value());
+        schedule(key, st, now + st.interval);
+    }
+
+    /// @brief Report a failed check; the repository is retried after its current interval
+    void recordFailure(const QString& key, TimePoint now) {
+        auto it = m_repos.find(key);
+        if (it == m_repos.end())
+            return;
+        schedule(key, it.value(), now + it.value().interval);
+    }
+
+    /// @brief Convert a QDateTime (e.g. UpdateInfo::publishedAt) to a time point
+    /// @return std::nullopt if the QDateTime is invalid
+    static std::optional<TimePoint> fromQDateTime(const QDateTime& dt) {
+        if (!dt.isValid())
+            return std::nullopt;
+        return TimePoint{std::chrono::milliseconds(dt.toMSecsSinceEpoch())};
+    }
+
+private:
+    struct QueueItem {
+        TimePoint due;
+        quint64 generation;
+        QString key;
+        bool operator>(const QueueItem& o) const { return due > o.due; }
+    };
+
+    Duration pollInterval(const RepoState& st, TimePoint now, bool releaseTimeKnown) const {
+        const double sinceRelease = std::chrono::duration<double>(now - st.lastRelease).count();
+        Duration interval;
+        if (st.meanIntervalSec <= 0.0 && !releaseTimeKnown) {
+            // Unknown cadence and no publication time: start at the initial
+            // interval and back off while the repository stays quiet.
+            interval = std::max(m_config.initialInterval,
+                                Duration(static_cast<Duration::rep>(sinceRelease * m_config.pollFraction)));
+        } else {
+            const double basis = std::max(st.meanIntervalSec, sinceRelease);
+            interval = Duration(static_cast<Duration::rep>(basis * m_config.pollFraction));
+        }
+        return std::clamp(interval, m_config.minInterval, m_config.maxInterval);
+    }
+
+    void schedule(const QString& key, RepoState& st, TimePoint due) {
+        st.checkPending = false;
+        st.nextDue = due;
+        m_queue.push({st.nextDue, ++st.generation, key});
+    }
+
+    void dropStale() {
+        while (!m_queue.empty()) {
+            const auto& top = m_queue.top();
+            auto it = m_repos.constFind(top.key);
+            if (it != m_repos.cend() && it->generation == top.generation && !it->checkPending)
+                return;
+            m_queue.pop();
+        }
+    }
+
+    Config m_config;
+    QHash<QString, RepoState> m_repos;
+    std::priority_queue<QueueItem, std::vector<QueueItem>, std::greater<>> m_queue;
+};
+
+} // namespace qtgh
@@ -0,0 +1,274 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: 2026 Zheng-Bote
+//
+// qt_gh-result-cbor.hpp - CBOR encoding of batch results
+//
+// Writes batch results as a CBOR sequence (RFC 8742): one definite-length
+// map per result, appended with QCborStreamWriter as the result arrives,
+// without building a QCborValue or QJsonDocument. The keys are those of
+// the NDJSON records of "scan --json":
+//
+//   repo, local, origin (if set)
+//   Ok:     remote, update, published (tag 1, epoch seconds; if known)
+//   Others: error, cached / timeout / cancelled (true, if applicable)
+//
+// CborResultReader decodes such a sequence one result at a time with
+// QCborStreamReader. Unknown keys are skipped, so newer writers may add
+// fields; a record cut off at the end of the data (a killed producer) is
+// reported through truncated() instead of as an error.
+//
+// Usage:
+//   #include "qt_gh-result-cbor.hpp"
+//   QCborStreamWriter writer(&file);
+//   checker.setResultHandler([&](const qtgh::BatchResult& r) {
+//       qtgh::writeCborResult(writer, r);
+//   });
+//
+//   qtgh::CborResultReader reader(file.readAll());
+//   while (auto result = reader.next()) handle(*result);
+
+#pragma once
+#include "qt_gh-batch-checker.hpp"
+#include <QCborStreamReader>
+#include <QCborStreamWriter>
+#include <QTimeZone>
+#include <cmath>
+#include <optional>
+#include <stdexcept>
+
+namespace qtgh {
+
+// ---------------------------------------------------------
+// Writing
+// ---------------------------------------------------------
+/// @brief Append one result to a CBOR sequence as a map
+///
+/// The map is complete when the function returns; the caller decides
+/// when to flush the writer's device.
+inline void writeCborResult(QCborStreamWriter& writer, const BatchResult& result) {
+    const bool ok = result.status == BatchStatus::Ok;
+    const bool hasOrigin = !result.job.origin.isEmpty();
+    const bool hasPublished = ok && result.info.publishedAt.isValid();
+    const bool flagged = result.status == BatchStatus::TimedOut
+                         || result.status == BatchStatus::Cancelled;
+
+    quint64 entries = 2 + (hasOrigin ? 1 : 0);
+    if (ok)
+        entries += 2 + (hasPublished ? 1 : 0);
+    else
+        entries += 1 + (result.cached ? 1 : 0) + (flagged ? 1 : 0);
+
+    writer.startMap(entries);
+    writer.append(QLatin1StringView("repo"));
+    writer.append(QStringView(result.job.repoUrl));
+    writer.append(QLatin1StringView("local"));
+    writer.append(QStringView(result.job.localVersion));
+    if (hasOrigin) {
+        writer.append(QLatin1StringView("origin"));
+        writer.append(QStringView(result.job.origin));
+    }
+    if (ok) {
+        writer.append(QLatin1StringView("remote"));
+        writer.append(QStringView(result.info.latestVersion));
+        writer.append(QLatin1StringView("update"));
+        writer.append(result.info.hasUpdate);
+        if (hasPublished) {
+            const qint64 ms = result.info.publishedAt.toMSecsSinceEpoch();
+            writer.append(QLatin1StringView("published"));
+            writer.append(QCborKnownTags::UnixTime_t);
+            if (ms % 1000 == 0)
+                writer.append(ms / 1000);
+            else
+                writer.append(static_cast<double>(ms) / 1000.0);
+        }
+    } else {
+        writer.append(QLatin1StringView("error"));
+        writer.append(QStringView(result.error));
+        if (result.cached) {
+            writer.append(QLatin1StringView("cached"));
+            writer.append(true);
+        }
+        if (result.status == BatchStatus::TimedOut) {
+            writer.append(QLatin1StringView("timeout"));
+            writer.append(true);
+        } else if (result.status == BatchStatus::Cancelled) {
+            writer.append(QLatin1StringView("cancelled"));
+            writer.append(true);
+        }
+    }
+    writer.endMap();
+}
+
+/// @brief One result as a standalone CBOR item (one element of a sequence)
+inline QByteArray encodeCborResult(const BatchResult& result) {
+    QByteArray out;
+    QCborStreamWriter writer(&out);
+    writeCborResult(writer, result);
+    return out;
+}
+
+// ---------------------------------------------------------
+// Reading
+// ---------------------------------------------------------
+/// @brief Decode a CBOR sequence written by writeCborResult()
+///
+/// Decodes one map per next() call straight from the encoded data; no
+/// document is built. BatchResult::job carries repoUrl, localVersion and
+/// origin only (no stop token, Background priority).
+///
+/// @example
+///   qtgh::CborResultReader reader(data);
+///   while (auto result = reader.next())
+///       print(*result);
+///   if (reader.truncated())
+///       warn("last record incomplete");
+class CborResultReader {
+public:
+    explicit CborResultReader(const QByteArray& data) : m_data(data), m_reader(m_data) {}
+
+    CborResultReader(const CborResultReader&) = delete;
+    CborResultReader& operator=(const CborResultReader&) = delete;
+
+    /// @brief Decode the next result
+    /// @return The result, or std::nullopt at the end of the data
+    /// @throws std::runtime_error if the data is not a sequence of result maps
+    std::optional<BatchResult> next() {
+        if (m_truncated || atEnd())
+            return std::nullopt;
+        if (m_reader.lastError() != QCborError::NoError)
+            fail(m_reader.lastError().toString());
+        if (!m_reader.isMap())
+            fail("record is not a map");
+
+        const qint64 start = m_reader.currentOffset();
+        BatchResult result;
+        bool error = false, timeout = false, cancelled = false;
+        m_reader.enterContainer();
+        while (m_reader.lastError() == QCborError::NoError && m_reader.hasNext()) {
+            if (!m_reader.isString())
+                break;
+            const QString key = m_reader.readAllString();
+            if (m_reader.lastError() != QCborError::NoError)
+                break;
+            if (key == QLatin1StringView("repo"))
+                result.job.repoUrl = text();
+            else if (key == QLatin1StringView("local"))
+                result.job.localVersion = text();
+            else if (key == QLatin1StringView("origin"))
+                result.job.origin = text();
+            else if (key == QLatin1StringView("remote"))
+                result.info.latestVersion = text();
+            else if (key == QLatin1StringView("update"))
+                result.info.hasUpdate = boolean();
+            else if (key == QLatin1StringView("published"))
+                result.info.publishedAt = timestamp();
+            else if (key == QLatin1StringView("error")) {
+                result.error = text();
+                error = true;
+            } else if (key == QLatin1StringView("cached"))
+                result.cached = boolean();
+            else if (key == QLatin1StringView("timeout"))
+                timeout = boolean();
+            else if (key == QLatin1StringView("cancelled"))
+                cancelled = boolean();
+            else
+                m_reader.next();    // written by a newer version
+        }
+
+        if (endOfData()) {
+            m_truncated = true;
+            m_offset = start;
+            return std::nullopt;
+        }
+        if (m_reader.lastError() != QCborError::NoError)
+            fail(m_reader.lastError().toString());
+        if (m_reader.hasNext())
+            fail("map key is not a string");
+        m_reader.leaveContainer();
+        if (result.job.repoUrl.isEmpty())
+            fail("not a result record");
+
+        if (!error)
+            result.status = BatchStatus::Ok;
+        else if (timeout)
+            result.status = BatchStatus::TimedOut;
+        else if (cancelled)
+            result.status = BatchStatus::Cancelled;
+        else
+            result.status = BatchStatus::Failed;
+        m_offset = m_reader.currentOffset();
+        return result;
+    }
+
+    /// @brief Whether the data ended inside a record (everything before it was returned)
+    bool truncated() const { return m_truncated; }
+
+    /// @brief Bytes consumed by complete records
+    qint64 offset() const { return m_offset; }
+
+private:
+    /// No further complete record; bytes left over are a truncated one
+    bool atEnd() {
+        if (!endOfData())
+            return false;
+        m_truncated = m_reader.currentOffset() < m_data.size();
+        return true;
+    }
+
+    bool endOfData() const { return m_reader.lastError() == QCborError::EndOfFile; }
+
+    [[noreturn]] void fail(const QString& why) const {
+        throw std::runtime_error(QStringLiteral("Invalid CBOR result at offset %1: %2")
+                                     .arg(m_reader.currentOffset())
+                                     .arg(why)
+                                     .toStdString());
+    }
+
+    // The value getters leave a value cut off by the end of the data to
+    // next(), which reports the record as truncated
+
+    QString text() {
+        if (endOfData())
+            return {};
+        if (!m_reader.isString())
+            fail("expected a text string");
+        return m_reader.readAllString();
+    }
+
+    bool boolean() {
+        if (endOfData())
+            return false;
+        if (!m_reader.isBool())
+            fail("expected a boolean");
+        const bool value = m_reader.toBool();
+        m_reader.next();
+        return value;
+    }
+
+    QDateTime timestamp() {
+        if (endOfData())
+            return {};
+        if (!m_reader.isTag()
+            || m_reader.toTag() != static_cast<QCborTag>(QCborKnownTags::UnixTime_t))
+            fail("expected an epoch timestamp");
+        m_reader.next();
+        if (endOfData())
+            return {};
+        qint64 ms = 0;
+        if (m_reader.isInteger())
+            ms = m_reader.toInteger() * 1000;
+        else if (m_reader.isDouble())
+            ms = std::llround(m_reader.toDouble() * 1000.0);
+        else
+            fail("expected epoch seconds");
+        m_reader.next();
+        return QDateTime::fromMSecsSinceEpoch(ms, QTimeZone::UTC);
+    }
+
+    QByteArray m_data;
+    QCborStreamReader m_reader;
+    qint64 m_offset = 0;
+    bool m_truncated = false;
+};
+
+} // namespace qtgh
@@ -0,0 +1,351 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: 2026 Zheng-Bote
+//
+// qt_gh-result-model.hpp - Table model for streamed batch results
+//
+// A QAbstractTableModel for dashboards showing thousands of checks while
+// they complete. Results are queued by append() and inserted into the
+// model at most once per flush interval (one frame by default): one
+// rowsInserted for all new rows and one dataChanged for re-checked ones,
+// instead of one insert per result, which makes views stutter.
+//
+// Versions are parsed once when a row is inserted; sort() and SortRole
+// compare the parsed values. While the model is sorted, each flush merges
+// the new rows into place instead of sorting everything again.
+//
+// Header-only and QtCore-only; usable with Qt Widgets views and, through
+// roleNames(), with QML.
+//
+// Usage:
+//   #include "qt_gh-result-model.hpp"
+//   qtgh::ResultTableModel model;
+//   tableView->setModel(&model);
+//   checker.setResultHandler([&](const qtgh::BatchResult& r) { model.append(r); });
+
+#pragma once
+#include "qt_gh-batch-checker.hpp"
+#include <QAbstractTableModel>
+#include <QHash>
+#include <QTimer>
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+#include <mutex>
+#include <numeric>
+#include <vector>
+
+namespace qtgh {
+
+// ---------------------------------------------------------
+// ResultTableModel
+// ---------------------------------------------------------
+/// @brief Table of batch results with coalesced, frame-paced updates
+///
+/// One row per repository and local version ("owner/repo@version", as in
+/// the "scan" output); a later result for the same pair replaces the
+/// row. append() is thread-safe and can be called from result handlers
+/// and future continuations; the model itself, like every item model,
+/// belongs to the thread it lives in.
+///
+/// @example
+///   qtgh::ResultTableModel model;
+///   model.sort(qtgh::ResultTableModel::Latest, Qt::DescendingOrder);
+///   checker.setResultHandler([&](const qtgh::BatchResult& r) { model.append(r); });
+class ResultTableModel : public QAbstractTableModel {
+public:
+    enum Column {
+        Repository,   ///< Repository URL
+        Local,        ///< Local version
+        Latest,       ///< Latest release tag (empty unless the check succeeded)
+        Status,       ///< "Update available", "Up to date", "Failed", ...
+        Origin,       ///< Where the dependency is declared
+        ColumnCount
+    };
+
+    enum Role {
+        SortRole = Qt::UserRole + 1,  ///< Value sort() compares (versions as parsed keys)
+        StatusRole,                   ///< BatchStatus as int
+        HasUpdateRole,                ///< bool
+        ErrorRole                     ///< Error message (empty if the check succeeded)
+    };
+
+    explicit ResultTableModel(QObject* parent = nullptr) : QAbstractTableModel(parent) {
+        m_timer.setSingleShot(true);
+        m_timer.setTimerType(Qt::PreciseTimer);
+        QObject::connect(&m_timer, &QTimer::timeout, this, [this] { flush(); });
+    }
+
+    /// @brief Queue a result; it appears in the model with the next flush
+    ///
+    /// Thread-safe. The first queued result starts the flush timer, so
+    /// the model changes at most once per flushInterval().
+    void append(BatchResult result) {
+        bool first;
+        {
+            std::lock_guard lock(m_lock);
+            first = m_pending.empty();
+            m_pending.push_back(std::move(result));
+        }
+        if (first)
+            QMetaObject::invokeMethod(this, [this] {
+                if (!m_timer.isActive())
+                    m_timer.start(m_interval);
+            }, Qt::AutoConnection);
+    }
+
+    /// @brief Maximum delay between append() and the model update (default 16 ms)
+    ///
+    /// 0 flushes on the next event loop iteration.
+    void setFlushInterval(std::chrono::milliseconds interval) { m_interval = interval; }
+    std::chrono::milliseconds flushInterval() const { return m_interval; }
+
+    /// @brief Apply queued results now (the model's thread only)
+    void flush() {
+        m_timer.stop();
+        std::vector<BatchResult> pending;
+        {
+            std::lock_guard lock(m_lock);
+            pending.swap(m_pending);
+        }
+        if (pending.empty())
+            return;
+
+        const qsizetype oldCount = static_cast<qsizetype>(m_rows.size());
+        std::vector<Row> added;
+        qsizetype firstChanged = oldCount, lastChanged = -1;
+        for (BatchResult& result : pending) {
+            Row row = makeRow(std::move(result));
+            const auto it = m_index.constFind(row.key);
+            if (it == m_index.cend()) {
+                m_index.insert(row.key, oldCount + static_cast<qsizetype>(added.size()));
+                added.push_back(std::move(row));
+            } else if (*it >= oldCount) {
+                added[static_cast<std::size_t>(*it - oldCount)] = std::move(row);
+            } else {
+                m_rows[static_cast<std::size_t>(*it)] = std::move(row);
+                firstChanged = std::min(firstChanged, *it);
+                lastChanged = std::max(lastChanged, *it);
+            }
+        }
+
+        if (!added.empty()) {
+            beginInsertRows({}, static_cast<int>(oldCount),
+                            static_cast<int>(oldCount + static_cast<qsizetype>(added.size()) - 1));
+            std::move(added.begin(), added.end(), std::back_inserter(m_rows));
+            endInsertRows();
+        }
+        if (lastChanged >= 0)
+            dataChanged(index(static_cast<int>(firstChanged), 0),
+                             index(static_cast<int>(lastChanged), ColumnCount - 1));
+
+        // Re-checked rows may have moved; otherwise only the new tail is out of place
+        if (m_sortColumn >= 0)
+            resort(lastChanged >= 0 ? 0 : oldCount);
+    }
+
+    /// @brief Remove all rows and queued results
+    void clear() {
+        m_timer.stop();
+        {
+            std::lock_guard lock(m_lock);
+            m_pending.clear();
+        }
+        beginResetModel();
+        m_rows.clear();
+        m_index.clear();
+        endResetModel();
+    }
+
+    /// @brief The result shown in `row`
+    const BatchResult& result(int row) const { return m_rows.at(static_cast<std::size_t>(row)).result; }
+
+    int rowCount(const QModelIndex& parent = {}) const override {
+        return parent.isValid() ? 0 : static_cast<int>(m_rows.size());
+    }
+
+    int columnCount(const QModelIndex& parent = {}) const override {
+        return parent.isValid() ? 0 : ColumnCount;
+    }
+
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override {
+        if (!checkIndex(index, CheckIndexOption::IndexIsValid | CheckIndexOption::ParentIsInvalid))
+            return {};
+        const Row& row = m_rows[static_cast<std::size_t>(index.row())];
+        const BatchResult& r = row.result;
+        switch (role) {
+        case Qt::DisplayRole:
+            switch (index.column()) {
+            case Repository: return r.job.repoUrl;
+            case Local:      return r.job.localVersion;
+            case Latest:     return r.info.latestVersion;
+            case Status:     return statusText(r);
+            case Origin:     return r.job.origin;
+            }
+            return {};
+        case Qt::ToolTipRole:
+            return r.error.isEmpty() ? QVariant() : QVariant(r.error);
+        case SortRole:
+            switch (index.column()) {
+            case Local:  return row.localKey;
+            case Latest: return row.latestKey;
+            case Status: return statusRank(r);
+            default:     return data(index, Qt::DisplayRole);
+            }
+        case StatusRole:
+            return static_cast<int>(r.status);
+        case HasUpdateRole:
+            return r.status == BatchStatus::Ok && r.info.hasUpdate;
+        case ErrorRole:
+            return r.error;
+        }
+        return {};
+    }
+
+    QVariant headerData(int section, Qt::Orientation orientation,
+                        int role = Qt::DisplayRole) const override {
+        if (orientation != Qt::Horizontal || role != Qt::DisplayRole)
+            return QAbstractTableModel::headerData(section, orientation, role);
+        switch (section) {
+        case Repository: return QStringLiteral("Repository");
+        case Local:      return QStringLiteral("Local");
+        case Latest:     return QStringLiteral("Latest");
+        case Status:     return QStringLiteral("Status");
+        case Origin:     return QStringLiteral("Origin");
+        }
+        return {};
+    }
+
+    QHash<int, QByteArray> roleNames() const override {
+        QHash<int, QByteArray> names = QAbstractTableModel::roleNames();
+        names.insert(SortRole, "sortKey");
+        names.insert(StatusRole, "status");
+        names.insert(HasUpdateRole, "hasUpdate");
+        names.insert(ErrorRole, "error");
+        return names;
+    }
+
+    /// @brief Sort by `column`; rows queued later are merged into place
+    ///
+    /// Version columns compare the parsed versions (unparsable ones first),
+    /// Status orders updates, up-to-date rows and failures. Ties keep
+    /// their current order. A column outside the table turns sorting off.
+    void sort(int column, Qt::SortOrder order = Qt::AscendingOrder) override {
+        m_sortColumn = column >= 0 && column < ColumnCount ? column : -1;
+        m_sortOrder = order;
+        if (m_sortColumn >= 0)
+            resort(0);
+    }
+
+private:
+    struct Row {
+        BatchResult result;
+        QString key;            ///< "owner/repo@version"
+        quint64 localKey = 0;   ///< versionKey() of the local version
+        quint64 latestKey = 0;  ///< versionKey() of the latest tag
+    };
+
+    /// Parsed version packed for comparison; 0 if there is none
+    static quint64 versionKey(const QString& v) {
+        const auto version =
+            core::findVersion(std::u16string_view(v.utf16(), static_cast<std::size_t>(v.size())));
+        if (!version)
+            return 0;
+        constexpr quint64 limit = (quint64{1} << 21) - 1;
+        auto part = [](int n) { return std::min<quint64>(static_cast<quint64>(n), limit); };
+        return ((part(version->major) << 42) | (part(version->minor) << 21) | part(version->patch)) + 1;
+    }
+
+    static Row makeRow(BatchResult result) {
+        Row row;
+        try {
+            row.key = toRepoSlug(result.job.repoUrl);
+        } catch (const std::exception&) {
+            row.key = result.job.repoUrl;   // keep unrecognized URLs under their literal spelling
+        }
+        row.key += QLatin1Char('@') + result.job.localVersion;
+        row.localKey = versionKey(result.job.localVersion);
+        if (result.status == BatchStatus::Ok)
+            row.latestKey = versionKey(result.info.latestVersion);
+        row.result = std::move(result);
+        return row;
+    }
+
+    static QString statusText(const BatchResult& r) {
+        switch (r.status) {
+        case BatchStatus::Ok:
+            return r.info.hasUpdate ? QStringLiteral("Update available") : QStringLiteral("Up to date");
+        case BatchStatus::Failed:    return QStringLiteral("Failed");
+        case BatchStatus::TimedOut:  return QStringLiteral("Timed out");
+        case BatchStatus::Cancelled: return QStringLiteral("Cancelled");
+        }
+        return {};
+    }
+
+    static int statusRank(const BatchResult& r) {
+        if (r.status == BatchStatus::Ok)
+            return r.info.hasUpdate ? 0 : 1;
+        return 1 + static_cast<int>(r.status);
+    }
+
+    bool lessThan(const Row& a, const Row& b) const {
+        switch (m_sortColumn) {
+        case Local:  return a.localKey < b.localKey;
+        case Latest: return a.latestKey < b.latestKey;
+        case Status: return statusRank(a.result) < statusRank(b.result);
+        case Origin: return a.result.job.origin < b.result.job.origin;
+        default:
+            return a.result.job.repoUrl.compare(b.result.job.repoUrl, Qt::CaseInsensitive) < 0;
+        }
+    }
+
+    /// Restore the sort order; rows [0, sortedPrefix) are already in order
+    void resort(qsizetype sortedPrefix) {
+        const std::size_t n = m_rows.size();
+        auto less = [this](std::size_t a, std::size_t b) {
+            return m_sortOrder == Qt::AscendingOrder ? lessThan(m_rows[a], m_rows[b])
+                                                     : lessThan(m_rows[b], m_rows[a]);
+        };
+        std::vector<std::size_t> order(n);
+        std::iota(order.begin(), order.end(), std::size_t{0});
+        const auto middle = order.begin() + sortedPrefix;
+        std::stable_sort(middle, order.end(), less);
+        std::inplace_merge(order.begin(), middle, order.end(), less);
+
+        bool moved = false;
+        for (std::size_t i = 0; i < n && !moved; ++i)
+            moved = order[i] != i;
+        if (!moved)
+            return;
+
+        layoutAboutToBeChanged({}, QAbstractItemModel::VerticalSortHint);
+        std::vector<int> newRow(n);
+        std::vector<Row> rows;
+        rows.reserve(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            newRow[order[i]] = static_cast<int>(i);
+            rows.push_back(std::move(m_rows[order[i]]));
+        }
+        const QModelIndexList from = persistentIndexList();
+        QModelIndexList to;
+        to.reserve(from.size());
+        for (const QModelIndex& index : from)
+            to.append(this->index(newRow[static_cast<std::size_t>(index.row())], index.column()));
+        changePersistentIndexList(from, to);
+        m_rows = std::move(rows);
+        for (std::size_t i = 0; i < n; ++i)
+            m_index.insert(m_rows[i].key, static_cast<qsizetype>(i));
+        layoutChanged({}, QAbstractItemModel::VerticalSortHint);
+    }
+
+    std::vector<Row> m_rows;
+    QHash<QString, qsizetype> m_index;      ///< Row of each key
+    int m_sortColumn = -1;
+    Qt::SortOrder m_sortOrder = Qt::AscendingOrder;
+
+    std::mutex m_lock;                      ///< Guards m_pending
+    std::vector<BatchResult> m_pending;
+    QTimer m_timer;
+    std::chrono::milliseconds m_interval{16};
+};
+
+} // namespace qtgh
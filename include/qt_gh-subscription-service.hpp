@@ -0,0 +1,446 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: 2026 Zheng-Bote
+//
+// qt_gh-subscription-service.hpp - Local release subscription service
+//
+// A long-lived service that local clients (IDE plugins, tray apps, build
+// agents) connect to over a QLocalSocket to subscribe to repositories.
+// The service polls every subscribed repository once, however many
+// clients want it, using the adaptive ReleaseScheduler, and pushes a
+// message to the subscribers only when a new version appears.
+//
+// Protocol (one compact JSON object per line, UTF-8):
+//   client -> service
+//     {"op":"subscribe","repos":["https://github.com/owner/repo", ...]}
+//     {"op":"unsubscribe","repos":[...]}
+//   service -> client
+//     {"event":"subscribed","repos":{"owner/repo":"v1.2.3", ...}}   (known tags, "" if not yet polled)
+//     {"event":"release","repo":"owner/repo","tag":"v1.3.0","published_at":"..."}
+//     {"event":"error","message":"..."}
+//
+// Lines longer than 64 KiB are answered with an error and the client is
+// disconnected.
+//
+// Usage:
+//   #include "qt_gh-subscription-service.hpp"
+//   qtgh::SubscriptionService service;
+//   service.listen("qt_gh-update-checker");
+//
+//   qtgh::SubscriptionClient client;
+//   client.setReleaseHandler([](const QString& repo, const QString& tag) { ... });
+//   client.connectToService("qt_gh-update-checker");
+//   client.subscribe({"https://github.com/nlohmann/json"});
+
+#pragma once
+#include "qt_gh-release-scheduler.hpp"
+#include "qt_gh-update-checker.hpp"
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QSet>
+#include <QTimer>
+
+namespace qtgh {
+
+namespace detail {
+
+/// Split complete lines off a receive buffer
+inline QList<QByteArray> takeLines(QByteArray& buffer) {
+    QList<QByteArray> lines;
+    qsizetype start = 0;
+    for (qsizetype nl = buffer.indexOf('\n'); nl >= 0; nl = buffer.indexOf('\n', start)) {
+        lines.append(buffer.mid(start, nl - start));
+        start = nl + 1;
+    }
+    buffer.remove(0, start);
+    return lines;
+}
+
+inline QByteArray jsonLine(const QJsonObject& obj) {
+    return QJsonDocument(obj).toJson(QJsonDocument::Compact) + '\n';
+}
+
+} // namespace detail
+
+// ---------------------------------------------------------
+// SubscriptionService
+// ---------------------------------------------------------
+/// @brief Deduplicating release poller with push fan-out to local clients
+///
+/// Each subscribed repository is tracked once in a ReleaseScheduler and
+/// polled with at most maxInFlight() concurrent requests. The first poll
+/// establishes the baseline tag; later polls that return a newer tag
+/// (by SemVer, or any different tag if it is not SemVer) are serialized
+/// once and written to every subscriber.
+///
+/// Releases learned from elsewhere (e.g. WebhookReceiver) can be injected
+/// with notifyRelease(), which updates the baseline and fans out at once.
+class SubscriptionService {
+public:
+    /// @brief Counters for monitoring and load tests
+    struct Stats {
+        quint64 polls = 0;          ///< Polls performed (one per due repository)
+        quint64 cacheHits = 0;      ///< Polls answered by the ReleaseCache
+        quint64 notifications = 0;  ///< New versions detected
+        quint64 messagesSent = 0;   ///< Release messages written to clients
+    };
+
+    /// @brief Longest request line accepted from a client (bytes, without '\n')
+    static constexpr qsizetype kMaxLineLength = 64 * 1024;
+
+    explicit SubscriptionService(ReleaseScheduler::Config schedule = {})
+        : m_scheduler(schedule)
+    {
+        m_timer.setSingleShot(true);
+        QObject::connect(&m_timer, &QTimer::timeout, &m_timer, [this] { startDue(); });
+        QObject::connect(&m_server, &QLocalServer::newConnection, &m_server,
+                         [this] { acceptClients(); });
+    }
+
+    SubscriptionService(const SubscriptionService&) = delete;
+    SubscriptionService& operator=(const SubscriptionService&) = delete;
+
+    ~SubscriptionService() {
+        m_timer.stop();
+        for (auto* reply : m_mgr.findChildren<QNetworkReply*>()) {
+            QObject::disconnect(reply, nullptr, nullptr, nullptr);
+            reply->abort();
+        }
+        // Client sockets are children of m_server, which is destroyed after
+        // m_clients and m_repos; their disconnected() must not reach dropClient()
+        for (auto* socket : m_server.findChildren<QLocalSocket*>()) {
+            QObject::disconnect(socket, nullptr, nullptr, nullptr);
+            socket->abort();
+        }
+        m_server.close();
+    }
+
+    /// @brief Listen on a local socket name (a stale socket file is removed)
+    bool listen(const QString& name) {
+        QLocalServer::removeServer(name);
+        return m_server.listen(name);
+    }
+
+    QString fullServerName() const { return m_server.fullServerName(); }
+    QString errorString() const { return m_server.errorString(); }
+
+    /// @brief Options for upstream polls (e.g. a ReleaseCache shared with a WebhookReceiver)
+    void setOptions(const CheckOptions& options) { m_options = options; }
+
+    /// @brief Maximum number of concurrent upstream polls (default 8)
+    void setMaxInFlight(int n) { m_maxInFlight = std::max(1, n); }
+    int maxInFlight() const { return m_maxInFlight; }
+
+    qsizetype clientCount() const { return m_clients.size(); }
+    qsizetype repoCount() const { return m_repos.size(); }
+    const Stats& stats() const { return m_stats; }
+
+    /// @brief Last known tag of a subscribed repository ("" if not yet polled)
+    QString latestTag(const QString& slug) const { return m_repos.value(slug).tag; }
+
+    /// @brief Inject a release learned from another source and fan it out
+    /// @param slug Repository slug ("owner/repo")
+    /// @param release The release
+    void notifyRelease(const QString& slug, const ReleaseRecord& release) {
+        if (m_repos.contains(slug))
+            applyRelease(slug, release);
+    }
+
+private:
+    struct Client {
+        QByteArray buffer;
+        QSet<QString> repos;
+    };
+
+    struct Repo {
+        QString tag;                    ///< Last known tag ("" before the first poll)
+        QSet<QLocalSocket*> subscribers;
+    };
+
+    // --- clients --------------------------------------------------------
+
+    void acceptClients() {
+        while (QLocalSocket* socket = m_server.nextPendingConnection()) {
+            m_clients.insert(socket, Client{});
+            QObject::connect(socket, &QLocalSocket::readyRead, socket,
+                             [this, socket] { readClient(socket); });
+            QObject::connect(socket, &QLocalSocket::disconnected, socket,
+                             [this, socket] { dropClient(socket); });
+        }
+    }
+
+    void readClient(QLocalSocket* socket) {
+        auto it = m_clients.find(socket);
+        if (it == m_clients.end())
+            return;
+        if (socket->state() != QLocalSocket::ConnectedState) {
+            socket->readAll();      // closing after a rejected line
+            return;
+        }
+        it->buffer.append(socket->readAll());
+        const QList<QByteArray> lines = detail::takeLines(it->buffer);
+        if (it->buffer.size() > kMaxLineLength) {
+            rejectClient(socket);
+            return;
+        }
+        for (const QByteArray& line : lines) {
+            if (line.size() > kMaxLineLength) {
+                rejectClient(socket);
+                return;
+            }
+            const auto doc = QJsonDocument::fromJson(line);
+            const QString op = doc.object()["op"].toString();
+            const QJsonArray repos = doc.object()["repos"].toArray();
+            if (op == "subscribe")
+                subscribe(socket, repos);
+            else if (op == "unsubscribe")
+                unsubscribe(socket, repos);
+            else
+                socket->write(detail::jsonLine({{"event", "error"},
+                                                {"message", "Unknown op: " + op}}));
+        }
+    }
+
+    /// Answer a line longer than kMaxLineLength and disconnect the client;
+    /// without a limit, a client that never sends '\n' grows the buffer forever
+    void rejectClient(QLocalSocket* socket) {
+        m_clients[socket].buffer.clear();
+        socket->write(detail::jsonLine({{"event", "error"}, {"message", "Line too long"}}));
+        socket->disconnectFromServer();
+    }
+
+    void subscribe(QLocalSocket* socket, const QJsonArray& repos) {
+        const auto now = ReleaseScheduler::Clock::now();
+        QJsonObject known;
+        for (const auto& value : repos) {
+            QString slug;
+            try {
+                slug = toRepoSlug(value.toString());
+            } catch (const std::exception& e) {
+                socket->write(detail::jsonLine({{"event", "error"},
+                                                {"message", QString::fromUtf8(e.what())}}));
+                continue;
+            }
+            Repo& repo = m_repos[slug];
+            repo.subscribers.insert(socket);
+            m_clients[socket].repos.insert(slug);
+            m_scheduler.addRepo(slug, now);
+            known.insert(slug, repo.tag);
+        }
+        socket->write(detail::jsonLine({{"event", "subscribed"}, {"repos", known}}));
+        startDue();
+    }
+
+    void unsubscribe(QLocalSocket* socket, const QJsonArray& repos) {
+        for (const auto& value : repos) {
+            try {
+                dropSubscription(socket, toRepoSlug(value.toString()));
+            } catch (const std::exception&) {
+                // Unknown repositories cannot be subscribed either
+            }
+        }
+    }
+
+    void dropSubscription(QLocalSocket* socket, const QString& slug) {
+        m_clients[socket].repos.remove(slug);
+        auto it = m_repos.find(slug);
+        if (it == m_repos.end())
+            return;
+        it->subscribers.remove(socket);
+        if (it->subscribers.isEmpty()) {
+            m_repos.erase(it);
+            m_scheduler.removeRepo(slug);
+        }
+    }
+
+    void dropClient(QLocalSocket* socket) {
+        const QSet<QString> repos = m_clients.value(socket).repos;
+        for (const QString& slug : repos)
+            dropSubscription(socket, slug);
+        m_clients.remove(socket);
+        socket->deleteLater();
+    }
+
+    // --- polling --------------------------------------------------------
+
+    void startDue() {
+        const auto now = ReleaseScheduler::Clock::now();
+        const QStringList due = m_scheduler.takeDue(now, m_maxInFlight - m_inFlight);
+        for (const QString& slug : due)
+            poll(slug);
+        armTimer();
+    }
+
+    void armTimer() {
+        if (m_inFlight >= m_maxInFlight) {
+            m_timer.stop();     // re-armed when a poll finishes
+            return;
+        }
+        const auto due = m_scheduler.nextDueTime();
+        if (!due) {
+            m_timer.stop();
+            return;
+        }
+        const auto wait = std::chrono::duration_cast<std::chrono::milliseconds>(
+            *due - ReleaseScheduler::Clock::now());
+        m_timer.start(std::max(wait, std::chrono::milliseconds(0)));
+    }
+
+    void poll(const QString& slug) {
+        ++m_stats.polls;
+        if (m_options.cache) {
+            if (auto hit = m_options.cache->lookup(slug)) {
+                ++m_stats.cacheHits;
+                pollFinished(slug, *hit);
+                return;
+            }
+        }
+
+        ++m_inFlight;
+        const QString apiUrl = toGithubApiUrl(QStringLiteral("https://github.com/") + slug,
+                                              m_options.apiBaseUrl);
+        QNetworkReply* reply = m_mgr.get(makeGithubRequest(apiUrl));
+        QObject::connect(reply, &QNetworkReply::finished, reply, [this, reply, slug] {
+            reply->deleteLater();
+            --m_inFlight;
+            const auto now = ReleaseScheduler::Clock::now();
+            try {
+                if (reply->error() != QNetworkReply::NoError)
+                    throw std::runtime_error(reply->errorString().toStdString());
+                ReleaseRecord release = parseRelease(reply->readAll());
+                if (m_options.cache) {
+                    release.fetchedAt = QDateTime::currentDateTimeUtc();
+                    release.expiresAt = release.fetchedAt.addSecs(m_options.maxAge.count());
+                    m_options.cache->store(slug, release);
+                }
+                pollFinished(slug, release);
+            } catch (const std::exception&) {
+                m_scheduler.recordFailure(slug, now);
+            }
+            startDue();
+        });
+    }
+
+    void pollFinished(const QString& slug, const ReleaseRecord& release) {
+        if (!m_repos.contains(slug))
+            return;     // last subscriber left while the poll was running
+        m_scheduler.recordCheck(slug, release.tag, ReleaseScheduler::Clock::now(),
+                                ReleaseScheduler::fromQDateTime(release.publishedAt));
+        applyRelease(slug, release);
+    }
+
+    void applyRelease(const QString& slug, const ReleaseRecord& release) {
+        Repo& repo = m_repos[slug];
+        const QString previous = repo.tag;
+        if (!isNewer(release.tag, previous))
+            return;
+        repo.tag = release.tag;
+        if (previous.isEmpty())
+            return;     // baseline, not a new version
+
+        ++m_stats.notifications;
+        const QByteArray message = detail::jsonLine({
+            {"event", "release"},
+            {"repo", slug},
+            {"tag", release.tag},
+            {"published_at", release.publishedAt.toString(Qt::ISODate)},
+        });
+        for (QLocalSocket* socket : std::as_const(repo.subscribers)) {
+            socket->write(message);
+            ++m_stats.messagesSent;
+        }
+    }
+
+    static bool isNewer(const QString& tag, const QString& previous) {
+        if (previous.isEmpty())
+            return true;
+        if (tag == previous)
+            return false;
+        try {
+            return SemVer::parse(tag) > SemVer::parse(previous);
+        } catch (const std::exception&) {
+            return true;    // not SemVer: any change counts
+        }
+    }
+
+    QLocalServer m_server;
+    QNetworkAccessManager m_mgr;
+    QTimer m_timer;
+    ReleaseScheduler m_scheduler;
+    CheckOptions m_options;
+    QHash<QLocalSocket*, Client> m_clients;
+    QHash<QString, Repo> m_repos;
+    Stats m_stats;
+    int m_maxInFlight = 8;
+    int m_inFlight = 0;
+};
+
+// ---------------------------------------------------------
+// SubscriptionClient
+// ---------------------------------------------------------
+/// @brief Client side of the subscription protocol
+///
+/// @example
+///   qtgh::SubscriptionClient client;
+///   client.setReleaseHandler([](const QString& repo, const QString& tag) {
+///       showTrayNotification(repo + " " + tag);
+///   });
+///   if (client.connectToService("qt_gh-update-checker"))
+///       client.subscribe({"https://github.com/nlohmann/json"});
+class SubscriptionClient {
+public:
+    using ReleaseHandler = std::function<void(const QString& repo, const QString& tag)>;
+    using MessageHandler = std::function<void(const QJsonObject& message)>;
+
+    SubscriptionClient() {
+        QObject::connect(&m_socket, &QLocalSocket::readyRead, &m_socket, [this] {
+            m_buffer.append(m_socket.readAll());
+            for (const QByteArray& line : detail::takeLines(m_buffer)) {
+                const QJsonObject msg = QJsonDocument::fromJson(line).object();
+                if (m_onMessage)
+                    m_onMessage(msg);
+                if (m_onRelease && msg["event"].toString() == "release")
+                    m_onRelease(msg["repo"].toString(), msg["tag"].toString());
+            }
+        });
+    }
+
+    /// @brief Connect to the service
+    /// @param name Local socket name passed to SubscriptionService::listen()
+    /// @param timeoutMs Connect timeout
+    /// @return true if connected
+    bool connectToService(const QString& name, int timeoutMs = 3000) {
+        m_socket.connectToServer(name);
+        return m_socket.waitForConnected(timeoutMs);
+    }
+
+    /// @brief Subscribe to repositories (any URL form accepted by toRepoSlug())
+    void subscribe(const QStringList& repos) { send("subscribe", repos); }
+
+    /// @brief Unsubscribe from repositories
+    void unsubscribe(const QStringList& repos) { send("unsubscribe", repos); }
+
+    /// @brief Callback for "release" events
+    void setReleaseHandler(ReleaseHandler handler) { m_onRelease = std::move(handler); }
+
+    /// @brief Callback for every message received (including "subscribed" and "error")
+    void setMessageHandler(MessageHandler handler) { m_onMessage = std::move(handler); }
+
+    QLocalSocket& socket() { return m_socket; }
+
+private:
+    void send(const char* op, const QStringList& repos) {
+        m_socket.write(detail::jsonLine({{"op", op}, {"repos", QJsonArray::fromStringList(repos)}}));
+    }
+
+    QLocalSocket m_socket;
+    QByteArray m_buffer;
+    ReleaseHandler m_onRelease;
+    MessageHandler m_onMessage;
+};
+
+} // namespace qtgh
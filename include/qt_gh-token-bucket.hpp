@@ -0,0 +1,113 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: 2026 Zheng-Bote
+//
+// qt_gh-token-bucket.hpp - Token bucket rate limit
+//
+// Tokens (bytes) accumulate at rate() per second up to burst(); a transfer
+// may move as many bytes as there are tokens. Over any interval the amount
+// moved is at most burst() + rate() * interval, so the long-term rate is
+// rate() while short pauses do not waste bandwidth.
+//
+// The bucket only does the bookkeeping; AssetDownloader asks it how much
+// to read from a reply and when to try again.
+//
+// Usage:
+//   #include "qt_gh-token-bucket.hpp"
+//   qtgh::TokenBucket bucket(512 * 1024);           // 512 KiB/s
+//   const qint64 n = std::min(wanted, bucket.available());
+//   bucket.consume(n);
+//   ... if n < wanted, retry after bucket.waitFor(wanted) ...
+
+#pragma once
+#include <QtGlobal>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+
+namespace qtgh {
+
+// ---------------------------------------------------------
+// TokenBucket
+// ---------------------------------------------------------
+/// @brief Byte rate limit with a bounded burst
+///
+/// A rate of 0 means unlimited. The bucket starts full. Changing the rate
+/// keeps the tokens collected so far (capped at the new burst), so limits
+/// can be adjusted while a transfer runs. Not thread-safe.
+///
+/// @example
+///   qtgh::TokenBucket bucket(1024 * 1024);   // 1 MiB/s, burst 100 ms = 102.4 KiB
+///   bucket.setRate(256 * 1024);              // slower from now on
+class TokenBucket {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /// @brief Smallest default burst, so slow rates still move useful chunks
+    static constexpr qint64 kMinBurst = 4 * 1024;
+
+    /// @param bytesPerSecond Rate (0 = unlimited)
+    /// @param burst Bucket size in bytes (0 = a tenth of a second of the rate, at least kMinBurst)
+    explicit TokenBucket(qint64 bytesPerSecond = 0, qint64 burst = 0, Clock::time_point now = Clock::now())
+        : m_last(now) {
+        setRate(bytesPerSecond, burst, now);
+        m_tokens = static_cast<double>(m_burst);
+    }
+
+    /// @brief Change the rate; tokens collected so far are kept up to the new burst
+    void setRate(qint64 bytesPerSecond, qint64 burst = 0, Clock::time_point now = Clock::now()) {
+        refill(now);
+        m_rate = std::max<qint64>(0, bytesPerSecond);
+        m_burst = burst > 0 ? burst : std::max(kMinBurst, m_rate / 10);
+        m_tokens = std::min(m_tokens, static_cast<double>(m_burst));
+    }
+
+    qint64 rate() const { return m_rate; }
+    qint64 burst() const { return m_burst; }
+    bool unlimited() const { return m_rate == 0; }
+
+    /// @brief Bytes that may be moved now
+    qint64 available(Clock::time_point now = Clock::now()) {
+        if (unlimited())
+            return std::numeric_limits<qint64>::max();
+        refill(now);
+        return static_cast<qint64>(m_tokens);
+    }
+
+    /// @brief Take `bytes` tokens (after available() allowed them)
+    void consume(qint64 bytes) {
+        if (!unlimited())
+            m_tokens = std::max(0.0, m_tokens - static_cast<double>(bytes));
+    }
+
+    /// @brief Time until min(`bytes`, burst()) tokens are available
+    std::chrono::nanoseconds waitFor(qint64 bytes, Clock::time_point now = Clock::now()) const {
+        if (unlimited())
+            return {};
+        const double tokens = std::min(static_cast<double>(m_burst), m_tokens + elapsedTokens(now));
+        const double missing = static_cast<double>(std::min(bytes, m_burst)) - tokens;
+        if (missing <= 0)
+            return {};
+        return std::chrono::nanoseconds(
+            static_cast<qint64>(std::ceil(missing * 1e9 / static_cast<double>(m_rate))));
+    }
+
+private:
+    double elapsedTokens(Clock::time_point now) const {
+        if (now <= m_last)
+            return 0;
+        return std::chrono::duration<double>(now - m_last).count() * static_cast<double>(m_rate);
+    }
+
+    void refill(Clock::time_point now) {
+        m_tokens = std::min(static_cast<double>(m_burst), m_tokens + elapsedTokens(now));
+        m_last = std::max(m_last, now);
+    }
+
+    qint64 m_rate = 0;
+    qint64 m_burst = kMinBurst;
+    double m_tokens = 0;
+    Clock::time_point m_last;
+};
+
+} // namespace qtgh
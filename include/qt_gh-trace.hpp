@@ -0,0 +1,260 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: 2026 Zheng-Bote
+//
+// qt_gh-trace.hpp - Span recorder with Chrome trace / Perfetto export
+//
+// Records timing spans of batch checks into per-thread ring buffers and
+// writes them in the Chrome trace event format, which chrome://tracing,
+// Perfetto (ui.perfetto.dev) and speedscope open directly.
+//
+// Two kinds of spans are recorded:
+// - complete spans ("X") for synchronous work on one thread (JSON parse,
+//   SemVer compare); they appear on that thread's track
+// - async spans ("b"/"e") for the phases of one check (queue, connect,
+//   request, download); they are grouped by check id, so overlapping
+//   checks on the event-loop thread get a track each
+//
+// Recording is lock-free: every thread appends to its own ring buffer
+// (oldest events are overwritten when it is full). Nothing is recorded
+// unless a recorder is installed.
+//
+// Usage:
+//   #include "qt_gh-trace.hpp"
+//   qtgh::TraceRecorder trace;
+//   trace.install();
+//   ... run batch checks ...
+//   trace.writeChromeTrace("out.json");
+
+#pragma once
+#include <QByteArray>
+#include <QCoreApplication>
+#include <QFile>
+#include <QString>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace qtgh {
+
+// ---------------------------------------------------------
+// TraceRecorder
+// ---------------------------------------------------------
+/// @brief Process-wide recorder of trace spans
+///
+/// Library code records through TraceRecorder::active(), which is null
+/// unless a recorder was installed, so tracing costs one atomic load when
+/// disabled. writeChromeTrace() must only be called while no thread is
+/// recording (e.g. after the batch finished and worker threads joined).
+///
+/// @example
+///   qtgh::TraceRecorder trace;
+///   trace.install();
+///   const qint64 t0 = qtgh::TraceRecorder::now();
+///   doWork();
+///   if (auto* t = qtgh::TraceRecorder::active())
+///       t->complete("work", t0, qtgh::TraceRecorder::now());
+class TraceRecorder {
+public:
+    /// @brief Create a recorder
+    /// @param eventsPerThread Ring buffer capacity of each recording thread
+    explicit TraceRecorder(qsizetype eventsPerThread = 1 << 16)
+        : m_capacity(static_cast<std::size_t>(std::max<qsizetype>(1, eventsPerThread))),
+          m_serial(s_serial.fetch_add(1) + 1) {}
+
+    TraceRecorder(const TraceRecorder&) = delete;
+    TraceRecorder& operator=(const TraceRecorder&) = delete;
+
+    ~TraceRecorder() { uninstall(); }
+
+    /// @brief Make this the recorder returned by active()
+    void install() { s_active.store(this); }
+
+    /// @brief Stop recording into this recorder
+    void uninstall() {
+        TraceRecorder* self = this;
+        s_active.compare_exchange_strong(self, nullptr);
+    }
+
+    /// @brief Installed recorder, or nullptr if tracing is disabled
+    static TraceRecorder* active() { return s_active.load(std::memory_order_acquire); }
+
+    /// @brief Monotonic timestamp in nanoseconds used for all spans
+    static qint64 now() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    /// @brief Allocate an id for a group of async spans (e.g. one check)
+    quint64 nextId() { return m_nextId.fetch_add(1) + 1; }
+
+    /// @brief Record a synchronous span on the calling thread
+    /// @param name Span name (must be a string literal or otherwise outlive the recorder)
+    void complete(const char* name, qint64 startNs, qint64 endNs, QString detail = {}) {
+        append({name, startNs, endNs - startNs, 0, false, std::move(detail)});
+    }
+
+    /// @brief Record a span of the async track `id`
+    /// @param name Span name (must be a string literal or otherwise outlive the recorder)
+    void async(const char* name, quint64 id, qint64 startNs, qint64 endNs, QString detail = {}) {
+        append({name, startNs, endNs - startNs, id, true, std::move(detail)});
+    }
+
+    /// @brief Number of events overwritten because a ring buffer was full
+    quint64 dropped() const {
+        std::lock_guard lock(m_mutex);
+        quint64 n = 0;
+        for (const auto& buffer : m_buffers)
+            n += buffer->dropped;
+        return n;
+    }
+
+    /// @brief Write all recorded events as a Chrome trace JSON file
+    /// @param path Output file
+    /// @param error Receives the error message on failure (optional)
+    /// @return true on success
+    bool writeChromeTrace(const QString& path, QString* error = nullptr) const {
+        QFile file(path);
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            if (error)
+                *error = file.errorString();
+            return false;
+        }
+
+        std::lock_guard lock(m_mutex);
+        const QByteArray pid = QByteArray::number(QCoreApplication::applicationPid());
+        qint64 origin = std::numeric_limits<qint64>::max();
+        for (const auto& buffer : m_buffers)
+            for (const auto& ev : buffer->events)
+                origin = std::min(origin, ev.start);
+
+        QByteArray out = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+        bool first = true;
+        auto put = [&](const QByteArray& json) {
+            if (!first)
+                out += ",\n";
+            first = false;
+            out += json;
+            if (out.size() > (1 << 20)) {
+                file.write(out);
+                out.clear();
+            }
+        };
+
+        for (const auto& buffer : m_buffers) {
+            const QByteArray tid = QByteArray::number(buffer->tid);
+            put("{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":" + pid + ",\"tid\":" + tid
+                + ",\"args\":{\"name\":\"" + escape(buffer->name) + "\"}}");
+
+            for (const auto& ev : buffer->events) {
+                const QByteArray ts = micros(ev.start - origin);
+                QByteArray args;
+                if (!ev.detail.isEmpty())
+                    args = ",\"args\":{\"detail\":\"" + escape(ev.detail) + "\"}";
+                const QByteArray common = "\"name\":\"" + QByteArray(ev.name) + "\",\"pid\":" + pid
+                                        + ",\"tid\":" + tid;
+                if (!ev.async) {
+                    put("{\"ph\":\"X\",\"cat\":\"cpu\"," + common + ",\"ts\":" + ts
+                        + ",\"dur\":" + micros(ev.duration) + args + "}");
+                } else {
+                    const QByteArray id = ",\"cat\":\"check\",\"id\":" + QByteArray::number(ev.id);
+                    put("{\"ph\":\"b\"," + common + id + ",\"ts\":" + ts + args + "}");
+                    put("{\"ph\":\"e\"," + common + id + ",\"ts\":"
+                        + micros(ev.start + ev.duration - origin) + "}");
+                }
+            }
+        }
+        out += "\n]}\n";
+        file.write(out);
+
+        if (!file.flush()) {
+            if (error)
+                *error = file.errorString();
+            return false;
+        }
+        return true;
+    }
+
+private:
+    struct Event {
+        const char* name = "";
+        qint64 start = 0;       ///< ns, steady clock
+        qint64 duration = 0;    ///< ns
+        quint64 id = 0;         ///< Async track id
+        bool async = false;
+        QString detail;
+    };
+
+    struct ThreadBuffer {
+        std::vector<Event> events;
+        std::size_t next = 0;   ///< Slot written next once the ring is full
+        quint64 dropped = 0;
+        quint32 tid = 0;
+        QString name;
+    };
+
+    void append(Event ev) {
+        // Cached per thread; the serial tells buffers of a previous recorder apart
+        thread_local struct {
+            quint64 serial = 0;
+            ThreadBuffer* buffer = nullptr;
+        } local;
+
+        if (local.serial != m_serial) {
+            std::lock_guard lock(m_mutex);
+            auto buffer = std::make_unique<ThreadBuffer>();
+            buffer->tid = static_cast<quint32>(m_buffers.size() + 1);
+            buffer->name = QStringLiteral("thread %1").arg(buffer->tid);
+            buffer->events.reserve(std::min<std::size_t>(m_capacity, 1024));
+            local.buffer = buffer.get();
+            local.serial = m_serial;
+            m_buffers.push_back(std::move(buffer));
+        }
+
+        ThreadBuffer& b = *local.buffer;
+        if (b.events.size() < m_capacity) {
+            b.events.push_back(std::move(ev));
+        } else {
+            b.events[b.next] = std::move(ev);
+            b.next = (b.next + 1) % m_capacity;
+            ++b.dropped;
+        }
+    }
+
+    static QByteArray micros(qint64 ns) {
+        return QByteArray::number(static_cast<double>(ns) / 1000.0, 'f', 3);
+    }
+
+    static QByteArray escape(const QString& s) {
+        QByteArray out;
+        for (const char c : s.toUtf8()) {
+            switch (c) {
+            case '"':  out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20)
+                    out += "\\u00" + QByteArray::number(static_cast<unsigned char>(c), 16)
+                                         .rightJustified(2, '0');
+                else
+                    out += c;
+            }
+        }
+        return out;
+    }
+
+    static inline std::atomic<TraceRecorder*> s_active{nullptr};
+    static inline std::atomic<quint64> s_serial{0};
+
+    const std::size_t m_capacity;
+    const quint64 m_serial;
+    std::atomic<quint64> m_nextId{0};
+    mutable std::mutex m_mutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> m_buffers;
+};
+
+} // namespace qtgh
@@ -0,0 +1,400 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: 2026 Zheng-Bote
+//
+// qt_gh-update-checker-impl.hpp - Definitions of qt_gh-update-checker.hpp
+//
+// The functions declared QTGH_DECL in qt_gh-update-checker.hpp: networking,
+// the network thread, failure persistence and the check itself. Included
+// at the end of qt_gh-update-checker.hpp in header-only builds; compiled
+// once into qt_gh_update_checker_static / _shared otherwise
+// (src/qt_gh-update-checker.cpp). Not meant to be included directly.
+
+#pragma once
+#include "qt_gh-update-checker.hpp"
+#include "qt_gh-network-status.hpp"
+#include <QCoreApplication>
+#include <QEventLoop>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QSaveFile>
+#include <QThread>
+
+namespace qtgh {
+
+// ---------------------------------------------------------
+// GitHub API Conversion
+// ---------------------------------------------------------
+QTGH_DECL QNetworkRequest makeGithubRequest(const QString& url) {
+    QNetworkRequest req{QUrl(url)};
+    req.setHeader(QNetworkRequest::UserAgentHeader, "Qt-gh-update-checker");
+    return req;
+}
+
+// ---------------------------------------------------------
+// Network Requests
+// ---------------------------------------------------------
+namespace detail {
+
+QTGH_DECL void AbortOnStop::Abort::operator()() const {
+    QMetaObject::invokeMethod(reply, &QNetworkReply::abort, Qt::AutoConnection);
+}
+
+/// @brief Turn a finished reply into its body, or throw like http_get()
+/// @param stopRequested Whether an abort was caused by the caller's stop token
+///
+/// Schedules the reply for deletion; shared by the caller-thread and the
+/// network-thread request paths.
+QTGH_DECL QByteArray takeReply(QNetworkReply* reply, std::chrono::milliseconds timeout,
+                               bool stopRequested) {
+    reply->deleteLater();
+    const int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    if (reply->error() == QNetworkReply::OperationCanceledError && stopRequested) {
+        QTGH_PROBE3(request_done, reply, 0, -1);
+        throw CancelledError();
+    }
+    if (reply->error() != QNetworkReply::NoError) {
+        QTGH_PROBE3(request_done, reply, status, -1);
+        auto msg = reply->errorString();
+        if (timeout.count() > 0 && (reply->error() == QNetworkReply::OperationCanceledError
+                                    || reply->error() == QNetworkReply::TimeoutError))
+            msg = QStringLiteral("timed out after %1 ms").arg(timeout.count());
+        const auto message = ("Network error: " + msg).toStdString();
+        if (const auto kind = failureKindForStatus(status))
+            throw CheckFailure(*kind, message);
+        throw std::runtime_error(message);
+    }
+
+    QByteArray data = reply->readAll();
+    QTGH_PROBE3(request_done, reply, status, static_cast<long long>(data.size()));
+    return data;
+}
+
+} // namespace detail
+
+QTGH_DECL NetworkThread& NetworkThread::instance() {
+    static NetworkThread thread;
+    return thread;
+}
+
+QTGH_DECL NetworkThread::~NetworkThread() { shutdown(); }
+
+QTGH_DECL void NetworkThread::submit(const QString& url, std::chrono::milliseconds timeout,
+                                     std::stop_token stop, Completion done) {
+    std::lock_guard lock(m_lock);
+    if (!ensureRunning()) {
+        done(std::make_exception_ptr(
+                 std::runtime_error("Network error: network thread stopped")), {});
+        return;
+    }
+    QMetaObject::invokeMethod(
+        m_context,
+        [this, url, timeout, stop = std::move(stop), done = std::move(done)]() mutable {
+            startRequest(url, timeout, std::move(stop), std::move(done));
+        },
+        Qt::QueuedConnection);
+}
+
+QTGH_DECL void NetworkThread::shutdown() {
+    std::lock_guard lock(m_lock);
+    if (!m_thread.joinable())
+        return;
+    QMetaObject::invokeMethod(m_context, [this] {
+        m_stopping = true;
+        m_loop->quit();
+    }, Qt::QueuedConnection);
+    m_thread.join();
+    m_context = nullptr;
+}
+
+QTGH_DECL bool NetworkThread::ensureRunning() {
+    if (m_thread.joinable())
+        return true;
+    // Qt's main thread was the stopped one; a second application object would not work
+    if (m_ownedApp)
+        return false;
+    std::promise<void> ready;
+    auto started = ready.get_future();
+    m_thread = std::thread([this, ready = std::move(ready)]() mutable { run(ready); });
+    started.wait();
+    return true;
+}
+
+QTGH_DECL void NetworkThread::run(std::promise<void>& ready) {
+    static int argc = 1;
+    static char name[] = "qt_gh-network-thread";
+    static char* argv[] = {name, nullptr};
+    std::optional<QCoreApplication> ownApp;
+    if (!QCoreApplication::instance())
+        ownApp.emplace(argc, argv);
+    else
+        qAddPostRoutine([] { NetworkThread::instance().shutdown(); });
+    m_ownedApp = ownApp.has_value();
+
+    QEventLoop loop;
+    QObject context;
+    QNetworkAccessManager mgr;
+    m_context = &context;
+    m_mgr = &mgr;
+    m_loop = &loop;
+    m_stopping = false;
+    m_threadId.store(std::this_thread::get_id(), std::memory_order_release);
+    ready.set_value();
+
+    loop.exec();
+
+    // Fail what is still running; the finished handlers complete the futures
+    for (QNetworkReply* reply : mgr.findChildren<QNetworkReply*>())
+        reply->abort();
+    m_threadId.store({}, std::memory_order_release);
+}
+
+QTGH_DECL void NetworkThread::startRequest(const QString& url,
+                                           std::chrono::milliseconds timeout,
+                                           std::stop_token stop, Completion done) {
+    if (stop.stop_requested()) {
+        done(std::make_exception_ptr(CancelledError()), {});
+        return;
+    }
+    QNetworkRequest req = makeGithubRequest(url);
+    if (timeout.count() > 0)
+        req.setTransferTimeout(timeout);
+
+    QNetworkReply* reply = m_mgr->get(req);
+    QTGH_PROBE2(request_start, reply, url.toUtf8().constData());
+    // Connected before the guard exists: a stop requested in between
+    // aborts (and finishes) the reply from the guard's constructor
+    auto guard = std::make_shared<std::unique_ptr<detail::AbortOnStop>>();
+    QObject::connect(reply, &QNetworkReply::finished, m_context,
+                     [this, reply, timeout, stop, guard, done = std::move(done)] {
+        guard->reset();
+        std::exception_ptr error;
+        QByteArray body;
+        try {
+            body = detail::takeReply(reply, timeout, stop.stop_requested());
+        } catch (...) {
+            error = std::current_exception();
+        }
+        if (error && m_stopping && !stop.stop_requested())
+            error = std::make_exception_ptr(
+                std::runtime_error("Network error: network thread stopped"));
+        done(std::move(error), std::move(body));
+    });
+    *guard = std::make_unique<detail::AbortOnStop>(reply, std::move(stop));
+}
+
+namespace detail {
+
+/// @brief GET with a manager and event loop of the calling thread
+QTGH_DECL QByteArray blockingGet(const QString& url, std::chrono::milliseconds timeout,
+                                 std::stop_token stop) {
+    QNetworkAccessManager mgr;
+    QNetworkRequest req = makeGithubRequest(url);
+    if (timeout.count() > 0)
+        req.setTransferTimeout(timeout);
+
+    QEventLoop loop;
+    QObject::connect(&mgr, &QNetworkAccessManager::finished,
+                     &loop, &QEventLoop::quit);
+
+    QNetworkReply* reply = mgr.get(req);
+    QTGH_PROBE2(request_start, reply, url.toUtf8().constData());
+    const AbortOnStop guard(reply, std::move(stop));
+    // A stop requested in the meantime has already finished the reply
+    if (!reply->isFinished())
+        loop.exec();
+    return takeReply(reply, timeout, guard.stopRequested());
+}
+
+} // namespace detail
+
+QTGH_DECL QByteArray http_get(const QString& url, std::chrono::milliseconds timeout,
+                              std::stop_token stop) {
+    if (stop.stop_requested())
+        throw CancelledError();
+
+    // Without an application object nothing may touch Qt's thread data
+    // before the network thread has created one
+    const auto* app = QCoreApplication::instance();
+    if (app && (QThread::currentThread() == app->thread()
+                || NetworkThread::instance().isCurrentThread()))
+        return detail::blockingGet(url, timeout, std::move(stop));
+    return NetworkThread::instance().get(url, timeout, std::move(stop)).get();
+}
+
+// ---------------------------------------------------------
+// Release Cache
+// ---------------------------------------------------------
+QTGH_DECL bool ReleaseCache::saveFailures(const QString& path, QString* error) const {
+    QJsonObject root;
+    {
+        QReadLocker lock(&m_lock);
+        for (auto it = m_failures.cbegin(); it != m_failures.cend(); ++it) {
+            root.insert(it.key(), QJsonObject{
+                {"kind", failureKindName(it->kind)},
+                {"error", it->error},
+                {"failures", it->failures},
+                {"failed_at", it->failedAt.toString(Qt::ISODate)},
+                {"retry_at", it->retryAt.toString(Qt::ISODate)},
+            });
+        }
+    }
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)
+        || file.write(QJsonDocument(root).toJson(QJsonDocument::Indented)) < 0
+        || !file.commit()) {
+        if (error)
+            *error = file.errorString();
+        return false;
+    }
+    return true;
+}
+
+QTGH_DECL bool ReleaseCache::loadFailures(const QString& path, QString* error) {
+    QFile file(path);
+    if (!file.exists())
+        return true;
+    if (!file.open(QIODevice::ReadOnly)) {
+        if (error)
+            *error = file.errorString();
+        return false;
+    }
+    QJsonParseError parseError;
+    const auto doc = QJsonDocument::fromJson(file.readAll(), &parseError);
+    if (!doc.isObject()) {
+        if (error)
+            *error = parseError.errorString();
+        return false;
+    }
+    const QJsonObject root = doc.object();
+    QWriteLocker lock(&m_lock);
+    for (auto it = root.begin(); it != root.end(); ++it) {
+        const QJsonObject entry = it.value().toObject();
+        const auto kind = failureKindFromName(entry["kind"].toString());
+        if (!kind)
+            continue;   // written by a newer version
+        m_failures.insert(it.key(), FailureRecord{
+            *kind,
+            entry["error"].toString(),
+            entry["failures"].toInt(1),
+            QDateTime::fromString(entry["failed_at"].toString(), Qt::ISODate),
+            QDateTime::fromString(entry["retry_at"].toString(), Qt::ISODate),
+        });
+    }
+    return true;
+}
+
+// ---------------------------------------------------------
+// Main API
+// ---------------------------------------------------------
+namespace detail {
+
+/// @brief What remains of a check after the cache and offline checks
+struct CheckPlan {
+    QString slug;                       ///< Cache key (empty without a cache)
+    QString apiUrl;                     ///< Release endpoint to fetch
+    std::optional<UpdateInfo> cached;   ///< Answer from the cache; nothing to fetch
+};
+
+/// @brief Steps of a check before the request
+/// @throws CheckFailure for a cached failure, OfflineError while offline
+inline CheckPlan planCheck(const QString& repoUrl, const QString& localVersion,
+                           const CheckOptions& options) {
+    CheckPlan plan;
+    if (options.cache) {
+        plan.slug = toRepoSlug(repoUrl);
+        if (auto hit = options.cache->lookup(plan.slug)) {
+            QTGH_PROBE1(cache_hit, plan.slug.toUtf8().constData());
+            plan.cached = compareRelease(*hit, localVersion);
+            return plan;
+        }
+        if (auto failure = options.cache->lookupFailure(plan.slug)) {
+            QTGH_PROBE1(cache_hit, plan.slug.toUtf8().constData());
+            throw CheckFailure(*failure);
+        }
+        QTGH_PROBE1(cache_miss, plan.slug.toUtf8().constData());
+    }
+
+    plan.apiUrl = toGithubApiUrl(repoUrl, options.apiBaseUrl);
+    if (options.offlineFastFail && NetworkStatus::isKnownOffline(plan.apiUrl))
+        throw OfflineError();
+    return plan;
+}
+
+/// @brief Steps of a check after the request: parse, cache, compare
+/// @param fetch Returns the response body or throws the request's error
+template <typename Fetch>
+UpdateInfo finishCheck(const CheckPlan& plan, const QString& localVersion,
+                       const CheckOptions& options, Fetch&& fetch) {
+    try {
+        QByteArray data = fetch();
+        ReleaseRecord release = parseRelease(data);
+
+        if (options.cache) {
+            release.fetchedAt = QDateTime::currentDateTimeUtc();
+            release.expiresAt = release.fetchedAt.addSecs(options.maxAge.count());
+            options.cache->store(plan.slug, release);
+        }
+
+        return compareRelease(release, localVersion);
+    } catch (const CheckFailure& e) {
+        if (options.cache)
+            options.cache->recordFailure(plan.slug, e.kind(), QString::fromUtf8(e.what()));
+        throw;
+    }
+}
+
+} // namespace detail
+
+QTGH_DECL UpdateInfo check_github_update(const QString& repoUrl,
+                                         const QString& localVersion,
+                                         const CheckOptions& options)
+{
+    detail::CheckPlan plan = detail::planCheck(repoUrl, localVersion, options);
+    if (plan.cached)
+        return std::move(*plan.cached);
+    return detail::finishCheck(plan, localVersion, options, [&] {
+        return http_get(plan.apiUrl, options.timeout, options.stopToken);
+    });
+}
+
+QTGH_DECL std::future<UpdateInfo> check_github_update_async(const QString& repoUrl,
+                                                            const QString& localVersion,
+                                                            const CheckOptions& options)
+{
+    auto promise = std::make_shared<std::promise<UpdateInfo>>();
+    auto future = promise->get_future();
+    detail::CheckPlan plan;
+    try {
+        plan = detail::planCheck(repoUrl, localVersion, options);
+    } catch (...) {
+        promise->set_exception(std::current_exception());
+        return future;
+    }
+    if (plan.cached) {
+        promise->set_value(*plan.cached);
+        return future;
+    }
+
+    const QString apiUrl = plan.apiUrl;
+    NetworkThread::instance().submit(
+        apiUrl, options.timeout, options.stopToken,
+        [promise, plan = std::move(plan), localVersion, options](std::exception_ptr error,
+                                                                 QByteArray body) {
+            try {
+                promise->set_value(detail::finishCheck(plan, localVersion, options, [&] {
+                    if (error)
+                        std::rethrow_exception(error);
+                    return body;
+                }));
+            } catch (...) {
+                promise->set_exception(std::current_exception());
+            }
+        });
+    return future;
+}
+
+} // namespace qtgh
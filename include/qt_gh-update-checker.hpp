@@ -8,10 +8,19 @@
 //
 // Features:
 // - Parse and compare semantic versions (major.minor.patch)
+// - Version, URL and release JSON handling from the Qt-free core
+//   (qt_gh-core.hpp), usable on its own with std::string_view
 // - Convert GitHub repository URLs to GitHub API endpoints
-// - Synchronous HTTP GET requests for GitHub API
+// - Synchronous HTTP GET requests for GitHub API, from any thread
+// - Library-owned network thread returning futures (NetworkThread)
 // - JSON parsing of GitHub release information
 // - Automatic update detection
+// - Optional thread-safe release cache (ReleaseCache), which also caches
+//   permanent-looking failures (404, 451, no or unparsable tag) with backoff
+// - Optional USDT tracepoints (qt_gh-probes.hpp, QTGH_ENABLE_USDT)
+// - Immediate failure while the host is offline (qt_gh-network-status.hpp)
+// - Header-only by default, or compiled once into a static/shared library
+//   (QTGH_COMPILED_LIBRARY, implementation in qt_gh-update-checker-impl.hpp)
 //
 // Usage:
 //   #include "qt_gh-update-checker.hpp"
@@ -23,15 +32,46 @@
 //   }
 
 #pragma once
+#include "qt_gh-core.hpp"
+#include "qt_gh-probes.hpp"
+#include <QByteArray>
 #include <QString>
-#include <QRegularExpression>
-#include <QNetworkAccessManager>
-#include <QNetworkReply>
-#include <QNetworkRequest>
-#include <QEventLoop>
-#include <QJsonDocument>
-#include <QJsonObject>
+#include <QStringView>
+#include <QDateTime>
+#include <QHash>
+#include <QReadWriteLock>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <future>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <stdexcept>
+#include <stop_token>
+#include <thread>
+
+QT_BEGIN_NAMESPACE
+class QEventLoop;
+class QNetworkAccessManager;
+class QNetworkReply;
+class QNetworkRequest;
+class QObject;
+QT_END_NAMESPACE
+
+// Functions marked QTGH_DECL are defined in qt_gh-update-checker-impl.hpp.
+// Header-only (the default) they are inline and that file is included at
+// the end of this header. Targets linking the compiled variant
+// (qt_gh_update_checker_static / _shared) get QTGH_COMPILED_LIBRARY: the
+// definitions are then compiled once into the library and this header no
+// longer parses QtNetwork, QJsonDocument or the implementation.
+#ifdef QTGH_COMPILED_LIBRARY
+#define QTGH_DECL
+#else
+#define QTGH_DECL inline
+#endif
 
 namespace qtgh {
 
@@ -52,26 +92,27 @@ struct SemVer {
     int patch = 0;  ///< Patch version number
 
     /// @brief Parse semantic version from string
-    /// @param v Version string (e.g., "1.2.3", "v1.2", "1")
+    /// @param v Version string (e.g., "1.2.3", "v1.2", "release-1.2.3")
     /// @return Parsed SemVer structure
     /// @throws std::runtime_error if the version string is invalid
+    ///
+    /// Takes the first "major.minor[.patch]" found in the string (ASCII
+    /// digits). Does not allocate unless it throws; numbers that do not
+    /// fit into an int are read as 0.
     /// @example
     ///   auto v = SemVer::parse("1.2.3");      // Works
     ///   auto v = SemVer::parse("v1.2");       // Works (patch defaults to 0)
     ///   auto v = SemVer::parse("invalid");    // Throws std::runtime_error
-    static SemVer parse(const QString& v) {
-        static QRegularExpression re(R"(v?(\d+)\.(\d+)(?:\.(\d+))?)");
-        auto m = re.match(v);
-        if (!m.hasMatch())
-            throw std::runtime_error(("Invalid SemVer: " + v).toStdString());
-
-        SemVer sv;
-        sv.major = m.captured(1).toInt();
-        sv.minor = m.captured(2).toInt();
-        sv.patch = m.captured(3).isEmpty() ? 0 : m.captured(3).toInt();
-        return sv;
+    static SemVer parse(QStringView v) {
+        if (const auto version = core::findVersion(
+                std::u16string_view(v.utf16(), static_cast<std::size_t>(v.size()))))
+            return {version->major, version->minor, version->patch};
+        throw std::runtime_error(("Invalid SemVer: " + v.toString()).toStdString());
     }
 
+    /// @brief Parse semantic version from string (see parse(QStringView))
+    static SemVer parse(const QString& v) { return parse(QStringView(v)); }
+
     /// @brief Three-way comparison operator
     /// Enables full comparison semantics: ==, <, >, <=, >=, !=
     auto operator<=>(const SemVer&) const = default;
@@ -80,71 +121,326 @@ struct SemVer {
 // ---------------------------------------------------------
 // GitHub URL Conversion
 // ---------------------------------------------------------
+/// @brief Default GitHub API base URL
+/// @return Value of the QTGH_API_BASE_URL environment variable if set,
+///   otherwise "https://api.github.com"
+///
+/// Setting QTGH_API_BASE_URL points every check at a caching proxy
+/// (see qt_gh-caching-proxy.hpp) without changing the calling code.
+inline QString defaultApiBaseUrl() {
+    static const QString base = [] {
+        QString env = qEnvironmentVariable("QTGH_API_BASE_URL");
+        while (env.endsWith('/'))
+            env.chop(1);
+        return env.isEmpty() ? QStringLiteral("https://api.github.com") : env;
+    }();
+    return base;
+}
+
 /// @brief Convert GitHub repository URL to GitHub API endpoint
 /// @param url Repository URL
 ///   - Web URL: https://github.com/owner/repo or https://github.com/owner/repo.git
 ///   - API URL: https://api.github.com/repos/owner/repo (returned as-is)
+/// @param apiBaseUrl API base URL without trailing slash
 /// @return GitHub API URL for accessing the latest release
 /// @throws std::runtime_error if the URL format is invalid
 /// @example
 ///   auto api = toGithubApiUrl("https://github.com/nlohmann/json");
 ///   // Returns: "https://api.github.com/repos/nlohmann/json/releases/latest"
-inline QString toGithubApiUrl(const QString& url) {
+inline QString toGithubApiUrl(const QString& url,
+                              const QString& apiBaseUrl = defaultApiBaseUrl()) {
     if (url.contains("api.github.com"))
         return url;
 
-    static QRegularExpression re(R"(https://github\.com/([^/]+)/([^/]+))");
-    auto m = re.match(url);
-    if (!m.hasMatch())
+    const QStringView u(url);
+    const auto span = core::findWebRepo(
+        std::u16string_view(u.utf16(), static_cast<std::size_t>(u.size())));
+    if (!span)
         throw std::runtime_error(("Invalid GitHub URL: " + url).toStdString());
 
-    QString owner = m.captured(1);
-    QString repo  = m.captured(2);
-
-    if (repo.endsWith(".git"))
-        repo.chop(4);
+    return QStringLiteral("%1/repos/%2/%3/releases/latest")
+        .arg(apiBaseUrl,
+             u.sliced(span->owner, span->ownerEnd - span->owner),
+             u.sliced(span->repo, span->repoEnd - span->repo));
+}
 
-    return QStringLiteral("https://api.github.com/repos/%1/%2/releases/latest")
-        .arg(owner, repo);
+/// @brief Normalize a GitHub repository URL to its "owner/repo" slug
+/// @param url Repository URL in any supported form
+///   - Web URL: https://github.com/owner/repo or https://github.com/owner/repo.git
+///   - SSH URL: git@github.com:owner/repo.git
+///   - API URL: https://api.github.com/repos/owner/repo/...
+/// @return Lower-case "owner/repo" slug, suitable as a map or dedup key
+/// @throws std::runtime_error if no owner/repo pair can be found
+/// @example
+///   auto slug = toRepoSlug("https://github.com/NLohmann/json.git");
+///   // Returns: "nlohmann/json"
+inline QString toRepoSlug(const QString& url) {
+    // core::findRepoSlug() scans the UTF-16 data in place, so the cache-hit
+    // path of check_github_update() allocates only the result.
+    const QStringView u(url);
+    if (const auto span = core::findRepoSlug(
+            std::u16string_view(u.utf16(), static_cast<std::size_t>(u.size())))) {
+        QString slug;
+        slug.reserve(static_cast<qsizetype>(span->ownerEnd - span->owner + 1 + span->repoEnd
+                                            - span->repo));
+        for (std::size_t k = span->owner; k < span->ownerEnd; ++k)
+            slug.append(u[k].toLower());
+        slug.append(u'/');
+        for (std::size_t k = span->repo; k < span->repoEnd; ++k)
+            slug.append(u[k].toLower());
+        return slug;
+    }
+    throw std::runtime_error(("Invalid GitHub URL: " + url).toStdString());
 }
 
 // ---------------------------------------------------------
 // HTTP Utilities
 // ---------------------------------------------------------
-/// @brief Perform synchronous HTTP GET request
+/// @brief Build the network request used for all GitHub API calls
 /// @param url Request URL
-/// @return Response body as QByteArray
-/// @throws std::runtime_error if the network request fails
+/// @return QNetworkRequest with the library's User-Agent header set
 ///
-/// This function performs a blocking HTTP GET request without requiring
-/// QObject inheritance. It uses QEventLoop internally for synchronous operation.
-/// The User-Agent header is set to "Qt-gh-update-checker".
+/// Shared by the synchronous http_get() and the asynchronous batch engine
+/// so both paths send identical requests.
+QTGH_DECL QNetworkRequest makeGithubRequest(const QString& url);
+
+// ---------------------------------------------------------
+// Check Failures
+// ---------------------------------------------------------
+/// @brief Failures that repeat on every check until the repository changes
 ///
-/// @warning This blocks the current thread until the response is received.
-/// Use asynchronous networking for GUI applications.
-inline QByteArray http_get(const QString& url) {
-    QNetworkAccessManager mgr;
-    QNetworkRequest req{QUrl(url)};
-    req.setHeader(QNetworkRequest::UserAgentHeader, "Qt-gh-update-checker");
+/// These are cached by ReleaseCache (negative caching), so archived,
+/// deleted or release-less repositories do not cost a request per sweep.
+enum class FailureKind {
+    NotFound,       ///< 404/410: repository gone, private or without releases
+    NoRelease,      ///< Response without a tag_name (e.g. an API error message)
+    UnparsableTag,  ///< The latest release tag is not a version
+    Unavailable     ///< 451: repository blocked for legal reasons
+};
 
-    QEventLoop loop;
-    QObject::connect(&mgr, &QNetworkAccessManager::finished,
-                     &loop, &QEventLoop::quit);
+/// @brief Stable name of a failure kind ("not_found", "no_release", ...)
+inline QString failureKindName(FailureKind kind) {
+    switch (kind) {
+    case FailureKind::NotFound:      return QStringLiteral("not_found");
+    case FailureKind::NoRelease:     return QStringLiteral("no_release");
+    case FailureKind::UnparsableTag: return QStringLiteral("unparsable_tag");
+    case FailureKind::Unavailable:   return QStringLiteral("unavailable");
+    }
+    return {};
+}
 
-    QNetworkReply* reply = mgr.get(req);
-    loop.exec();
+/// @brief Inverse of failureKindName()
+inline std::optional<FailureKind> failureKindFromName(QStringView name) {
+    for (auto kind : {FailureKind::NotFound, FailureKind::NoRelease,
+                      FailureKind::UnparsableTag, FailureKind::Unavailable})
+        if (name == failureKindName(kind))
+            return kind;
+    return std::nullopt;
+}
 
-    if (reply->error() != QNetworkReply::NoError) {
-        auto msg = reply->errorString();
-        reply->deleteLater();
-        throw std::runtime_error(("Network error: " + msg).toStdString());
+/// @brief Failure kind of an HTTP status worth caching, if any
+inline std::optional<FailureKind> failureKindForStatus(int httpStatus) {
+    switch (httpStatus) {
+    case 404:
+    case 410: return FailureKind::NotFound;
+    case 451: return FailureKind::Unavailable;
+    default:  return std::nullopt;
     }
-
-    QByteArray data = reply->readAll();
-    reply->deleteLater();
-    return data;
 }
 
+/// @brief A cached check failure (see ReleaseCache::recordFailure())
+struct FailureRecord {
+    FailureKind kind = FailureKind::NotFound;
+    QString error;          ///< Message of the failed check
+    int failures = 0;       ///< Consecutive failures of the repository
+    QDateTime failedAt;     ///< Time of the last failure (UTC)
+    QDateTime retryAt;      ///< Served from the cache until then (UTC)
+};
+
+/// @brief Thrown for failures that are cached (see FailureKind)
+///
+/// The message is the same whether the failure was just observed or
+/// served from the ReleaseCache; fromCache() tells them apart.
+class CheckFailure : public std::runtime_error {
+public:
+    CheckFailure(FailureKind kind, const std::string& message)
+        : std::runtime_error(message), m_kind(kind) {}
+
+    /// @brief Rethrow a cached failure
+    explicit CheckFailure(const FailureRecord& record)
+        : std::runtime_error(record.error.toStdString()), m_kind(record.kind), m_cached(true),
+          m_retryAt(record.retryAt) {}
+
+    FailureKind kind() const { return m_kind; }
+    bool fromCache() const { return m_cached; }
+
+    /// @brief When the repository is checked again (invalid unless fromCache())
+    QDateTime retryAt() const { return m_retryAt; }
+
+private:
+    FailureKind m_kind;
+    bool m_cached = false;
+    QDateTime m_retryAt;
+};
+
+/// @brief Thrown without a request while the host is known to be offline
+///
+/// See NetworkStatus and CheckOptions::offlineFastFail.
+class OfflineError : public std::runtime_error {
+public:
+    OfflineError() : std::runtime_error("Network error: host is offline") {}
+};
+
+// ---------------------------------------------------------
+// Cancellation
+// ---------------------------------------------------------
+/// @brief Thrown when a check is cancelled through its std::stop_token
+class CancelledError : public std::runtime_error {
+public:
+    CancelledError() : std::runtime_error("Cancelled") {}
+};
+
+namespace detail {
+
+/// @brief Abort a QNetworkReply when a stop is requested
+///
+/// request_stop() may be called from any thread: the abort runs directly
+/// on the reply's thread and is posted to it from elsewhere. Destroy the
+/// guard before the reply; its destructor waits for a callback that is
+/// running concurrently.
+class AbortOnStop {
+public:
+    AbortOnStop(QNetworkReply* reply, std::stop_token token)
+        : m_token(std::move(token)), m_callback(m_token, Abort{reply}) {}
+
+    AbortOnStop(const AbortOnStop&) = delete;
+    AbortOnStop& operator=(const AbortOnStop&) = delete;
+
+    /// @brief Whether the abort was caused by a stop request
+    bool stopRequested() const { return m_token.stop_requested(); }
+
+private:
+    struct Abort {
+        QNetworkReply* reply;
+        QTGH_DECL void operator()() const;
+    };
+    std::stop_token m_token;
+    std::stop_callback<Abort> m_callback;
+};
+
+} // namespace detail
+
+// ---------------------------------------------------------
+// Network Thread
+// ---------------------------------------------------------
+/// @brief Library-owned I/O thread with one long-lived QNetworkAccessManager
+///
+/// Started on first use. Requests can be submitted from any thread,
+/// including plain std::thread workers of programs without a Qt event
+/// loop; they run on the network thread and complete a std::future, so
+/// callers only ever block on the future and never spin an event loop.
+/// All requests share the manager's connection pool (keep-alive, TLS
+/// sessions).
+///
+/// If the process has no QCoreApplication when the thread starts, the
+/// thread creates its own; create yours (if any) before the first check.
+/// The thread is stopped by shutdown(), at process exit, or when an
+/// application object that is not its own is destroyed. It restarts on
+/// the next submission unless it owned the application object.
+///
+/// @example
+///   auto body = qtgh::NetworkThread::instance().get(apiUrl);
+///   ... other work ...
+///   QByteArray json = body.get();    // rethrows request errors
+class NetworkThread {
+public:
+    /// @brief Receives the body or the error; runs on the network thread and must not block
+    using Completion = std::function<void(std::exception_ptr error, QByteArray body)>;
+
+    /// @brief The process-wide network thread (not started until the first request)
+    QTGH_DECL static NetworkThread& instance();
+
+    NetworkThread(const NetworkThread&) = delete;
+    NetworkThread& operator=(const NetworkThread&) = delete;
+
+    QTGH_DECL ~NetworkThread();
+
+    /// @brief GET `url` on the network thread
+    /// @return Future holding the body, or the exception http_get() would throw
+    std::future<QByteArray> get(const QString& url,
+                                std::chrono::milliseconds timeout = std::chrono::milliseconds(0),
+                                std::stop_token stop = {}) {
+        auto promise = std::make_shared<std::promise<QByteArray>>();
+        auto future = promise->get_future();
+        submit(url, timeout, std::move(stop), [promise](std::exception_ptr error, QByteArray body) {
+            if (error)
+                promise->set_exception(std::move(error));
+            else
+                promise->set_value(std::move(body));
+        });
+        return future;
+    }
+
+    /// @brief GET `url` on the network thread and pass the outcome to `done`
+    ///
+    /// Thread-safe. A stop requested through `stop` aborts the request and
+    /// completes it with CancelledError. If the thread cannot be restarted
+    /// after shutdown(), `done` is called at once on the calling thread.
+    QTGH_DECL void submit(const QString& url, std::chrono::milliseconds timeout,
+                          std::stop_token stop, Completion done);
+
+    /// @brief Whether the calling thread is the network thread
+    bool isCurrentThread() const {
+        return m_threadId.load(std::memory_order_acquire) == std::this_thread::get_id();
+    }
+
+    /// @brief Stop the thread; requests still running fail with a network error
+    ///
+    /// Must not be called from a Completion.
+    QTGH_DECL void shutdown();
+
+private:
+    NetworkThread() = default;
+
+    /// Start the thread and wait until it accepts submissions (m_lock held)
+    QTGH_DECL bool ensureRunning();
+    QTGH_DECL void run(std::promise<void>& ready);
+    QTGH_DECL void startRequest(const QString& url, std::chrono::milliseconds timeout,
+                                std::stop_token stop, Completion done);
+
+    std::mutex m_lock;                      ///< Serializes start, submit and shutdown
+    std::thread m_thread;
+    std::atomic<std::thread::id> m_threadId;
+    bool m_ownedApp = false;                ///< The thread created the QCoreApplication
+    // Owned by run() on the network thread
+    QObject* m_context = nullptr;
+    QNetworkAccessManager* m_mgr = nullptr;
+    QEventLoop* m_loop = nullptr;
+    bool m_stopping = false;
+};
+
+/// @brief Perform synchronous HTTP GET request
+/// @param url Request URL
+/// @param timeout Abort if no data arrives for this long (0 = no timeout)
+/// @param stop Aborts the request when a stop is requested (from any thread)
+/// @return Response body as QByteArray
+/// @throws CancelledError if a stop was requested
+/// @throws CheckFailure for 404, 410 and 451 responses
+/// @throws std::runtime_error if the network request fails or times out
+///
+/// This function performs a blocking HTTP GET request without requiring
+/// QObject inheritance. On the application's thread it runs a local
+/// QEventLoop; from any other thread, and in programs without a
+/// QCoreApplication, the request runs on the NetworkThread and the caller
+/// waits for its future without an event loop.
+/// The User-Agent header is set to "Qt-gh-update-checker".
+///
+/// @warning This blocks the current thread until the response is received
+/// or `stop` is triggered. Use asynchronous networking for GUI applications.
+QTGH_DECL QByteArray http_get(const QString& url,
+                              std::chrono::milliseconds timeout = std::chrono::milliseconds(0),
+                              std::stop_token stop = {});
+
 // ---------------------------------------------------------
 // Update Information
 // ---------------------------------------------------------
@@ -155,6 +451,262 @@ inline QByteArray http_get(const QString& url) {
 struct UpdateInfo {
     bool hasUpdate;           ///< True if a newer version is available
     QString latestVersion;    ///< Latest version tag from GitHub releases
+    QDateTime publishedAt;    ///< Release publication time (invalid if not reported)
+};
+
+// ---------------------------------------------------------
+// Release Evaluation
+// ---------------------------------------------------------
+/// @brief The fields of a GitHub release the update check relies on
+///
+/// Produced by parseRelease() and stored in the ReleaseCache.
+struct ReleaseRecord {
+    QString tag;              ///< Release tag_name
+    QDateTime publishedAt;    ///< Release published_at (invalid if not reported)
+    QDateTime fetchedAt;      ///< When the record was obtained (UTC)
+    QDateTime expiresAt;      ///< When a cached copy stops being served (UTC)
+};
+
+/// @brief Parse a "latest release" API response
+/// @param data Raw response body of /repos/{owner}/{repo}/releases/latest
+/// @return ReleaseRecord with tag and publication time (cache times unset)
+/// @throws CheckFailure (NoRelease) if the object has no tag_name; the
+///   API's "message" is included when present
+/// @throws std::runtime_error if the response is not a JSON object
+inline ReleaseRecord parseRelease(const QByteArray& data) {
+    QTGH_PROBE1(parse_start, static_cast<long long>(data.size()));
+    const auto fields = core::extractRelease(
+        std::string_view(data.constData(), static_cast<std::size_t>(data.size())));
+    QTGH_PROBE1(parse_done, fields ? 1 : 0);
+    if (!fields)
+        throw std::runtime_error("GitHub API returned non-object JSON");
+
+    if (!fields->tag) {
+        if (fields->message) {
+            throw CheckFailure(FailureKind::NoRelease, "GitHub API error: " + *fields->message);
+        }
+        throw CheckFailure(FailureKind::NoRelease, "GitHub API returned no valid tag_name");
+    }
+
+    ReleaseRecord rec;
+    rec.tag = QString::fromStdString(*fields->tag);
+    if (fields->publishedAt)
+        rec.publishedAt = QDateTime::fromString(QString::fromStdString(*fields->publishedAt),
+                                                Qt::ISODate);
+    return rec;
+}
+
+/// @brief Compare a release against a local version
+/// @param release Latest release (fresh or cached)
+/// @param localVersion Current version string (e.g., "1.0.0")
+/// @return UpdateInfo with latest version and update status
+/// @throws CheckFailure (UnparsableTag) if the release tag is not a version
+/// @throws std::runtime_error if the local version cannot be parsed
+inline UpdateInfo compareRelease(const ReleaseRecord& release,
+                                 const QString& localVersion)
+{
+    QTGH_PROBE(compare_start);
+    SemVer local  = SemVer::parse(localVersion);
+    SemVer remote;
+    try {
+        remote = SemVer::parse(release.tag);
+    } catch (const std::runtime_error& e) {
+        throw CheckFailure(FailureKind::UnparsableTag, e.what());
+    }
+    const bool hasUpdate = remote > local;
+    QTGH_PROBE1(compare_done, hasUpdate ? 1 : 0);
+
+    return { hasUpdate, release.tag, release.publishedAt };
+}
+
+/// @brief Evaluate a "latest release" API response against a local version
+/// @param data Raw response body of /repos/{owner}/{repo}/releases/latest
+/// @param localVersion Current version string (e.g., "1.0.0")
+/// @return UpdateInfo with latest version and update status
+/// @throws std::runtime_error if the response is invalid or a version
+///   string cannot be parsed
+///
+/// This is the network-independent part of check_github_update(). It is
+/// shared with the asynchronous batch engine, which obtains the response
+/// body itself.
+inline UpdateInfo evaluateRelease(const QByteArray& data,
+                                  const QString& localVersion)
+{
+    return compareRelease(parseRelease(data), localVersion);
+}
+
+// ---------------------------------------------------------
+// Result Cache
+// ---------------------------------------------------------
+/// @brief How long a cached failure is served before the next attempt
+///
+/// The n-th consecutive failure of a repository is cached for
+/// base(kind) * factor^(n-1), at most maxDelay. Any successful check or
+/// pushed release clears the failure.
+struct FailureBackoff {
+    bool enabled = true;
+    std::chrono::seconds notFound{std::chrono::hours(6)};
+    std::chrono::seconds noRelease{std::chrono::hours(1)};
+    std::chrono::seconds unparsableTag{std::chrono::hours(12)};
+    std::chrono::seconds unavailable{std::chrono::hours(24)};
+    double factor = 2.0;
+    std::chrono::seconds maxDelay{std::chrono::days(30)};
+
+    /// @brief Caching time of the `failures`-th consecutive failure
+    std::chrono::seconds delay(FailureKind kind, int failures) const {
+        std::chrono::seconds base = notFound;
+        switch (kind) {
+        case FailureKind::NotFound:      base = notFound; break;
+        case FailureKind::NoRelease:     base = noRelease; break;
+        case FailureKind::UnparsableTag: base = unparsableTag; break;
+        case FailureKind::Unavailable:   base = unavailable; break;
+        }
+        const double scaled = static_cast<double>(base.count())
+                              * std::pow(std::max(1.0, factor), std::max(0, failures - 1));
+        return std::chrono::seconds(static_cast<qint64>(
+            std::min(scaled, static_cast<double>(maxDelay.count()))));
+    }
+};
+
+/// @brief Thread-safe cache of the latest release per repository
+///
+/// Keyed by toRepoSlug(). Entries are filled by update checks (valid for
+/// CheckOptions::maxAge) and can be pushed by the webhook receiver, which
+/// makes polling for those repositories unnecessary until they expire.
+///
+/// Failures that repeat until the repository changes (see FailureKind) are
+/// cached too, with exponential backoff per repository (FailureBackoff),
+/// and rethrown as CheckFailure without a request until they expire.
+///
+/// @example
+///   qtgh::ReleaseCache cache;
+///   qtgh::CheckOptions opts;
+///   opts.cache = &cache;
+///   auto a = qtgh::check_github_update(url, "1.0.0", opts);  // network
+///   auto b = qtgh::check_github_update(url, "1.0.0", opts);  // cache hit
+class ReleaseCache {
+public:
+    /// @brief Return the cached release if it has not expired
+    /// @param slug Repository slug ("owner/repo")
+    /// @param now Reference time (UTC)
+    std::optional<ReleaseRecord> lookup(const QString& slug,
+                                        const QDateTime& now = QDateTime::currentDateTimeUtc()) const {
+        QReadLocker lock(&m_lock);
+        auto it = m_entries.constFind(slug);
+        if (it == m_entries.cend() || it->expiresAt <= now)
+            return std::nullopt;
+        return *it;
+    }
+
+    /// @brief Insert or replace the release of a repository
+    ///
+    /// Clears a cached failure of the repository.
+    void store(const QString& slug, const ReleaseRecord& release) {
+        QWriteLocker lock(&m_lock);
+        m_entries.insert(slug, release);
+        m_failures.remove(slug);
+    }
+
+    /// @brief Drop the cached release and failure of a repository
+    void invalidate(const QString& slug) {
+        QWriteLocker lock(&m_lock);
+        m_entries.remove(slug);
+        m_failures.remove(slug);
+    }
+
+    /// @brief Drop all cached releases and failures
+    void clear() {
+        QWriteLocker lock(&m_lock);
+        m_entries.clear();
+        m_failures.clear();
+    }
+
+    /// @brief Number of cached repositories (including expired entries)
+    qsizetype size() const {
+        QReadLocker lock(&m_lock);
+        return m_entries.size();
+    }
+
+    // --- negative caching -------------------------------------------------
+
+    /// @brief Set the backoff of cached failures (enabled by default)
+    void setFailureBackoff(const FailureBackoff& backoff) {
+        QWriteLocker lock(&m_lock);
+        m_backoff = backoff;
+    }
+
+    FailureBackoff failureBackoff() const {
+        QReadLocker lock(&m_lock);
+        return m_backoff;
+    }
+
+    /// @brief Return the cached failure if it is still to be served
+    /// @param slug Repository slug ("owner/repo")
+    /// @param now Reference time (UTC)
+    std::optional<FailureRecord> lookupFailure(const QString& slug,
+                                               const QDateTime& now = QDateTime::currentDateTimeUtc()) const {
+        QReadLocker lock(&m_lock);
+        auto it = m_failures.constFind(slug);
+        if (it == m_failures.cend() || it->retryAt <= now)
+            return std::nullopt;
+        return *it;
+    }
+
+    /// @brief Record a failed check and back off the repository
+    /// @return The cached record (failures counts consecutive failures);
+    ///   nothing is cached if the backoff is disabled
+    ///
+    /// Replaces a cached release of the repository, which is outdated now.
+    FailureRecord recordFailure(const QString& slug, FailureKind kind, const QString& error,
+                                const QDateTime& now = QDateTime::currentDateTimeUtc()) {
+        QWriteLocker lock(&m_lock);
+        FailureRecord record{kind, error, m_failures.value(slug).failures + 1, now, now};
+        if (!m_backoff.enabled)
+            return record;
+        record.retryAt = now.addSecs(m_backoff.delay(kind, record.failures).count());
+        m_entries.remove(slug);
+        m_failures.insert(slug, record);
+        return record;
+    }
+
+    /// @brief Insert or replace a failure as is (e.g. loaded from disk)
+    void storeFailure(const QString& slug, const FailureRecord& record) {
+        QWriteLocker lock(&m_lock);
+        m_failures.insert(slug, record);
+    }
+
+    /// @brief Number of repositories with a cached failure (including expired)
+    qsizetype failureCount() const {
+        QReadLocker lock(&m_lock);
+        return m_failures.size();
+    }
+
+    /// @brief Write the cached failures to a JSON file (atomically)
+    /// @return false with `error` set if the file cannot be written
+    ///
+    /// Only failures are persisted: they stay valid for hours or days and
+    /// let the next sweep skip repositories that are known to fail.
+    QTGH_DECL bool saveFailures(const QString& path, QString* error = nullptr) const;
+
+    /// @brief Load failures written by saveFailures(); a missing file is empty
+    /// @return false with `error` set if the file cannot be read or parsed
+    QTGH_DECL bool loadFailures(const QString& path, QString* error = nullptr);
+
+private:
+    mutable QReadWriteLock m_lock;
+    QHash<QString, ReleaseRecord> m_entries;
+    QHash<QString, FailureRecord> m_failures;
+    FailureBackoff m_backoff;
+};
+
+/// @brief Optional settings for check_github_update() and the batch engine
+struct CheckOptions {
+    ReleaseCache* cache = nullptr;                          ///< Result cache (not owned)
+    std::chrono::seconds maxAge = std::chrono::minutes(10); ///< Lifetime of polled cache entries
+    QString apiBaseUrl = defaultApiBaseUrl();               ///< GitHub API or caching proxy
+    std::chrono::milliseconds timeout{0};                   ///< Per-request transfer timeout (0 = none)
+    std::stop_token stopToken;                              ///< Cancels pending checks when stopped
+    bool offlineFastFail = true;                            ///< Fail at once while offline (NetworkStatus)
 };
 
 // ---------------------------------------------------------
@@ -163,7 +715,15 @@ struct UpdateInfo {
 /// @brief Check for updates on a GitHub repository
 /// @param repoUrl GitHub repository URL (https://github.com/owner/repo)
 /// @param localVersion Current version string (e.g., "1.0.0")
+/// @param options Optional settings, e.g. a ReleaseCache to consult first
 /// @return UpdateInfo with latest version and update status
+/// @throws CancelledError if options.stopToken is stopped before the
+///   response arrived (the request is aborted immediately)
+/// @throws OfflineError if the host is known to be offline and the
+///   ReleaseCache cannot answer (unless options.offlineFastFail is off)
+/// @throws CheckFailure if the repository is not found or unavailable or
+///   has no usable release; with a ReleaseCache the failure is cached and
+///   rethrown without a request until it expires (CheckFailure::fromCache())
 /// @throws std::runtime_error if:
 ///   - The repository URL is invalid
 ///   - The version strings cannot be parsed
@@ -186,33 +746,32 @@ struct UpdateInfo {
 ///   } catch (const std::exception& e) {
 ///       std::cerr << "Error: " << e.what();
 ///   }
-inline UpdateInfo check_github_update(const QString& repoUrl,
-                                      const QString& localVersion)
-{
-    QString apiUrl = toGithubApiUrl(repoUrl);
+QTGH_DECL UpdateInfo check_github_update(const QString& repoUrl,
+                                         const QString& localVersion,
+                                         const CheckOptions& options = {});
 
-    QByteArray data = http_get(apiUrl);
-    auto doc = QJsonDocument::fromJson(data);
-    if (!doc.isObject())
-        throw std::runtime_error("GitHub API returned non-object JSON");
-
-    auto obj = doc.object();
-
-    if (!obj.contains("tag_name") || !obj["tag_name"].isString()) {
-        if (obj.contains("message") && obj["message"].isString()) {
-            throw std::runtime_error(
-                ("GitHub API error: " + obj["message"].toString()).toStdString()
-            );
-        }
-        throw std::runtime_error("GitHub API returned no valid tag_name");
-    }
-
-    QString latest = obj["tag_name"].toString();
-
-    SemVer local  = SemVer::parse(localVersion);
-    SemVer remote = SemVer::parse(latest);
-
-    return { remote > local, latest };
-}
+/// @brief Check for updates without blocking the calling thread
+/// @return Future holding the UpdateInfo, or the exception
+///   check_github_update() would throw
+///
+/// Callable from any thread, with or without a Qt event loop. Cache hits,
+/// cached failures and offline checks complete the future at once;
+/// otherwise the request runs on the NetworkThread, which also parses
+/// the response and updates options.cache before completing the future.
+/// options.cache must outlive the future.
+///
+/// @example
+///   std::vector<std::future<qtgh::UpdateInfo>> checks;
+///   for (const auto& repo : repos)
+///       checks.push_back(qtgh::check_github_update_async(repo, "1.0.0"));
+///   for (auto& check : checks)
+///       report(check.get());
+QTGH_DECL std::future<UpdateInfo> check_github_update_async(const QString& repoUrl,
+                                                            const QString& localVersion,
+                                                            const CheckOptions& options = {});
 
 } // namespace qtgh
+
+#ifndef QTGH_COMPILED_LIBRARY
+#include "qt_gh-update-checker-impl.hpp"
+#endif
@@ -0,0 +1,174 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: 2026 Zheng-Bote
+//
+// qt_gh-webhook-receiver.hpp - GitHub release webhook receiver
+//
+// Embedded HTTP endpoint that accepts GitHub "release" webhook deliveries,
+// verifies their HMAC-SHA256 signature and writes the new release straight
+// into a ReleaseCache. Repositories that deliver webhooks no longer need
+// to be polled; a long push TTL keeps polling as a slow safety net.
+//
+// Usage:
+//   #include "qt_gh-webhook-receiver.hpp"
+//   qtgh::ReleaseCache cache;
+//   qtgh::WebhookReceiver receiver(cache, "webhook-secret");
+//   receiver.listen(QHostAddress::Any, 8080);
+//   // GitHub: Payload URL http(s)://host:8080/webhook, content type
+//   // application/json, events: "Releases"
+
+#pragma once
+#include "qt_gh-http-server.hpp"
+#include "qt_gh-update-checker.hpp"
+#include <QCryptographicHash>
+#include <QJsonDocument>
+#include <QMessageAuthenticationCode>
+
+namespace qtgh {
+
+// ---------------------------------------------------------
+// WebhookReceiver
+// ---------------------------------------------------------
+/// @brief Receives GitHub release webhooks and updates a ReleaseCache
+///
+/// Accepted deliveries (POST to path(), valid X-Hub-Signature-256):
+/// - release published/released/edited (not draft or prerelease): the
+///   release is stored in the cache with expiresAt = now + pushTtl()
+/// - release deleted/unpublished: the cache entry is invalidated so the
+///   next check polls again
+/// - ping: answered with 200
+///
+/// Other events and actions are acknowledged with 202 and ignored.
+/// Deliveries with a missing or wrong signature are rejected with 401.
+///
+/// @example
+///   qtgh::ReleaseCache cache;
+///   qtgh::WebhookReceiver receiver(cache, qgetenv("WEBHOOK_SECRET"));
+///   receiver.setReleaseHandler([&](const QString& slug, const qtgh::ReleaseRecord& r) {
+///       scheduler.recordCheck(slug, r.tag, now(), fromQDateTime(r.publishedAt));
+///   });
+///   receiver.listen(QHostAddress::Any, 8080);
+class WebhookReceiver {
+public:
+    using ReleaseHandler = std::function<void(const QString& slug, const ReleaseRecord& release)>;
+
+    /// @brief Create a receiver
+    /// @param cache Cache updated by accepted deliveries (must outlive the receiver)
+    /// @param secret Webhook secret configured on GitHub
+    /// @throws std::runtime_error if the secret is empty
+    WebhookReceiver(ReleaseCache& cache, QByteArray secret)
+        : m_cache(cache),
+          m_secret(std::move(secret)),
+          m_server([this](const HttpRequest& req, HttpServer::Responder respond) {
+              respond(handle(req));
+          })
+    {
+        if (m_secret.isEmpty())
+            throw std::runtime_error("Webhook secret must not be empty");
+        // GitHub caps webhook payloads at 25 MB
+        m_server.setMaxBodySize(25 * 1024 * 1024);
+    }
+
+    /// @brief Start listening (see HttpServer::listen())
+    bool listen(const QHostAddress& address = QHostAddress::LocalHost, quint16 port = 0) {
+        return m_server.listen(address, port);
+    }
+
+    quint16 serverPort() const { return m_server.serverPort(); }
+    QString errorString() const { return m_server.errorString(); }
+
+    /// @brief Request path deliveries are accepted on (default "/webhook")
+    void setPath(const QByteArray& path) { m_path = path; }
+    QByteArray path() const { return m_path; }
+
+    /// @brief Lifetime of pushed cache entries (default 24 h)
+    ///
+    /// After this time the repository is polled again, which covers missed
+    /// deliveries.
+    void setPushTtl(std::chrono::seconds ttl) { m_pushTtl = ttl; }
+    std::chrono::seconds pushTtl() const { return m_pushTtl; }
+
+    /// @brief Callback invoked after a pushed release was stored
+    void setReleaseHandler(ReleaseHandler handler) { m_onRelease = std::move(handler); }
+
+    /// @brief Verify a GitHub X-Hub-Signature-256 header value
+    /// @param body Raw request body
+    /// @param signature Header value ("sha256=<hex digest>")
+    /// @param secret Webhook secret
+    /// @return true if the signature matches
+    static bool verifySignature(const QByteArray& body, const QByteArray& signature,
+                                const QByteArray& secret) {
+        if (!signature.startsWith("sha256="))
+            return false;
+        const QByteArray expected = QMessageAuthenticationCode::hash(
+            body, secret, QCryptographicHash::Sha256).toHex();
+        const QByteArray actual = signature.mid(7).toLower();
+        if (actual.size() != expected.size())
+            return false;
+        // Constant-time comparison
+        char diff = 0;
+        for (qsizetype i = 0; i < expected.size(); ++i)
+            diff |= static_cast<char>(expected.at(i) ^ actual.at(i));
+        return diff == 0;
+    }
+
+private:
+    HttpResponse handle(const HttpRequest& req) {
+        if (req.path != m_path)
+            return {404, "text/plain", {}, "Not found\n"};
+        if (req.method != "POST")
+            return {405, "text/plain", {{"Allow", "POST"}}, "Method not allowed\n"};
+        if (!verifySignature(req.body, req.header("x-hub-signature-256"), m_secret))
+            return {401, "text/plain", {}, "Invalid signature\n"};
+
+        const QByteArray event = req.header("x-github-event");
+        if (event == "ping")
+            return {200, "text/plain", {}, "pong\n"};
+        if (event != "release")
+            return {202, "text/plain", {}, "Event ignored\n"};
+
+        const auto doc = QJsonDocument::fromJson(req.body);
+        const auto payload = doc.object();
+        const auto release = payload["release"].toObject();
+        const QString fullName = payload["repository"].toObject()["full_name"].toString();
+        if (!doc.isObject() || fullName.isEmpty() || !release["tag_name"].isString())
+            return {400, "text/plain", {}, "Malformed release payload\n"};
+
+        const QString slug = fullName.toLower();
+        const QString action = payload["action"].toString();
+
+        if (action == "deleted" || action == "unpublished") {
+            m_cache.invalidate(slug);
+            return {204, {}, {}, {}};
+        }
+        if ((action != "published" && action != "released" && action != "edited")
+            || release["draft"].toBool() || release["prerelease"].toBool())
+            return {202, "text/plain", {}, "Action ignored\n"};
+
+        ReleaseRecord record;
+        record.tag = release["tag_name"].toString();
+        record.publishedAt = QDateTime::fromString(release["published_at"].toString(), Qt::ISODate);
+        record.fetchedAt = QDateTime::currentDateTimeUtc();
+        record.expiresAt = record.fetchedAt.addSecs(m_pushTtl.count());
+
+        // An "edited" event for an older release must not replace a newer one
+        if (auto cached = m_cache.lookup(slug)) {
+            if (cached->publishedAt.isValid() && record.publishedAt.isValid()
+                && record.publishedAt < cached->publishedAt)
+                return {202, "text/plain", {}, "Older release ignored\n"};
+        }
+
+        m_cache.store(slug, record);
+        if (m_onRelease)
+            m_onRelease(slug, record);
+        return {204, {}, {}, {}};
+    }
+
+    ReleaseCache& m_cache;
+    QByteArray m_secret;
+    QByteArray m_path = "/webhook";
+    std::chrono::seconds m_pushTtl = std::chrono::hours(24);
+    ReleaseHandler m_onRelease;
+    HttpServer m_server;
+};
+
+} // namespace qtgh
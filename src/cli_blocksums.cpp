@@ -0,0 +1,67 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: 2026 Zheng-Bote
+//
+// cli_blocksums.cpp - "blocksums" sub-command
+//
+// Writes the block manifest of a release asset, to be published next to it
+// so clients can update with "delta" (see qt_gh-block-manifest.hpp).
+//
+// Usage:
+//   qt_gh-update-checker blocksums [--block-size BYTES] [--threads N] [--output FILE] <asset>
+//
+// The manifest is written to "<asset>.blocksums" unless --output is given.
+
+#include <QSaveFile>
+#include "cli_commands.hpp"
+#include "qt_gh-block-manifest.hpp"
+
+namespace cli {
+
+int run_blocksums(const QStringList& args) {
+    int blockSize = qtgh::BlockManifest::kDefaultBlockSize;
+    unsigned threads = 0;
+    QString output;
+    QString asset;
+
+    for (qsizetype i = 0; i < args.size(); ++i) {
+        const QString& arg = args.at(i);
+        if (arg == "--block-size" && i + 1 < args.size()) {
+            blockSize = args.at(++i).toInt();
+        } else if (arg == "--threads" && i + 1 < args.size()) {
+            threads = args.at(++i).toUInt();
+        } else if (arg == "--output" && i + 1 < args.size()) {
+            output = args.at(++i);
+        } else if (asset.isEmpty() && !arg.startsWith("--")) {
+            asset = arg;
+        } else {
+            asset.clear();
+            break;
+        }
+    }
+    if (asset.isEmpty() || blockSize <= 0) {
+        std::cerr << "Usage: qt_gh-update-checker blocksums [--block-size BYTES] [--threads N] "
+                     "[--output FILE] <asset>\n";
+        return 1;
+    }
+    if (output.isEmpty())
+        output = asset + ".blocksums";
+
+    try {
+        const auto manifest = qtgh::buildBlockManifest(asset, blockSize, threads);
+        QSaveFile file(output);
+        if (!file.open(QIODevice::WriteOnly) || file.write(manifest.toCbor()) < 0 || !file.commit()) {
+            std::cerr << "Error: cannot write " << output.toStdString() << ": "
+                      << file.errorString().toStdString() << "\n";
+            return 3;
+        }
+        std::cerr << output.toStdString() << ": " << manifest.blockCount() << " blocks of "
+                  << manifest.blockSize << " bytes\n";
+        return 0;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 3;
+    }
+}
+
+} // namespace cli
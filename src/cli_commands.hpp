@@ -0,0 +1,135 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: 2026 Zheng-Bote
+//
+// cli_commands.hpp - Sub-commands of the qt_gh-update-checker CLI
+//
+// Each sub-command lives in its own translation unit and receives the
+// arguments following the sub-command name. The return value is used as
+// the process exit code.
+
+#pragma once
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QStringList>
+#include <iostream>
+#include "qt_gh-batch-checker.hpp"
+#include "qt_gh-result-cbor.hpp"
+
+namespace cli {
+
+/// @brief Scan a source tree for GitHub dependencies and check them
+/// @param args Arguments after "scan"
+/// @return 0=no update, 1=invalid arguments, 2=update available, 3=error,
+///   4=deadline reached before all checks finished (and no update found)
+int run_scan(const QStringList& args);
+
+/// @brief Merge per-shard NDJSON result files into one
+/// @param args Arguments after "merge"
+/// @return 0=no update, 1=invalid arguments, 2=update available, 3=error
+int run_merge(const QStringList& args);
+
+/// @brief Run the subscription service until terminated
+/// @param args Arguments after "serve"
+/// @return 1=invalid arguments, 3=error
+int run_serve(const QStringList& args);
+
+/// @brief Subscribe to repositories and print pushed messages
+/// @param args Arguments after "subscribe"
+/// @return 1=invalid arguments, 3=connection error or lost
+int run_subscribe(const QStringList& args);
+
+/// @brief Run the caching releases API proxy until terminated
+/// @param args Arguments after "proxy"
+/// @return 1=invalid arguments, 3=error
+int run_proxy(const QStringList& args);
+
+/// @brief Write the block manifest of a release asset
+/// @param args Arguments after "blocksums"
+/// @return 0=written, 1=invalid arguments, 3=error
+int run_blocksums(const QStringList& args);
+
+/// @brief Update an installed asset by downloading only changed blocks
+/// @param args Arguments after "delta"
+/// @return 0=updated, 1=invalid arguments, 3=error (the file is unchanged)
+int run_delta(const QStringList& args);
+
+/// @brief How "scan" and "merge" write results
+enum class OutputFormat {
+    Text,   ///< One human-readable line per result
+    Json,   ///< NDJSON: one single-line JSON object per result (--json)
+    Cbor    ///< CBOR sequence: one map per result (--cbor, see qt_gh-result-cbor.hpp)
+};
+
+/// @brief Encode one batch result as a text line, an NDJSON record or a CBOR map
+inline QByteArray encode_batch_result(const qtgh::BatchResult& result, OutputFormat format) {
+    if (format == OutputFormat::Cbor)
+        return qtgh::encodeCborResult(result);
+
+    QByteArray line;
+    if (format == OutputFormat::Json) {
+        QJsonObject obj;
+        obj["repo"]  = result.job.repoUrl;
+        obj["local"] = result.job.localVersion;
+        if (!result.job.origin.isEmpty())
+            obj["origin"] = result.job.origin;
+        if (result.status == qtgh::BatchStatus::Ok) {
+            obj["remote"] = result.info.latestVersion;
+            obj["update"] = result.info.hasUpdate;
+        } else {
+            obj["error"] = result.error;
+            if (result.cached)
+                obj["cached"] = true;
+            if (result.status == qtgh::BatchStatus::TimedOut)
+                obj["timeout"] = true;
+            else if (result.status == qtgh::BatchStatus::Cancelled)
+                obj["cancelled"] = true;
+        }
+        line = QJsonDocument(obj).toJson(QJsonDocument::Compact);
+    } else {
+        line = (result.job.repoUrl + "  " + result.job.localVersion + "  ").toUtf8();
+        if (result.status == qtgh::BatchStatus::Ok)
+            line += "-> " + result.info.latestVersion.toUtf8()
+                    + (result.info.hasUpdate ? "  UPDATE" : "");
+        else if (result.status == qtgh::BatchStatus::TimedOut)
+            line += "TIMEOUT: " + result.error.toUtf8();
+        else if (result.status == qtgh::BatchStatus::Cancelled)
+            line += "CANCELLED: " + result.error.toUtf8();
+        else
+            line += "ERROR: " + result.error.toUtf8();
+    }
+    line += '\n';
+    return line;
+}
+
+/// @brief Decode an NDJSON record written by encode_batch_result()
+/// @return The result; its repoUrl is empty if `obj` is not a result record
+inline qtgh::BatchResult decode_json_result(const QJsonObject& obj) {
+    qtgh::BatchResult result;
+    result.job.repoUrl = obj["repo"].toString();
+    result.job.localVersion = obj["local"].toString();
+    result.job.origin = obj["origin"].toString();
+    if (!obj.contains("error")) {
+        result.status = qtgh::BatchStatus::Ok;
+        result.info.latestVersion = obj["remote"].toString();
+        result.info.hasUpdate = obj["update"].toBool();
+    } else {
+        result.error = obj["error"].toString();
+        result.cached = obj["cached"].toBool();
+        result.status = obj["timeout"].toBool()     ? qtgh::BatchStatus::TimedOut
+                        : obj["cancelled"].toBool() ? qtgh::BatchStatus::Cancelled
+                                                    : qtgh::BatchStatus::Failed;
+    }
+    return result;
+}
+
+/// @brief Print one batch result in the given format
+///
+/// Each record is written in one piece and flushed, so every record that
+/// reached the output is complete even if the process is killed later.
+inline void print_batch_result(const qtgh::BatchResult& result, OutputFormat format) {
+    const QByteArray record = encode_batch_result(result, format);
+    std::cout.write(record.constData(), record.size());
+    std::cout.flush();
+}
+
+} // namespace cli
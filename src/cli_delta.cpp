@@ -0,0 +1,75 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: 2026 Zheng-Bote
+//
+// cli_delta.cpp - "delta" sub-command
+//
+// Updates an installed release asset to a new version, downloading only
+// the blocks that changed (see qt_gh-delta-download.hpp). The server must
+// publish the asset's block manifest ("blocksums" sub-command) and answer
+// HTTP Range requests.
+//
+// Usage:
+//   qt_gh-update-checker delta [--manifest URL] [--output FILE] [--rate BYTES_PER_SECOND]
+//                              <asset-url> <installed-file>
+//
+// The manifest defaults to "<asset-url>.blocksums"; the installed file is
+// replaced unless --output is given.
+
+#include <QCoreApplication>
+#include "cli_commands.hpp"
+#include "qt_gh-delta-download.hpp"
+
+namespace cli {
+
+int run_delta(const QStringList& args) {
+    qtgh::DeltaJob job;
+    qint64 rate = 0;
+    QStringList positional;
+
+    for (qsizetype i = 0; i < args.size(); ++i) {
+        const QString& arg = args.at(i);
+        if (arg == "--manifest" && i + 1 < args.size()) {
+            job.manifestUrl = args.at(++i);
+        } else if (arg == "--output" && i + 1 < args.size()) {
+            job.targetPath = args.at(++i);
+        } else if (arg == "--rate" && i + 1 < args.size()) {
+            rate = args.at(++i).toLongLong();
+        } else if (!arg.startsWith("--")) {
+            positional.append(arg);
+        } else {
+            positional.clear();
+            break;
+        }
+    }
+    if (positional.size() != 2) {
+        std::cerr << "Usage: qt_gh-update-checker delta [--manifest URL] [--output FILE] "
+                     "[--rate BYTES_PER_SECOND] <asset-url> <installed-file>\n";
+        return 1;
+    }
+    job.assetUrl = positional.at(0);
+    job.basisPath = positional.at(1);
+    if (job.manifestUrl.isEmpty())
+        job.manifestUrl = job.assetUrl + ".blocksums";
+    if (job.targetPath.isEmpty())
+        job.targetPath = job.basisPath;
+
+    qtgh::AssetDownloader downloader;
+    downloader.throttle().setGlobalRate(rate);
+    qtgh::DeltaDownloader delta(&downloader);
+    int exitCode = 3;
+    delta.update(job, [&exitCode](const qtgh::DeltaResult& r) {
+        if (r.error.isEmpty()) {
+            std::cerr << r.job.targetPath.toStdString() << ": " << r.fetchedBytes << " of " << r.length
+                      << " bytes downloaded in " << r.rangeRequests << " requests, " << r.reusedBytes
+                      << " reused\n";
+            exitCode = 0;
+        } else {
+            std::cerr << "Error: " << r.error.toStdString() << "\n";
+        }
+        QCoreApplication::quit();
+    });
+    QCoreApplication::exec();
+    return exitCode;
+}
+
+} // namespace cli
@@ -9,19 +9,32 @@
 // Usage:
 //   qt_gh-update-checker <repo-url> <local-version>
 //   qt_gh-update-checker --json <repo-url> <local-version>
+//   qt_gh-update-checker scan [--json | --cbor] [--jobs N] [--threads N] [--shard i/n]
+//                             [--deadline SECONDS] <dir>
+//   qt_gh-update-checker merge [--cbor] [--output FILE] <results.ndjson|results.cbor>...
+//   qt_gh-update-checker serve [--socket NAME] [--jobs N] [--webhook-port PORT]
+//   qt_gh-update-checker subscribe [--socket NAME] <repo-url>...
+//   qt_gh-update-checker proxy [--listen ADDR] [--port PORT] [--ttl SECONDS] [--upstream URL]
+//   qt_gh-update-checker blocksums [--block-size BYTES] [--threads N] [--output FILE] <asset>
+//   qt_gh-update-checker delta [--manifest URL] [--output FILE] [--rate BYTES_PER_SECOND]
+//                              <asset-url> <installed-file>
 //
 // Examples:
 //   qt_gh-update-checker https://github.com/nlohmann/json 3.0.0
 //   qt_gh-update-checker --json https://github.com/nlohmann/json 3.0.0
+//   qt_gh-update-checker scan --json ~/src/monorepo
+//   qt_gh-update-checker scan --json --shard 2/4 ~/src/monorepo > shard2.ndjson
 //
 // Exit codes:
 //   0 - No update available
 //   1 - Invalid arguments
 //   2 - Update available
 //   3 - Error occurred
+//   4 - scan: deadline reached before all checks finished
 
 #include <QCoreApplication>
 #include <iostream>
+#include "cli_commands.hpp"
 #include "qt_gh-update-checker.hpp"
 
 /// @brief Main entry point for the update checker CLI
@@ -32,6 +45,22 @@ int main(int argc, char** argv) {
     QCoreApplication app(argc, argv);
     const auto args = app.arguments();
 
+    // Sub-commands
+    if (args.size() >= 2 && args.at(1) == "scan")
+        return cli::run_scan(args.mid(2));
+    if (args.size() >= 2 && args.at(1) == "merge")
+        return cli::run_merge(args.mid(2));
+    if (args.size() >= 2 && args.at(1) == "serve")
+        return cli::run_serve(args.mid(2));
+    if (args.size() >= 2 && args.at(1) == "subscribe")
+        return cli::run_subscribe(args.mid(2));
+    if (args.size() >= 2 && args.at(1) == "proxy")
+        return cli::run_proxy(args.mid(2));
+    if (args.size() >= 2 && args.at(1) == "blocksums")
+        return cli::run_blocksums(args.mid(2));
+    if (args.size() >= 2 && args.at(1) == "delta")
+        return cli::run_delta(args.mid(2));
+
     bool jsonMode = false;
     QString repoUrl;
     QString localVersion;
@@ -64,11 +93,12 @@ int main(int argc, char** argv) {
 
         // Output result in requested format
         if (jsonMode) {
-            std::cout << "{\n";
-            std::cout << "  \"local\": \"" << localVersion.toStdString() << "\",\n";
-            std::cout << "  \"remote\": \"" << info.latestVersion.toStdString() << "\",\n";
-            std::cout << "  \"update\": " << (info.hasUpdate ? "true" : "false") << "\n";
-            std::cout << "}\n";
+            const QJsonObject obj{
+                {"local", localVersion},
+                {"remote", info.latestVersion},
+                {"update", info.hasUpdate},
+            };
+            std::cout << QJsonDocument(obj).toJson(QJsonDocument::Indented).toStdString();
         } else {
             std::cout << "Local version:  " << localVersion.toStdString() << "\n";
             std::cout << "Remote version: " << info.latestVersion.toStdString() << "\n";
@@ -80,9 +110,8 @@ int main(int argc, char** argv) {
     catch (const std::exception& e) {
         // Handle errors and output in requested format
         if (jsonMode) {
-            std::cout << "{\n";
-            std::cout << "  \"error\": \"" << e.what() << "\"\n";
-            std::cout << "}\n";
+            const QJsonObject obj{{"error", QString::fromUtf8(e.what())}};
+            std::cout << QJsonDocument(obj).toJson(QJsonDocument::Indented).toStdString();
         } else {
             std::cerr << "Error: " << e.what() << "\n";
         }
@@ -0,0 +1,132 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: 2026 Zheng-Bote
+//
+// cli_merge.cpp - "merge" sub-command
+//
+// Combines the NDJSON result files of a sharded sweep ("scan --json
+// --shard i/n" on several nodes) into one file. Records are keyed by
+// normalized repository slug and local version; if a key appears more
+// than once (e.g. a shard was re-run) the record from the later file
+// wins. The output is sorted by key so merged results diff cleanly.
+//
+// Inputs written with "scan --cbor" are recognized by their first byte
+// and may be mixed with NDJSON inputs; --cbor writes the merged records
+// as a CBOR sequence instead of NDJSON.
+//
+// Usage:
+//   qt_gh-update-checker merge [--cbor] [--output FILE] <results.ndjson|results.cbor>...
+//
+// Exit codes follow "scan": 2 if any merged record reports an update.
+
+#include <QFile>
+#include <QMap>
+#include "cli_commands.hpp"
+
+namespace cli {
+
+namespace {
+
+/// A CBOR sequence of results starts with a map (major type 5), NDJSON with '{'
+bool isCborResults(const QByteArray& data) {
+    return !data.isEmpty() && (static_cast<quint8>(data.front()) & 0xE0) == 0xA0;
+}
+
+} // namespace
+
+int run_merge(const QStringList& args) {
+    QString outputPath;
+    OutputFormat format = OutputFormat::Json;
+    QStringList inputs;
+
+    for (qsizetype i = 0; i < args.size(); ++i) {
+        if (args.at(i) == "--output" && i + 1 < args.size())
+            outputPath = args.at(++i);
+        else if (args.at(i) == "--cbor")
+            format = OutputFormat::Cbor;
+        else
+            inputs.append(args.at(i));
+    }
+
+    if (inputs.isEmpty()) {
+        std::cerr << "Usage: qt_gh-update-checker merge [--cbor] [--output FILE] "
+                     "<results.ndjson|results.cbor>...\n";
+        return 1;
+    }
+
+    QMap<QString, qtgh::BatchResult> records;
+    auto insert = [&records](qtgh::BatchResult result) {
+        QString slug = result.job.repoUrl;
+        try {
+            slug = qtgh::toRepoSlug(result.job.repoUrl);
+        } catch (const std::exception&) {
+            // Keep unrecognized URLs under their literal spelling
+        }
+        records.insert(slug + QLatin1Char('@') + result.job.localVersion, std::move(result));
+    };
+
+    for (const QString& path : inputs) {
+        QFile file(path);
+        if (!file.open(QIODevice::ReadOnly)) {
+            std::cerr << "Error: cannot read " << path.toStdString() << ": "
+                      << file.errorString().toStdString() << "\n";
+            return 3;
+        }
+
+        if (isCborResults(file.peek(1))) {
+            qtgh::CborResultReader reader(file.readAll());
+            try {
+                while (auto result = reader.next())
+                    insert(std::move(*result));
+            } catch (const std::exception& e) {
+                std::cerr << "Error: " << path.toStdString() << ": " << e.what() << "\n";
+                return 3;
+            }
+            if (reader.truncated())
+                std::cerr << "Warning: " << path.toStdString() << ": ignoring truncated last "
+                          << "record at offset " << reader.offset() << "\n";
+            continue;
+        }
+
+        qsizetype lineNo = 0;
+        while (!file.atEnd()) {
+            const QByteArray raw = file.readLine();
+            const QByteArray line = raw.trimmed();
+            ++lineNo;
+            if (line.isEmpty())
+                continue;
+            qtgh::BatchResult result = decode_json_result(QJsonDocument::fromJson(line).object());
+            if (result.job.repoUrl.isEmpty() && !raw.endsWith('\n') && file.atEnd()) {
+                // A run killed while writing its last record
+                std::cerr << "Warning: " << path.toStdString() << ":" << lineNo
+                          << ": ignoring truncated last line\n";
+                break;
+            }
+            if (result.job.repoUrl.isEmpty()) {
+                std::cerr << "Error: " << path.toStdString() << ":" << lineNo
+                          << ": not a result record\n";
+                return 3;
+            }
+            insert(std::move(result));
+        }
+    }
+
+    QFile out(outputPath);
+    const bool opened = outputPath.isEmpty() ? out.open(stdout, QIODevice::WriteOnly)
+                                             : out.open(QIODevice::WriteOnly);
+    if (!opened) {
+        std::cerr << "Error: cannot write " << outputPath.toStdString() << ": "
+                  << out.errorString().toStdString() << "\n";
+        return 3;
+    }
+
+    bool anyUpdate = false;
+    for (const qtgh::BatchResult& result : std::as_const(records)) {
+        anyUpdate = anyUpdate || (result.status == qtgh::BatchStatus::Ok && result.info.hasUpdate);
+        out.write(encode_batch_result(result, format));
+    }
+
+    std::cerr << "Merged " << records.size() << " records from " << inputs.size() << " files\n";
+    return anyUpdate ? 2 : 0;
+}
+
+} // namespace cli
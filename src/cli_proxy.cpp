@@ -0,0 +1,60 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: 2026 Zheng-Bote
+//
+// cli_proxy.cpp - "proxy" sub-command
+//
+// Runs a caching reverse proxy for the GitHub releases API. Point every
+// checker behind the same egress IP at it with QTGH_API_BASE_URL so they
+// share one cache and one upstream rate-limit budget.
+//
+// Usage:
+//   qt_gh-update-checker proxy [--listen ADDR] [--port PORT] [--ttl SECONDS] [--upstream URL]
+//
+// The upstream token is read from the GITHUB_TOKEN environment variable.
+
+#include <QCoreApplication>
+#include <algorithm>
+#include "cli_commands.hpp"
+#include "qt_gh-caching-proxy.hpp"
+
+namespace cli {
+
+int run_proxy(const QStringList& args) {
+    QHostAddress address = QHostAddress::LocalHost;
+    int port = 8080;
+    int ttl = 300;
+    QString upstream = QStringLiteral("https://api.github.com");
+
+    for (qsizetype i = 0; i < args.size(); ++i) {
+        const QString& arg = args.at(i);
+        if (arg == "--listen" && i + 1 < args.size() && address.setAddress(args.at(i + 1))) {
+            ++i;
+        } else if (arg == "--port" && i + 1 < args.size()) {
+            port = args.at(++i).toInt();
+        } else if (arg == "--ttl" && i + 1 < args.size()) {
+            ttl = args.at(++i).toInt();
+        } else if (arg == "--upstream" && i + 1 < args.size()) {
+            upstream = args.at(++i);
+        } else {
+            std::cerr << "Usage: qt_gh-update-checker proxy [--listen ADDR] [--port PORT] "
+                         "[--ttl SECONDS] [--upstream URL]\n";
+            return 1;
+        }
+    }
+
+    qtgh::CachingProxy proxy;
+    proxy.setUpstreamBaseUrl(upstream);
+    proxy.setUpstreamToken(qgetenv("GITHUB_TOKEN"));
+    proxy.setTtl(std::chrono::seconds(std::max(ttl, 0)));
+
+    if (!proxy.listen(address, static_cast<quint16>(port))) {
+        std::cerr << "Error: " << proxy.errorString().toStdString() << "\n";
+        return 3;
+    }
+    std::cerr << "Caching proxy listening on " << address.toString().toStdString() << ":"
+              << proxy.serverPort() << " (upstream " << upstream.toStdString() << ")\n";
+
+    return QCoreApplication::exec();
+}
+
+} // namespace cli
@@ -0,0 +1,299 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: 2026 Zheng-Bote
+//
+// cli_scan.cpp - "scan" sub-command
+//
+// Walks a source tree for build manifests (CMake FetchContent, vcpkg,
+// conan, .gitmodules) and checks every GitHub dependency found. Scanning
+// and checking run as a pipeline: the walker threads hand entries to the
+// main thread, where the batch checker starts requests immediately.
+//
+// With --shard i/n only the repositories assigned to shard i of n are
+// checked, so a large sweep can be split across machines without a
+// coordinator; the per-shard --json outputs are combined with "merge".
+//
+// With --journal FILE every completed check is appended to a write-ahead
+// journal; after a crash, --resume replays the recorded results and only
+// checks what is still missing.
+//
+// With --adaptive the number of concurrent requests adapts to the server
+// (AIMD, see AimdLimiter) and --jobs becomes its upper bound.
+//
+// With --deadline SECONDS the whole run (walk and checks) is bounded:
+// when the deadline expires, outstanding requests are aborted, the walk
+// stops and every unfinished check is reported as timed out. Every result
+// line is flushed as soon as it is complete, so the output stays valid if
+// the process is killed right after the deadline.
+//
+// With --failure-cache FILE, repositories that failed permanently (404,
+// 451, no or unparsable release tag) are remembered across runs with
+// exponential backoff; until a failure expires it is reported again
+// without a request, and the number of requests avoided is printed.
+//
+// With --trace FILE the phases of every check are written as a Chrome
+// trace (open in ui.perfetto.dev or chrome://tracing) when the run ends.
+//
+// With --cbor the results are written as a CBOR sequence instead of text
+// or NDJSON (one map per result, see qt_gh-result-cbor.hpp).
+//
+// Usage:
+//   qt_gh-update-checker scan [--json | --cbor] [--jobs N] [--adaptive] [--threads N] [--shard i/n]
+//                             [--deadline SECONDS] [--journal FILE [--resume]]
+//                             [--failure-cache FILE] [--trace FILE] <dir>
+//
+// Output:
+//   One record per unique repository/version pair (text, NDJSON or CBOR on stdout),
+//   scan statistics on stderr.
+
+#include <QCoreApplication>
+#include <QDeadlineTimer>
+#include <QElapsedTimer>
+#include <QSet>
+#include <memory>
+#include <thread>
+#include "cli_commands.hpp"
+#include "qt_gh-batch-journal.hpp"
+#include "qt_gh-manifest-scanner.hpp"
+
+namespace cli {
+
+int run_scan(const QStringList& args) {
+    OutputFormat format = OutputFormat::Text;
+    int jobs = 8;
+    bool adaptive = false;
+    unsigned threads = 0;
+    qtgh::Shard shard;
+    double deadlineSeconds = 0;
+    QString journalPath;
+    bool resume = false;
+    QString failureCachePath;
+    QString tracePath;
+    QString root;
+
+    for (qsizetype i = 0; i < args.size(); ++i) {
+        const QString& arg = args.at(i);
+        if (arg == "--json") {
+            format = OutputFormat::Json;
+        } else if (arg == "--cbor") {
+            format = OutputFormat::Cbor;
+        } else if (arg == "--jobs" && i + 1 < args.size()) {
+            jobs = args.at(++i).toInt();
+        } else if (arg == "--adaptive") {
+            adaptive = true;
+        } else if (arg == "--threads" && i + 1 < args.size()) {
+            threads = args.at(++i).toUInt();
+        } else if (arg == "--shard" && i + 1 < args.size()) {
+            try {
+                shard = qtgh::Shard::parse(args.at(++i));
+            } catch (const std::exception& e) {
+                std::cerr << "Error: " << e.what() << "\n";
+                return 1;
+            }
+        } else if (arg == "--deadline" && i + 1 < args.size()) {
+            deadlineSeconds = args.at(++i).toDouble();
+            if (deadlineSeconds <= 0) {
+                root.clear();
+                break;
+            }
+        } else if (arg == "--journal" && i + 1 < args.size()) {
+            journalPath = args.at(++i);
+        } else if (arg == "--resume") {
+            resume = true;
+        } else if (arg == "--failure-cache" && i + 1 < args.size()) {
+            failureCachePath = args.at(++i);
+        } else if (arg == "--trace" && i + 1 < args.size()) {
+            tracePath = args.at(++i);
+        } else if (root.isEmpty() && !arg.startsWith("--")) {
+            root = arg;
+        } else {
+            root.clear();
+            break;
+        }
+    }
+
+    if (root.isEmpty() || jobs < 1 || (resume && journalPath.isEmpty())) {
+        std::cerr << "Usage: qt_gh-update-checker scan [--json | --cbor] [--jobs N] [--adaptive] "
+                     "[--threads N] [--shard i/n] [--deadline SECONDS] "
+                     "[--journal FILE [--resume]] [--failure-cache FILE] [--trace FILE] <dir>\n";
+        return 1;
+    }
+
+    // The budget covers the whole run, including the journal replay and the walk
+    QDeadlineTimer deadline(QDeadlineTimer::Forever);
+    if (deadlineSeconds > 0)
+        deadline = QDeadlineTimer(std::chrono::milliseconds(static_cast<qint64>(deadlineSeconds * 1000)),
+                                  Qt::PreciseTimer);
+
+    std::unique_ptr<qtgh::TraceRecorder> trace;
+    if (!tracePath.isEmpty()) {
+        trace = std::make_unique<qtgh::TraceRecorder>();
+        trace->install();
+    }
+
+    // Replay results of the interrupted run before checking the rest
+    std::unique_ptr<qtgh::BatchJournal> journal;
+    bool anyUpdate = false;
+    if (!journalPath.isEmpty()) {
+        journal = std::make_unique<qtgh::BatchJournal>(journalPath);
+        try {
+            const auto replayed = journal->open(resume);
+            for (const auto& result : replayed) {
+                anyUpdate = anyUpdate || result.info.hasUpdate;
+                print_batch_result(result, format);
+            }
+            if (resume)
+                std::cerr << "Resumed journal with " << replayed.size() << " completed checks\n";
+        } catch (const std::exception& e) {
+            std::cerr << "Error: " << e.what() << "\n";
+            return 3;
+        }
+    }
+
+    // Failures of earlier sweeps; releases are not kept between runs
+    qtgh::ReleaseCache cache;
+    if (!failureCachePath.isEmpty()) {
+        QString error;
+        if (!cache.loadFailures(failureCachePath, &error)) {
+            std::cerr << "Error: cannot read failure cache " << failureCachePath.toStdString()
+                      << ": " << error.toStdString() << "\n";
+            return 3;
+        }
+    }
+
+    qtgh::BatchChecker checker(jobs);
+    if (!failureCachePath.isEmpty()) {
+        qtgh::CheckOptions options;
+        options.cache = &cache;
+        checker.setOptions(options);
+    }
+    checker.setDeadline(deadline);
+    if (adaptive) {
+        qtgh::AimdLimiter::Config limits;
+        limits.initialLimit = std::min(limits.initialLimit, jobs);
+        limits.maxLimit = jobs;
+        checker.setAdaptiveConcurrency(limits);
+    }
+    qsizetype timedOut = 0;
+    checker.setResultHandler([&](const qtgh::BatchResult& result) {
+        if (result.status == qtgh::BatchStatus::TimedOut)
+            ++timedOut;
+        if (journal)
+            journal->append(result);    // errors are sticky and reported after the sweep
+        anyUpdate = anyUpdate || (result.status == qtgh::BatchStatus::Ok && result.info.hasUpdate);
+        print_batch_result(result, format);
+    });
+
+    // Entries arrive on walker threads; hop to the main thread, where the
+    // checker lives, through queued invocations on this context object.
+    QObject context;
+    QSet<QString> seen;
+    qsizetype otherShards = 0;
+    auto submit = [&](const qtgh::ManifestEntry& entry) {
+        const QString origin = QStringLiteral("%1:%2").arg(entry.file).arg(entry.line);
+        // Runs from the event loop: an exception here would terminate the sweep
+        QString slug;
+        try {
+            slug = qtgh::toRepoSlug(entry.repoUrl);
+        } catch (const std::exception&) {
+            print_batch_result({{entry.repoUrl, entry.version, origin},
+                                qtgh::BatchStatus::Failed, {}, "Invalid repository"},
+                               format);
+            return;
+        }
+        if (!shard.contains(slug)) {
+            ++otherShards;
+            return;
+        }
+        if (entry.version.isEmpty()) {
+            print_batch_result({{entry.repoUrl, entry.version, origin},
+                                qtgh::BatchStatus::Failed, {}, "No pinned version"},
+                               format);
+            return;
+        }
+        const QString key = slug + QLatin1Char('@') + entry.version;
+        if (seen.contains(key) || (journal && journal->contains(key)))
+            return;
+        seen.insert(key);
+        checker.enqueue({entry.repoUrl, entry.version, origin});
+    };
+
+    qtgh::ManifestScanner scanner(threads);
+    qtgh::ScanStats stats;
+    QString scanError;
+    QElapsedTimer timer;
+    timer.start();
+
+    std::thread walker([&] {
+        const qint64 walkStart = qtgh::TraceRecorder::now();
+        try {
+            stats = scanner.scan(root, [&](const qtgh::ManifestEntry& entry) {
+                QMetaObject::invokeMethod(&context, [&submit, entry] { submit(entry); },
+                                          Qt::QueuedConnection);
+            });
+        } catch (const std::exception& e) {
+            scanError = QString::fromUtf8(e.what());
+        }
+        if (auto* recorder = qtgh::TraceRecorder::active())
+            recorder->complete("walk", walkStart, qtgh::TraceRecorder::now(), root);
+        QMetaObject::invokeMethod(&context, [&checker] { checker.closeInput(); },
+                                  Qt::QueuedConnection);
+    });
+
+    checker.waitForFinished();
+    if (checker.deadlineExpired())
+        scanner.cancel();
+    walker.join();
+    // Entries found before the walk stopped are reported as timed out
+    QCoreApplication::sendPostedEvents(&context, QEvent::MetaCall);
+
+    if (!failureCachePath.isEmpty()) {
+        QString error;
+        if (!cache.saveFailures(failureCachePath, &error))
+            std::cerr << "Error: cannot write failure cache " << failureCachePath.toStdString()
+                      << ": " << error.toStdString() << "\n";
+    }
+
+    if (trace) {
+        trace->uninstall();
+        QString traceError;
+        if (!trace->writeChromeTrace(tracePath, &traceError))
+            std::cerr << "Error: cannot write trace " << tracePath.toStdString() << ": "
+                      << traceError.toStdString() << "\n";
+        else if (trace->dropped() > 0)
+            std::cerr << "Trace buffer full: " << trace->dropped() << " oldest events dropped\n";
+    }
+
+    if (!scanError.isEmpty()) {
+        std::cerr << "Error: " << scanError.toStdString() << "\n";
+        return 3;
+    }
+    if (journal && !journal->sync()) {
+        std::cerr << "Error: " << journal->errorString().toStdString()
+                  << " (the sweep cannot be resumed from it)\n";
+        return 3;
+    }
+
+    std::cerr << "Scanned " << stats.files << " files in " << stats.directories
+              << " directories (" << stats.manifests << " manifests, "
+              << stats.entries << " declarations) in " << stats.elapsed.count()
+              << " ms; checks finished after " << timer.elapsed() << " ms\n";
+    if (!failureCachePath.isEmpty())
+        std::cerr << "Failure cache: " << checker.cachedFailures()
+                  << " requests avoided, " << cache.failureCount()
+                  << " repositories failing\n";
+    if (timedOut > 0)
+        std::cerr << "Deadline reached: " << timedOut << " checks did not finish\n";
+    if (const auto* limiter = checker.limiter())
+        std::cerr << "Adaptive concurrency: final limit " << limiter->limit() << " of " << jobs
+                  << " (" << limiter->stats().decreases << " cuts, "
+                  << limiter->stats().overloads << " overload responses)\n";
+    if (shard.count > 1)
+        std::cerr << "Shard " << shard.index + 1 << "/" << shard.count << ": skipped "
+                  << otherShards << " declarations assigned to other shards\n";
+
+    if (anyUpdate)
+        return 2;
+    return timedOut > 0 ? 4 : 0;
+}
+
+} // namespace cli
@@ -0,0 +1,119 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: 2026 Zheng-Bote
+//
+// cli_serve.cpp - "serve" and "subscribe" sub-commands
+//
+// "serve" runs the long-lived subscription service: local clients subscribe
+// to repositories over a local socket and are notified when a new version
+// appears. Optionally a GitHub webhook receiver feeds pushed releases into
+// the same service.
+//
+// "subscribe" is a minimal client that prints every message it receives
+// as one JSON object per line.
+//
+// Usage:
+//   qt_gh-update-checker serve [--socket NAME] [--jobs N] [--webhook-port PORT]
+//   qt_gh-update-checker subscribe [--socket NAME] <repo-url>...
+//
+// The webhook secret is read from the QTGH_WEBHOOK_SECRET environment
+// variable so it does not show up in the process list.
+
+#include <QCoreApplication>
+#include <memory>
+#include "cli_commands.hpp"
+#include "qt_gh-subscription-service.hpp"
+#include "qt_gh-webhook-receiver.hpp"
+
+namespace cli {
+
+static const QString kDefaultSocket = QStringLiteral("qt_gh-update-checker");
+
+int run_serve(const QStringList& args) {
+    QString socketName = kDefaultSocket;
+    int jobs = 8;
+    int webhookPort = -1;
+
+    for (qsizetype i = 0; i < args.size(); ++i) {
+        const QString& arg = args.at(i);
+        if (arg == "--socket" && i + 1 < args.size()) {
+            socketName = args.at(++i);
+        } else if (arg == "--jobs" && i + 1 < args.size()) {
+            jobs = args.at(++i).toInt();
+        } else if (arg == "--webhook-port" && i + 1 < args.size()) {
+            webhookPort = args.at(++i).toInt();
+        } else {
+            std::cerr << "Usage: qt_gh-update-checker serve [--socket NAME] [--jobs N] [--webhook-port PORT]\n";
+            return 1;
+        }
+    }
+
+    qtgh::ReleaseCache cache;
+    qtgh::SubscriptionService service;
+    service.setMaxInFlight(jobs);
+
+    std::unique_ptr<qtgh::WebhookReceiver> receiver;
+    if (webhookPort >= 0) {
+        const QByteArray secret = qgetenv("QTGH_WEBHOOK_SECRET");
+        if (secret.isEmpty()) {
+            std::cerr << "Error: --webhook-port requires QTGH_WEBHOOK_SECRET to be set\n";
+            return 1;
+        }
+        qtgh::CheckOptions options;
+        options.cache = &cache;
+        service.setOptions(options);
+
+        receiver = std::make_unique<qtgh::WebhookReceiver>(cache, secret);
+        receiver->setReleaseHandler([&service](const QString& slug, const qtgh::ReleaseRecord& release) {
+            service.notifyRelease(slug, release);
+        });
+        if (!receiver->listen(QHostAddress::Any, static_cast<quint16>(webhookPort))) {
+            std::cerr << "Error: webhook receiver: " << receiver->errorString().toStdString() << "\n";
+            return 3;
+        }
+        std::cerr << "Webhook receiver listening on port " << receiver->serverPort() << "\n";
+    }
+
+    if (!service.listen(socketName)) {
+        std::cerr << "Error: " << service.errorString().toStdString() << "\n";
+        return 3;
+    }
+    std::cerr << "Subscription service listening on " << service.fullServerName().toStdString() << "\n";
+
+    return QCoreApplication::exec();
+}
+
+int run_subscribe(const QStringList& args) {
+    QString socketName = kDefaultSocket;
+    QStringList repos;
+
+    for (qsizetype i = 0; i < args.size(); ++i) {
+        if (args.at(i) == "--socket" && i + 1 < args.size())
+            socketName = args.at(++i);
+        else
+            repos.append(args.at(i));
+    }
+
+    if (repos.isEmpty()) {
+        std::cerr << "Usage: qt_gh-update-checker subscribe [--socket NAME] <repo-url>...\n";
+        return 1;
+    }
+
+    qtgh::SubscriptionClient client;
+    client.setMessageHandler([](const QJsonObject& message) {
+        std::cout << QJsonDocument(message).toJson(QJsonDocument::Compact).toStdString()
+                  << std::endl;
+    });
+    QObject::connect(&client.socket(), &QLocalSocket::disconnected,
+                     QCoreApplication::instance(), [] { QCoreApplication::exit(3); });
+
+    if (!client.connectToService(socketName)) {
+        std::cerr << "Error: cannot connect to " << socketName.toStdString() << ": "
+                  << client.socket().errorString().toStdString() << "\n";
+        return 3;
+    }
+    client.subscribe(repos);
+
+    return QCoreApplication::exec();
+}
+
+} // namespace cli
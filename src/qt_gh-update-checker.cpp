@@ -0,0 +1,11 @@
+// SPDX-License-Identifier: MIT
+// SPDX-FileCopyrightText: 2026 Zheng-Bote
+//
+// qt_gh-update-checker.cpp - Compiled variant of qt_gh-update-checker.hpp
+//
+// The only translation unit of qt_gh_update_checker_static / _shared.
+// Built with QTGH_COMPILED_LIBRARY, so the functions declared QTGH_DECL are
+// defined here once (non-inline) instead of in every including TU.
+
+#include "qt_gh-update-checker.hpp"
+#include "qt_gh-update-checker-impl.hpp"
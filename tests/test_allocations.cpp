@@ -0,0 +1,170 @@
+// Allocation-counting tests for the library's hot paths.
+//
+// Global operator new/delete are replaced to count allocations. On glibc
+// the C allocator (malloc/calloc/realloc), which Qt's containers and
+// strings use, is interposed as well. Counting is limited to the thread
+// inside a measure() call, so unrelated background allocations do not
+// disturb the result. Each check runs the call once to warm up lazily
+// initialized statics and then asserts an allocation budget.
+
+#include <QCoreApplication>
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include "qt_gh-update-checker.hpp"
+
+#if defined(__SANITIZE_ADDRESS__)
+#define QTGH_NO_MALLOC_HOOKS
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer) || __has_feature(memory_sanitizer)
+#define QTGH_NO_MALLOC_HOOKS
+#endif
+#endif
+
+namespace {
+
+thread_local bool t_counting = false;
+thread_local long t_allocations = 0;
+
+inline void countAllocation() {
+    if (t_counting)
+        ++t_allocations;
+}
+
+} // namespace
+
+// ---------------------------------------------------------
+// C allocator hooks (glibc)
+// ---------------------------------------------------------
+#if defined(__GLIBC__) && !defined(QTGH_NO_MALLOC_HOOKS)
+#define QTGH_MALLOC_HOOKS 1
+extern "C" {
+void* __libc_malloc(std::size_t);
+void* __libc_calloc(std::size_t, std::size_t);
+void* __libc_realloc(void*, std::size_t);
+void __libc_free(void*);
+
+void* malloc(std::size_t size) {
+    countAllocation();
+    return __libc_malloc(size);
+}
+void* calloc(std::size_t n, std::size_t size) {
+    countAllocation();
+    return __libc_calloc(n, size);
+}
+void* realloc(void* p, std::size_t size) {
+    countAllocation();
+    return __libc_realloc(p, size);
+}
+void free(void* p) {
+    __libc_free(p);
+}
+}
+static void* rawAlloc(std::size_t size) { return __libc_malloc(size); }
+static void rawFree(void* p) { __libc_free(p); }
+#else
+#define QTGH_MALLOC_HOOKS 0
+static void* rawAlloc(std::size_t size) { return std::malloc(size); }
+static void rawFree(void* p) { std::free(p); }
+#endif
+
+// ---------------------------------------------------------
+// operator new/delete
+// ---------------------------------------------------------
+void* operator new(std::size_t size) {
+    countAllocation();
+    if (void* p = rawAlloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size) { return operator new(size); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    countAllocation();
+    return rawAlloc(size ? size : 1);
+}
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept {
+    return operator new(size, tag);
+}
+void operator delete(void* p) noexcept { rawFree(p); }
+void operator delete[](void* p) noexcept { rawFree(p); }
+void operator delete(void* p, std::size_t) noexcept { rawFree(p); }
+void operator delete[](void* p, std::size_t) noexcept { rawFree(p); }
+
+// ---------------------------------------------------------
+// Measurement
+// ---------------------------------------------------------
+/// Run fn once to warm up, then return the allocations of a second call
+template <typename Fn>
+static long measure(Fn&& fn) {
+    fn();
+    t_allocations = 0;
+    t_counting = true;
+    fn();
+    t_counting = false;
+    return t_allocations;
+}
+
+static bool expectAtMost(const char* name, long budget, long actual) {
+    const bool ok = actual <= budget;
+    std::cout << (ok ? "ok    " : "FAIL  ") << name << ": " << actual
+              << " allocation(s), budget " << budget << "\n";
+    return ok;
+}
+
+int main(int argc, char** argv) {
+    QCoreApplication app(argc, argv);
+    bool ok = true;
+
+    // The harness itself must see allocations, or every budget passes trivially
+    ok &= measure([] { delete new int(1); }) == 1;
+#if QTGH_MALLOC_HOOKS
+    ok &= measure([] { QString s(64, QChar(u'x')); }) >= 1;
+#endif
+    if (!ok) {
+        std::cerr << "Allocation hooks are not effective\n";
+        return 1;
+    }
+
+    volatile int sink = 0;
+    const QString version = QStringLiteral("v12.34.56");
+
+    ok &= expectAtMost("SemVer::parse(QStringView)", 0, measure([&] {
+        sink = sink + qtgh::SemVer::parse(QStringView(u"release-1.2.3")).patch;
+    }));
+    ok &= expectAtMost("SemVer::parse(const QString&)", 0, measure([&] {
+        sink = sink + qtgh::SemVer::parse(version).major;
+    }));
+
+    const auto a = qtgh::SemVer::parse(u"1.2.3");
+    const auto b = qtgh::SemVer::parse(u"1.10.0");
+    ok &= expectAtMost("SemVer operator<=>", 0, measure([&] {
+        sink = sink + (a < b) + (a == b) + (b > a);
+    }));
+
+    // Cache-hit path
+    qtgh::ReleaseCache cache;
+    const QDateTime now = QDateTime::currentDateTimeUtc();
+    cache.store("nlohmann/json", {QStringLiteral("v3.11.3"), now, now, now.addSecs(3600)});
+    const QString slug = QStringLiteral("nlohmann/json");
+
+    ok &= expectAtMost("ReleaseCache::lookup (hit)", 0, measure([&] {
+        sink = sink + cache.lookup(slug, now).has_value();
+    }));
+
+    const auto record = *cache.lookup(slug, now);
+    const QString local = QStringLiteral("3.0.0");
+    ok &= expectAtMost("compareRelease", 0, measure([&] {
+        sink = sink + qtgh::compareRelease(record, local).hasUpdate;
+    }));
+
+    // Only the normalized slug is built; no regex, URL formatting or request
+    qtgh::CheckOptions options;
+    options.cache = &cache;
+    const QString url = QStringLiteral("https://github.com/nlohmann/json");
+    ok &= expectAtMost("check_github_update (cache hit)", 1, measure([&] {
+        sink = sink + qtgh::check_github_update(url, local, options).hasUpdate;
+    }));
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,203 @@
+#include <QBuffer>
+#include <QCoreApplication>
+#include <QEventLoop>
+#include <QUrlQuery>
+#include <iostream>
+#include <map>
+#include "qt_gh-asset-downloader.hpp"
+#include "qt_gh-http-server.hpp"
+
+static QByteArray payload(qsizetype size) {
+    QByteArray data(size, Qt::Uninitialized);
+    for (qsizetype i = 0; i < size; ++i)
+        data[i] = static_cast<char>(i % 251);
+    return data;
+}
+
+/// Duration in seconds
+static double seconds(std::chrono::nanoseconds d) { return std::chrono::duration<double>(d).count(); }
+
+/// Whether a download kept to `rate` bytes/s after the initial burst: never
+/// faster, and at most three times slower (busy CI machines)
+static bool meetsRate(const qtgh::DownloadResult& r, qint64 rate) {
+    const qint64 burst = std::max(qtgh::TokenBucket::kMinBurst, rate / 10);
+    const double ideal = static_cast<double>(r.bytes - burst) / static_cast<double>(rate);
+    return seconds(r.elapsed) >= 0.9 * ideal && seconds(r.elapsed) <= 3 * ideal + 0.5;
+}
+
+/// Run the event loop until `count` handlers ran (at most 20 s)
+static void waitFor(const int& finished, int count) {
+    QEventLoop loop;
+    QTimer poll;
+    QObject::connect(&poll, &QTimer::timeout, &loop, [&] {
+        if (finished >= count)
+            loop.quit();
+    });
+    poll.start(5);
+    QTimer::singleShot(20000, &loop, &QEventLoop::quit);
+    loop.exec();
+}
+
+int main(int argc, char** argv) {
+    QCoreApplication app(argc, argv);
+    bool ok = true;
+    auto expect = [&ok](bool condition, const char* what) {
+        if (!condition) {
+            std::cerr << "FAILED: " << what << "\n";
+            ok = false;
+        }
+    };
+    constexpr qint64 KiB = 1024;
+
+    // Token bucket bookkeeping
+    {
+        using namespace std::chrono_literals;
+        const auto t0 = qtgh::TokenBucket::Clock::now();
+        qtgh::TokenBucket bucket(1000, 0, t0);
+        expect(bucket.burst() == qtgh::TokenBucket::kMinBurst && bucket.available(t0) == 4096,
+               "bucket starts full with the minimum burst");
+        bucket.consume(4096);
+        expect(bucket.available(t0 + 1s) == 1000, "tokens accumulate at the rate");
+        expect(bucket.waitFor(2000, t0 + 1s) == 1s, "waitFor() reports the missing time");
+        expect(bucket.available(t0 + 100s) == 4096, "tokens are capped at the burst");
+        bucket.setRate(100 * 1000, 0, t0 + 100s);
+        expect(bucket.burst() == 10000 && bucket.available(t0 + 100s) == 4096,
+               "rate change keeps collected tokens");
+        bucket.setRate(0);
+        expect(bucket.unlimited() && bucket.waitFor(1 << 30) == 0ns, "rate 0 is unlimited");
+    }
+
+    // Local file server: GET /asset?size=N
+    qtgh::HttpServer server([](const qtgh::HttpRequest& req, qtgh::HttpServer::Responder respond) {
+        const QUrl url(QString::fromUtf8(req.path));
+        if (url.path() != "/asset") {
+            respond({404, "text/plain", {}, "not found"});
+            return;
+        }
+        respond({200, "application/octet-stream", {},
+                 payload(QUrlQuery(url).queryItemValue("size").toLongLong())});
+    });
+    if (!server.listen()) {
+        std::cerr << "listen failed\n";
+        return 1;
+    }
+    auto assetUrl = [&server](qint64 size) {
+        return QStringLiteral("http://127.0.0.1:%1/asset?size=%2").arg(server.serverPort()).arg(size);
+    };
+
+    qtgh::AssetDownloader downloader;
+    int finished = 0;
+    std::map<quint64, qtgh::DownloadResult> results;
+    auto done = [&](const qtgh::DownloadResult& r) {
+        results[r.id] = r;
+        ++finished;
+    };
+
+    // Global limit: 768 KiB at 1 MiB/s
+    {
+        downloader.throttle().setGlobalRate(1024 * KiB);
+        QBuffer out;
+        out.open(QIODevice::WriteOnly);
+        const auto id = downloader.download(assetUrl(768 * KiB), &out, done);
+        waitFor(finished, 1);
+        const auto& r = results[id];
+        std::cerr << "global 1 MiB/s: " << seconds(r.elapsed) << " s, peak buffered "
+                  << r.peakBuffered << "\n";
+        expect(r.error.isEmpty() && r.bytes == 768 * KiB && out.data() == payload(768 * KiB),
+               "throttled download is complete");
+        expect(meetsRate(r, 1024 * KiB), "global rate is met");
+        expect(r.peakBuffered <= 2 * qtgh::AssetDownloader::kReadBufferSize,
+               "reads are paused instead of buffered");
+        downloader.throttle().setGlobalRate(0);
+    }
+
+    // Per-download limit: 384 KiB at 512 KiB/s, less a burst of 51.2 KiB
+    {
+        finished = 0;
+        QBuffer out;
+        out.open(QIODevice::WriteOnly);
+        qtgh::DownloadOptions options;
+        options.rateLimit = 512 * KiB;
+        const auto id = downloader.download(assetUrl(384 * KiB), &out, done, options);
+        waitFor(finished, 1);
+        const auto& r = results[id];
+        std::cerr << "per-download 512 KiB/s: " << seconds(r.elapsed) << " s\n";
+        expect(r.error.isEmpty() && r.bytes == 384 * KiB, "per-download limited download completes");
+        expect(meetsRate(r, 512 * KiB), "per-download rate is met");
+    }
+
+    // Limits change at runtime: 512 KiB at 64 KiB/s would take 8 s
+    {
+        finished = 0;
+        QBuffer out;
+        out.open(QIODevice::WriteOnly);
+        qtgh::DownloadOptions options;
+        options.rateLimit = 64 * KiB;
+        const auto id = downloader.download(assetUrl(512 * KiB), &out, done, options);
+        QTimer::singleShot(300, [&] { downloader.setRateLimit(id, 0); });
+        waitFor(finished, 1);
+        const auto& r = results[id];
+        expect(r.error.isEmpty() && r.bytes == 512 * KiB && seconds(r.elapsed) < 4.0,
+               "raised limit takes effect on a running download");
+    }
+
+    // Interactive traffic: background downloads get a quarter of the global rate
+    {
+        finished = 0;
+        downloader.throttle().setGlobalRate(1024 * KiB);
+        downloader.throttle().setInteractiveShare(0.25);
+        auto guard = downloader.throttle().yieldToInteractive();
+        QBuffer background, interactive;
+        background.open(QIODevice::WriteOnly);
+        interactive.open(QIODevice::WriteOnly);
+        const auto bg = downloader.download(assetUrl(256 * KiB), &background, done);
+        qtgh::DownloadOptions options;
+        options.priority = qtgh::BatchPriority::Interactive;
+        const auto fg = downloader.download(assetUrl(4096 * KiB), &interactive, done, options);
+        waitFor(finished, 2);
+        std::cerr << "yielding: background " << seconds(results[bg].elapsed) << " s, interactive "
+                  << seconds(results[fg].elapsed) << " s\n";
+        expect(results[bg].bytes == 256 * KiB && seconds(results[bg].elapsed) > 0.7,
+               "background download yields to interactive traffic");
+        expect(results[fg].bytes == 4096 * KiB && seconds(results[fg].elapsed) < 2.0,
+               "interactive download is not held back by the global rate (4 s)");
+
+        // Share 0 pauses background downloads until the guard is released
+        finished = 0;
+        downloader.throttle().setInteractiveShare(0);
+        QBuffer paused;
+        paused.open(QIODevice::WriteOnly);
+        downloader.download(assetUrl(256 * KiB), &paused, done);
+        QEventLoop wait;
+        QTimer::singleShot(300, &wait, &QEventLoop::quit);
+        wait.exec();
+        expect(paused.size() == 0 && finished == 0, "share 0 pauses background downloads");
+        guard.reset();
+        waitFor(finished, 1);
+        expect(paused.size() == 256 * KiB, "released guard resumes them");
+        downloader.throttle().setInteractiveShare(0.1);
+        downloader.throttle().setGlobalRate(0);
+    }
+
+    // Cancellation and errors
+    {
+        finished = 0;
+        QBuffer out;
+        out.open(QIODevice::WriteOnly);
+        qtgh::DownloadOptions options;
+        options.rateLimit = 16 * KiB;
+        const auto id = downloader.download(assetUrl(1024 * KiB), &out, done, options);
+        QTimer::singleShot(100, [&] { downloader.cancel(id); });
+        QBuffer missingOut;
+        missingOut.open(QIODevice::WriteOnly);
+        const auto missing = downloader.download(
+            QStringLiteral("http://127.0.0.1:%1/missing").arg(server.serverPort()), &missingOut, done);
+        waitFor(finished, 2);
+        expect(results[id].error == "Cancelled", "cancelled download reports it");
+        expect(results[missing].error.contains("404"), "HTTP errors are reported");
+        expect(missingOut.size() == 0 && results[missing].bytes == 0, "error pages are not written");
+        expect(downloader.active() == 0, "no downloads left");
+    }
+
+    return ok ? 0 : 1;
+}
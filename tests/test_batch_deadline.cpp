@@ -0,0 +1,137 @@
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <iostream>
+#include "qt_gh-batch-checker.hpp"
+#include "qt_gh-http-server.hpp"
+
+int main(int argc, char** argv) {
+    QCoreApplication app(argc, argv);
+    bool ok = true;
+
+    // Local API: repositories named "slow-*" never answer
+    QList<qtgh::HttpServer::Responder> hung;
+    qtgh::HttpServer api([&](const qtgh::HttpRequest& req, qtgh::HttpServer::Responder respond) {
+        if (req.path.contains("/slow-")) {
+            hung.append(std::move(respond));
+            return;
+        }
+        respond({200, "application/json", {},
+                 R"({"tag_name":"v2.0.0","published_at":"2026-01-01T00:00:00Z"})"});
+    });
+    if (!api.listen()) {
+        std::cerr << "listen failed\n";
+        return 1;
+    }
+    const QString base = QStringLiteral("http://127.0.0.1:%1").arg(api.serverPort());
+
+    // Synchronous path: a hung request fails after the transfer timeout
+    {
+        qtgh::CheckOptions options;
+        options.apiBaseUrl = base;
+        options.timeout = std::chrono::milliseconds(200);
+        QElapsedTimer timer;
+        timer.start();
+        try {
+            qtgh::check_github_update("https://github.com/owner/slow-sync", "1.0.0", options);
+            std::cerr << "Hung request did not time out\n";
+            ok = false;
+        } catch (const std::runtime_error& e) {
+            if (!QString::fromUtf8(e.what()).contains("timed out") || timer.elapsed() > 5000) {
+                std::cerr << "Unexpected timeout behaviour: " << e.what() << " after "
+                          << timer.elapsed() << " ms\n";
+                ok = false;
+            }
+        }
+    }
+
+    // Batch path: fast checks finish, cache hits skip the queue, the rest times out
+    qtgh::ReleaseCache cache;
+    qtgh::ReleaseRecord cached;
+    cached.tag = QStringLiteral("v1.5.0");
+    cached.fetchedAt = QDateTime::currentDateTimeUtc();
+    cached.expiresAt = cached.fetchedAt.addSecs(3600);
+    cache.store(QStringLiteral("owner/cached"), cached);
+
+    qtgh::CheckOptions options;
+    options.apiBaseUrl = base;
+    options.cache = &cache;
+    qtgh::BatchChecker checker(2);
+    checker.setOptions(options);
+    checker.setDeadline(QDeadlineTimer(std::chrono::milliseconds(500)));
+
+    QHash<QString, qtgh::BatchStatus> statuses;
+    QList<QString> order;
+    checker.setResultHandler([&](const qtgh::BatchResult& r) {
+        const QString name = r.job.repoUrl.section('/', -1);
+        statuses.insert(name, r.status);
+        order.append(name);
+    });
+
+    QElapsedTimer timer;
+    timer.start();
+    // Both request slots are taken by hung requests, so "fast" waits in the queue
+    checker.enqueue({"https://github.com/owner/slow-1", "1.0.0", {}});
+    checker.enqueue({"https://github.com/owner/slow-2", "1.0.0", {}});
+    checker.enqueue({"https://github.com/owner/fast", "1.0.0", {}});
+    checker.enqueue({"https://github.com/owner/cached", "1.0.0", {}});
+    if (order != QList<QString>{"cached"}) {
+        std::cerr << "Cache hit was not answered ahead of the queue\n";
+        ok = false;
+    }
+
+    // No closeInput(): the deadline alone ends the batch
+    checker.waitForFinished();
+    const qint64 elapsed = timer.elapsed();
+    if (!checker.deadlineExpired() || !checker.isFinished() || elapsed < 400 || elapsed > 5000) {
+        std::cerr << "Batch did not end at the deadline (" << elapsed << " ms)\n";
+        ok = false;
+    }
+    const QHash<QString, qtgh::BatchStatus> expected{
+        {"cached", qtgh::BatchStatus::Ok},
+        {"slow-1", qtgh::BatchStatus::TimedOut},
+        {"slow-2", qtgh::BatchStatus::TimedOut},
+        {"fast", qtgh::BatchStatus::TimedOut},
+    };
+    if (statuses != expected) {
+        std::cerr << "Unexpected statuses after the deadline\n";
+        ok = false;
+    }
+    if (checker.inFlight() != 0 || checker.pending() != 0) {
+        std::cerr << "Requests left behind after the deadline\n";
+        ok = false;
+    }
+
+    // Jobs enqueued after the deadline time out immediately
+    checker.enqueue({"https://github.com/owner/late", "1.0.0", {}});
+    if (statuses.value("late", qtgh::BatchStatus::Ok) != qtgh::BatchStatus::TimedOut) {
+        std::cerr << "Late job did not time out immediately\n";
+        ok = false;
+    }
+
+    // Checks that finish before the deadline keep their results
+    qtgh::BatchChecker relaxed(4);
+    qtgh::CheckOptions plain;
+    plain.apiBaseUrl = base;
+    relaxed.setOptions(plain);
+    relaxed.setDeadline(QDeadlineTimer(std::chrono::milliseconds(400)));
+    int finishedOk = 0;
+    int finishedTimedOut = 0;
+    relaxed.setResultHandler([&](const qtgh::BatchResult& r) {
+        if (r.status == qtgh::BatchStatus::Ok && r.info.latestVersion == "v2.0.0")
+            ++finishedOk;
+        else if (r.status == qtgh::BatchStatus::TimedOut)
+            ++finishedTimedOut;
+    });
+    for (int i = 0; i < 6; ++i)
+        relaxed.enqueue({QStringLiteral("https://github.com/owner/fast-%1").arg(i), "1.0.0", {}});
+    relaxed.enqueue({"https://github.com/owner/slow-3", "1.0.0", {}});
+    relaxed.closeInput();
+    relaxed.waitForFinished();
+    if (finishedOk != 6 || finishedTimedOut != 1) {
+        std::cerr << "Expected 6 results and 1 timeout, got " << finishedOk << " and "
+                  << finishedTimedOut << "\n";
+        ok = false;
+    }
+
+    return ok ? 0 : 1;
+}
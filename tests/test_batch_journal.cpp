@@ -0,0 +1,142 @@
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QTemporaryDir>
+#include <iostream>
+#include "qt_gh-batch-journal.hpp"
+
+static qtgh::BatchResult makeResult(int i) {
+    qtgh::BatchResult r;
+    r.job = {QStringLiteral("https://github.com/owner/repo-%1").arg(i), "1.0.0",
+             QStringLiteral("CMakeLists.txt:%1").arg(i)};
+    r.status = qtgh::BatchStatus::Ok;
+    r.info.latestVersion = QStringLiteral("1.%1.0").arg(i % 3);
+    r.info.hasUpdate = i % 3 != 0;
+    r.info.publishedAt = QDateTime(QDate(2026, 1, 1), QTime(12, 0), QTimeZone::UTC).addDays(i);
+    return r;
+}
+
+int main(int argc, char** argv) {
+    QCoreApplication app(argc, argv);
+
+    QTemporaryDir dir;
+    if (!dir.isValid())
+        return 1;
+    const QString path = dir.filePath("sweep.journal");
+    bool ok = true;
+
+    // First run: 100 results, one failure that must not be journaled
+    {
+        qtgh::BatchJournal journal(path);
+        if (!journal.open(false).isEmpty())
+            ok = false;
+        bool appended = true;
+        for (int i = 0; i < 100; ++i)
+            appended = journal.append(makeResult(i)) && appended;
+        qtgh::BatchResult failed = makeResult(100);
+        failed.status = qtgh::BatchStatus::Failed;
+        journal.append(failed);
+        if (!appended || !journal.errorString().isEmpty()) {
+            std::cerr << "Append failed: " << journal.errorString().toStdString() << "\n";
+            ok = false;
+        }
+        // Records reach the OS right away, not at the next sync
+        if (QFile(path).size() < 100 * 16) {
+            std::cerr << "Appended records are still buffered in the process\n";
+            ok = false;
+        }
+    }
+
+    // Simulate a crash in the middle of writing a record
+    {
+        QFile f(path);
+        f.open(QIODevice::Append);
+        f.write(QByteArray("\x20\x00\x00\x00\x01\x02", 6));
+    }
+
+    // Resume: intact records replayed in order, torn tail dropped
+    {
+        qtgh::BatchJournal journal(path);
+        const auto replayed = journal.open(true);
+        if (replayed.size() != 100) {
+            std::cerr << "Expected 100 replayed results, got " << replayed.size() << "\n";
+            ok = false;
+        }
+        for (int i = 0; i < replayed.size(); ++i) {
+            const auto expected = makeResult(i);
+            const auto& r = replayed.at(i);
+            if (r.job.repoUrl != expected.job.repoUrl || r.job.origin != expected.job.origin
+                || r.info.latestVersion != expected.info.latestVersion
+                || r.info.hasUpdate != expected.info.hasUpdate
+                || r.info.publishedAt != expected.info.publishedAt) {
+                std::cerr << "Replayed result " << i << " differs\n";
+                ok = false;
+                break;
+            }
+        }
+        if (!journal.contains(qtgh::BatchJournal::keyOf(makeResult(42).job))
+            || journal.contains(qtgh::BatchJournal::keyOf(makeResult(100).job))) {
+            std::cerr << "Journal keys wrong after resume\n";
+            ok = false;
+        }
+        journal.append(makeResult(100));
+    }
+
+    // Appending after a resume continues the same journal
+    {
+        qtgh::BatchJournal journal(path);
+        if (journal.open(true).size() != 101) {
+            std::cerr << "Result appended after resume was lost\n";
+            ok = false;
+        }
+    }
+
+    // Overhead: records per second with the default sync interval
+    {
+        qtgh::BatchJournal journal(path);
+        journal.open(false);
+        constexpr int kRecords = 100000;
+        QElapsedTimer timer;
+        timer.start();
+        for (int i = 0; i < kRecords; ++i)
+            journal.append(makeResult(i));
+        journal.sync();
+        const qint64 ns = std::max<qint64>(1, timer.nsecsElapsed());
+        std::cout << "Journal append: " << ns / kRecords << " ns/record ("
+                  << static_cast<qint64>(kRecords * 1e9 / ns) << " records/s)\n";
+    }
+
+    // Not a journal: rejected instead of overwritten
+    {
+        QFile f(dir.filePath("other"));
+        f.open(QIODevice::WriteOnly);
+        f.write("hello world");
+        f.close();
+        qtgh::BatchJournal journal(dir.filePath("other"));
+        try {
+            journal.open(true);
+            std::cerr << "Foreign file accepted as journal\n";
+            ok = false;
+        } catch (const std::runtime_error&) {
+        }
+    }
+
+#if defined(Q_OS_LINUX)
+    // Write errors are reported instead of ignored
+    {
+        qtgh::BatchJournal journal("/dev/full");
+        try {
+            journal.open(false);
+            std::cerr << "Journal on a full device opened without error\n";
+            ok = false;
+        } catch (const std::runtime_error&) {
+        }
+        if (journal.append(makeResult(1)) || journal.errorString().isEmpty()) {
+            std::cerr << "Append to a journal that failed to open succeeded\n";
+            ok = false;
+        }
+    }
+#endif
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,120 @@
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QTimer>
+#include <iostream>
+#include "qt_gh-batch-checker.hpp"
+#include "qt_gh-http-server.hpp"
+
+int main(int argc, char** argv) {
+    QCoreApplication app(argc, argv);
+    bool ok = true;
+    auto expect = [&ok](bool condition, const char* what) {
+        if (!condition) {
+            std::cerr << "FAILED: " << what << "\n";
+            ok = false;
+        }
+    };
+
+    // Local API: "bg-*" repositories answer after 200 ms, the rest at once.
+    // Request paths are recorded in arrival order.
+    QList<QString> arrivals;
+    qtgh::HttpServer api([&](const qtgh::HttpRequest& req, qtgh::HttpServer::Responder respond) {
+        arrivals.append(QString::fromUtf8(req.path).section(QLatin1Char('/'), 3, 3));
+        const qtgh::HttpResponse response{
+            200, "application/json", {},
+            R"({"tag_name":"v2.0.0","published_at":"2026-01-01T00:00:00Z"})"};
+        if (req.path.contains("/bg-"))
+            QTimer::singleShot(200, [respond, response] { respond(response); });
+        else
+            respond(response);
+    });
+    if (!api.listen()) {
+        std::cerr << "listen failed\n";
+        return 1;
+    }
+    qtgh::CheckOptions options;
+    options.apiBaseUrl = QStringLiteral("http://127.0.0.1:%1").arg(api.serverPort());
+
+    auto job = [](const QString& name, qtgh::BatchPriority priority) {
+        qtgh::BatchJob j{"https://github.com/owner/" + name, "1.0.0", {}};
+        j.priority = priority;
+        return j;
+    };
+    constexpr auto kBackground = qtgh::BatchPriority::Background;
+    constexpr auto kInteractive = qtgh::BatchPriority::Interactive;
+
+    // Queued interactive jobs start ahead of queued background jobs, and
+    // one background job is let through after every starvation-limit run
+    {
+        arrivals.clear();
+        qtgh::BatchChecker checker(1);
+        checker.setOptions(options);
+        checker.setPreemption(false);
+        checker.setStarvationLimit(2);
+        checker.enqueue(job("fast-bg0", kBackground));     // takes the only slot
+        for (int i = 1; i <= 3; ++i)
+            checker.enqueue(job(QStringLiteral("fast-bg%1").arg(i), kBackground));
+        for (int i = 0; i < 6; ++i)
+            checker.enqueue(job(QStringLiteral("ia%1").arg(i), kInteractive));
+        checker.closeInput();
+        checker.waitForFinished();
+        const QList<QString> expected{"fast-bg0", "ia0", "ia1", "fast-bg1", "ia2",
+                                      "ia3", "fast-bg2", "ia4", "ia5", "fast-bg3"};
+        expect(arrivals == expected, "interactive first, one background job every 2");
+    }
+
+    // Preemption: an interactive job aborts the youngest background request
+    // instead of waiting for it; the aborted job is retried and still succeeds
+    {
+        qtgh::BatchChecker checker(2);
+        checker.setOptions(options);
+        QList<QString> order;
+        int succeeded = 0;
+        QElapsedTimer latency;
+        qint64 interactiveMs = -1;
+        checker.setResultHandler([&](const qtgh::BatchResult& r) {
+            if (r.job.priority == kInteractive)
+                interactiveMs = latency.elapsed();
+            order.append(r.job.repoUrl.section('/', -1));
+            succeeded += r.status == qtgh::BatchStatus::Ok ? 1 : 0;
+        });
+        for (int i = 0; i < 6; ++i)
+            checker.enqueue(job(QStringLiteral("bg-%1").arg(i), kBackground));
+        QTimer::singleShot(50, [&] {
+            latency.start();
+            checker.enqueue(job("interactive", kInteractive));
+        });
+        checker.closeInput();
+        checker.waitForFinished();
+
+        expect(order.value(0) == "interactive", "interactive result arrives first");
+        expect(interactiveMs >= 0 && interactiveMs < 150,
+               "interactive check does not wait for a background request");
+        expect(checker.preemptions() == 1, "exactly one background request is preempted");
+        expect(succeeded == 7 && order.size() == 7, "every job is delivered once and succeeds");
+        std::cout << "Interactive latency with 2 busy background slots: " << interactiveMs
+                  << " ms\n";
+    }
+
+    // A preempted job is not preempted again, so background work progresses
+    {
+        qtgh::BatchChecker checker(1);
+        checker.setOptions(options);
+        int background = 0;
+        checker.setResultHandler([&](const qtgh::BatchResult& r) {
+            background += r.job.priority == kBackground ? 1 : 0;
+        });
+        checker.enqueue(job("bg-victim", kBackground));
+        checker.enqueue(job("ia-first", kInteractive));     // preempts bg-victim
+        QTimer::singleShot(50, [&] {
+            // bg-victim runs again; this one has to wait for it
+            checker.enqueue(job("ia-second", kInteractive));
+            checker.closeInput();
+        });
+        checker.waitForFinished();
+        expect(checker.preemptions() == 1 && background == 1,
+               "a job is preempted at most once");
+    }
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,196 @@
+#include <QCoreApplication>
+#include <QEventLoop>
+#include <QNetworkProxy>
+#include <iostream>
+#include "qt_gh-caching-proxy.hpp"
+
+int main(int argc, char** argv) {
+    QCoreApplication app(argc, argv);
+
+    // Fake upstream: one release with a fixed ETag
+    int upstreamRequests = 0;
+    int upstreamConditional = 0;
+    QByteArray upstreamPath;
+    bool upstreamDown = false;
+    qtgh::HttpServer upstream([&](const qtgh::HttpRequest& req, qtgh::HttpServer::Responder respond) {
+        ++upstreamRequests;
+        upstreamPath = req.path;
+        if (upstreamDown || req.path.contains("/broken/")) {
+            respond({500, "application/json", {}, R"({"message":"Server Error"})"});
+            return;
+        }
+        if (req.header("if-none-match") == "\"abc\"") {
+            ++upstreamConditional;
+            respond({304, {}, {{"ETag", "\"abc\""}}, {}});
+            return;
+        }
+        respond({200, "application/json", {{"ETag", "\"abc\""}},
+                 R"({"tag_name":"v2.0.0","published_at":"2026-01-01T00:00:00Z"})"});
+    });
+    if (!upstream.listen()) {
+        std::cerr << "upstream listen failed\n";
+        return 1;
+    }
+
+    qtgh::CachingProxy proxy;
+    proxy.setUpstreamBaseUrl(QStringLiteral("http://127.0.0.1:%1/").arg(upstream.serverPort()));
+    if (!proxy.listen()) {
+        std::cerr << "proxy listen failed: " << proxy.errorString().toStdString() << "\n";
+        return 1;
+    }
+
+    QNetworkAccessManager mgr;
+    mgr.setProxy(QNetworkProxy::NoProxy);
+    bool ok = true;
+
+    // Concurrent misses for one repository: a single upstream request
+    const QString base = QStringLiteral("http://127.0.0.1:%1").arg(proxy.serverPort());
+    const QUrl url(base + "/repos/Owner/Repo/releases/latest?client=1");
+    QList<QNetworkReply*> replies;
+    for (int i = 0; i < 5; ++i)
+        replies.append(mgr.get(QNetworkRequest(url)));
+    int finished = 0;
+    QEventLoop loop;
+    for (auto* reply : replies) {
+        QObject::connect(reply, &QNetworkReply::finished, &loop, [&] {
+            if (++finished == replies.size())
+                loop.quit();
+        });
+    }
+    loop.exec();
+    for (auto* reply : replies) {
+        if (reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() != 200
+            || qtgh::parseRelease(reply->readAll()).tag != "v2.0.0") {
+            std::cerr << "Coalesced request did not return the release\n";
+            ok = false;
+        }
+        reply->deleteLater();
+    }
+    if (upstreamRequests != 1) {
+        std::cerr << "Expected 1 upstream request, got " << upstreamRequests << "\n";
+        ok = false;
+    }
+    // The upstream path is the canonical one, whatever the first client sent
+    if (upstreamPath != "/repos/owner/repo/releases/latest") {
+        std::cerr << "Unexpected upstream path " << upstreamPath.toStdString() << "\n";
+        ok = false;
+    }
+
+    // Library pointed at the proxy: answered from cache
+    qtgh::CheckOptions options;
+    options.apiBaseUrl = base;
+    if (!qtgh::check_github_update("https://github.com/owner/repo", "1.0.0", options).hasUpdate
+        || upstreamRequests != 1) {
+        std::cerr << "Check through the proxy was not served from cache\n";
+        ok = false;
+    }
+
+    // Expired entry: revalidated upstream with If-None-Match
+    proxy.setTtl(std::chrono::seconds(0));
+    if (!qtgh::check_github_update("https://github.com/owner/repo", "1.0.0", options).hasUpdate
+        || upstreamConditional != 1 || proxy.stats().revalidated != 1) {
+        std::cerr << "Stale entry was not revalidated\n";
+        ok = false;
+    }
+
+    // One cache hit (library check), four coalesced waiters
+    if (proxy.stats().hits < 1 || proxy.stats().coalesced != 4) {
+        std::cerr << "Unexpected proxy statistics\n";
+        ok = false;
+    }
+
+    // HEAD: headers of the cached response with its real Content-Length
+    {
+        proxy.setTtl(std::chrono::minutes(5));
+        QNetworkReply* get = mgr.get(QNetworkRequest(url));
+        QNetworkReply* head = mgr.head(QNetworkRequest(url));
+        int done = 0;
+        QEventLoop wait;
+        for (auto* reply : {get, head})
+            QObject::connect(reply, &QNetworkReply::finished, &wait, [&] {
+                if (++done == 2)
+                    wait.quit();
+            });
+        wait.exec();
+        const QByteArray body = get->readAll();
+        if (head->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() != 200 || body.isEmpty()
+            || head->header(QNetworkRequest::ContentLengthHeader).toLongLong() != body.size()
+            || !head->readAll().isEmpty()) {
+            std::cerr << "HEAD response does not describe the cached body\n";
+            ok = false;
+        }
+        get->deleteLater();
+        head->deleteLater();
+    }
+
+    // Upstream outage with a stale entry: served stale, upstream retried only
+    // after the retry interval
+    {
+        proxy.setTtl(std::chrono::seconds(0));
+        proxy.setRetryInterval(std::chrono::minutes(1));
+        upstreamDown = true;
+        const int before = upstreamRequests;
+        bool stale = true;
+        for (int i = 0; i < 3; ++i) {
+            QNetworkReply* reply = mgr.get(QNetworkRequest(url));
+            QEventLoop wait;
+            QObject::connect(reply, &QNetworkReply::finished, &wait, &QEventLoop::quit);
+            wait.exec();
+            stale = stale && reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() == 200
+                    && qtgh::parseRelease(reply->readAll()).tag == "v2.0.0";
+            reply->deleteLater();
+        }
+        if (!stale || upstreamRequests != before + 1 || proxy.stats().staleServed != 3) {
+            std::cerr << "Stale entry was not served, or upstream was retried during the outage\n";
+            ok = false;
+        }
+        upstreamDown = false;
+        proxy.setTtl(std::chrono::minutes(5));
+    }
+
+    // Upstream failure with nothing cached: every waiter sees the upstream status
+    {
+        const qsizetype entries = proxy.cachedEntries();
+        const QUrl broken(base + "/repos/owner/broken/releases/latest");
+        QList<QNetworkReply*> failing{mgr.get(QNetworkRequest(broken)), mgr.get(QNetworkRequest(broken))};
+        int done = 0;
+        QEventLoop wait;
+        for (auto* reply : failing)
+            QObject::connect(reply, &QNetworkReply::finished, &wait, [&] {
+                if (++done == failing.size())
+                    wait.quit();
+            });
+        wait.exec();
+        for (auto* reply : failing) {
+            if (reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() != 500
+                || !reply->readAll().contains("Server Error")) {
+                std::cerr << "Upstream failure was not passed through\n";
+                ok = false;
+            }
+            reply->deleteLater();
+        }
+        if (proxy.stats().coalesced != 5 || proxy.cachedEntries() != entries) {
+            std::cerr << "Failed request was not coalesced or left a cache entry\n";
+            ok = false;
+        }
+    }
+
+    // Bounded cache: a new repository evicts the least recently fetched entry
+    {
+        proxy.setMaxEntries(2);
+        const qsizetype entries = proxy.cachedEntries();
+        for (const char* repo : {"one", "two"}) {
+            QNetworkReply* reply = mgr.get(QNetworkRequest(QUrl(base + "/repos/other/" + repo + "/releases/latest")));
+            QEventLoop wait;
+            QObject::connect(reply, &QNetworkReply::finished, &wait, &QEventLoop::quit);
+            wait.exec();
+            reply->deleteLater();
+        }
+        if (entries != 1 || proxy.cachedEntries() != 2 || proxy.stats().evicted != 1) {
+            std::cerr << "Cache grew beyond maxEntries() or evicted the wrong number of entries\n";
+            ok = false;
+        }
+    }
+
+    return ok ? 0 : 1;
+}
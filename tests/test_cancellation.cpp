@@ -0,0 +1,158 @@
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QTimer>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include "qt_gh-batch-checker.hpp"
+#include "qt_gh-http-server.hpp"
+
+int main(int argc, char** argv) {
+    QCoreApplication app(argc, argv);
+    bool ok = true;
+    auto expect = [&ok](bool condition, const char* what) {
+        if (!condition) {
+            std::cerr << "FAILED: " << what << "\n";
+            ok = false;
+        }
+    };
+
+    // Local API: repositories named "slow-*" never answer
+    int requests = 0;
+    QList<qtgh::HttpServer::Responder> hung;
+    qtgh::HttpServer api([&](const qtgh::HttpRequest& req, qtgh::HttpServer::Responder respond) {
+        ++requests;
+        if (req.path.contains("/slow-")) {
+            hung.append(std::move(respond));
+            return;
+        }
+        respond({200, "application/json", {},
+                 R"({"tag_name":"v2.0.0","published_at":"2026-01-01T00:00:00Z"})"});
+    });
+    if (!api.listen()) {
+        std::cerr << "listen failed\n";
+        return 1;
+    }
+    const QString base = QStringLiteral("http://127.0.0.1:%1").arg(api.serverPort());
+
+    // Synchronous path, stopped from another thread and from a timer on the
+    // blocked thread itself
+    auto cancelSync = [&](auto&& requestStop) {
+        std::stop_source source;
+        qtgh::CheckOptions options;
+        options.apiBaseUrl = base;
+        options.stopToken = source.get_token();
+        requestStop(source);
+        QElapsedTimer timer;
+        timer.start();
+        try {
+            qtgh::check_github_update("https://github.com/owner/slow-sync", "1.0.0", options);
+            return qint64(-1);
+        } catch (const qtgh::CancelledError&) {
+            return timer.elapsed();
+        } catch (const std::exception& e) {
+            std::cerr << "Unexpected error: " << e.what() << "\n";
+            return qint64(-1);
+        }
+    };
+    std::thread stopper;
+    const qint64 fromThread = cancelSync([&](std::stop_source& source) {
+        stopper = std::thread([source]() mutable {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            source.request_stop();
+        });
+    });
+    stopper.join();
+    expect(fromThread >= 0 && fromThread < 2000, "stop from another thread cancels the request");
+    const qint64 fromTimer = cancelSync([](std::stop_source& source) {
+        QTimer::singleShot(100, [source]() mutable { source.request_stop(); });
+    });
+    expect(fromTimer >= 0 && fromTimer < 2000, "stop from the blocked thread cancels the request");
+
+    // A token stopped up front sends no request at all
+    {
+        const int before = requests;
+        std::stop_source source;
+        source.request_stop();
+        qtgh::CheckOptions options;
+        options.apiBaseUrl = base;
+        options.stopToken = source.get_token();
+        bool cancelled = false;
+        try {
+            qtgh::check_github_update("https://github.com/owner/fast", "1.0.0", options);
+        } catch (const qtgh::CancelledError&) {
+            cancelled = true;
+        }
+        expect(cancelled && requests == before, "pre-stopped token sends no request");
+    }
+
+    // Batch path under load: 48 hung jobs with 8 request slots. Cancel some
+    // jobs one by one (running and queued), then the whole checker.
+    {
+        constexpr int kJobs = 48;
+        std::stop_source all;
+        qtgh::CheckOptions options;
+        options.apiBaseUrl = base;
+        options.stopToken = all.get_token();
+        qtgh::BatchChecker checker(8);
+        checker.setOptions(options);
+
+        QHash<QString, int> deliveries;
+        QHash<QString, qtgh::BatchStatus> statuses;
+        checker.setResultHandler([&](const qtgh::BatchResult& r) {
+            const QString name = r.job.repoUrl.section('/', -1);
+            ++deliveries[name];
+            statuses.insert(name, r.status);
+        });
+
+        const int before = requests;
+        std::vector<std::stop_source> perJob(kJobs);
+        for (int i = 0; i < kJobs; ++i) {
+            qtgh::BatchJob job{QStringLiteral("https://github.com/owner/slow-%1").arg(i), "1.0.0",
+                               {}};
+            job.stopToken = perJob[i].get_token();
+            checker.enqueue(std::move(job));
+        }
+        expect(checker.inFlight() == 8 && checker.pending() == kJobs - 8, "requests are queued");
+
+        // Jobs 0..3 are running, 20..23 are queued
+        QTimer::singleShot(100, [&] {
+            for (int i : {0, 1, 2, 3, 20, 21, 22, 23})
+                perJob[i].request_stop();
+        });
+        // Cancel everything else from another thread
+        std::thread cancelAll([all]() mutable {
+            std::this_thread::sleep_for(std::chrono::milliseconds(300));
+            all.request_stop();
+        });
+        QElapsedTimer timer;
+        timer.start();
+        checker.waitForFinished();  // no closeInput(): the stop alone ends the batch
+        cancelAll.join();
+
+        expect(timer.elapsed() < 5000, "checker-wide stop ends the batch promptly");
+        expect(checker.isFinished() && checker.inFlight() == 0 && checker.pending() == 0,
+               "nothing is left running after the stop");
+        bool exactlyOnce = deliveries.size() == kJobs;
+        for (int count : deliveries)
+            exactlyOnce = exactlyOnce && count == 1;
+        expect(exactlyOnce, "every job is delivered exactly once");
+        bool allCancelled = statuses.size() == kJobs;
+        for (auto status : statuses)
+            allCancelled = allCancelled && status == qtgh::BatchStatus::Cancelled;
+        expect(allCancelled, "every job is reported as cancelled");
+        // 8 initial requests plus the 4 that took over the cancelled slots;
+        // the queued jobs cancelled one by one never reach the server
+        expect(requests - before <= 12, "cancelled queued jobs send no request");
+
+        QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+        expect(checker.openReplies() == 0, "no QNetworkReply is leaked");
+
+        // Later jobs are cancelled immediately
+        checker.enqueue({"https://github.com/owner/late", "1.0.0", {}});
+        expect(statuses.value("late") == qtgh::BatchStatus::Cancelled,
+               "jobs enqueued after the stop are cancelled immediately");
+    }
+
+    return ok ? 0 : 1;
+}
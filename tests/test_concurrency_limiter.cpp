@@ -0,0 +1,110 @@
+#include <iostream>
+#include <vector>
+#include "qt_gh-concurrency-limiter.hpp"
+
+using namespace std::chrono_literals;
+
+int main() {
+    bool ok = true;
+    auto expect = [&ok](bool condition, const char* what) {
+        if (!condition) {
+            std::cerr << "FAILED: " << what << "\n";
+            ok = false;
+        }
+    };
+
+    // Multiplicative decrease, at most once per window
+    {
+        qtgh::AimdLimiter limiter;
+        expect(limiter.limit() == 4, "initial limit is 4");
+        const auto first = limiter.ticket();
+        limiter.onOverload(first);
+        expect(limiter.limit() == 2, "overload halves the limit");
+        limiter.onOverload(first);
+        expect(limiter.limit() == 2, "overloads from the same window cut only once");
+        limiter.onOverload(limiter.ticket());
+        limiter.onOverload(limiter.ticket());
+        expect(limiter.limit() == 1, "limit never drops below minLimit");
+        expect(limiter.stats().overloads == 4 && limiter.stats().decreases == 3,
+               "overloads and decreases are counted");
+    }
+
+    // Additive increase: 1/limit per success, about one request per full window
+    {
+        qtgh::AimdLimiter limiter;
+        for (int i = 0; i < 4; ++i)
+            limiter.onSuccess(limiter.ticket(), 10ms, limiter.limit());
+        expect(limiter.limit() == 4, "a window of 4 grows by less than one in 4 successes");
+        limiter.onSuccess(limiter.ticket(), 10ms, limiter.limit());
+        expect(limiter.limit() == 5, "the fifth saturated success raises the limit to 5");
+
+        for (int i = 0; i < 100; ++i)
+            limiter.onSuccess(limiter.ticket(), 10ms, 1);
+        expect(limiter.limit() == 5, "an unused limit does not grow");
+    }
+
+    // Clamped to maxLimit
+    {
+        qtgh::AimdLimiter::Config config;
+        config.maxLimit = 6;
+        qtgh::AimdLimiter limiter(config);
+        for (int i = 0; i < 1000; ++i)
+            limiter.onSuccess(limiter.ticket(), 10ms, limiter.limit());
+        expect(limiter.limit() == 6, "limit stops at maxLimit");
+    }
+
+    // Latency spikes relative to the baseline cut the limit
+    {
+        qtgh::AimdLimiter limiter;
+        for (int i = 0; i < 8; ++i)
+            limiter.onSuccess(limiter.ticket(), 10ms, 1);
+        expect(limiter.baselineLatency() == 10ms, "baseline is the minimum latency");
+        limiter.onSuccess(limiter.ticket(), 15ms, 1);
+        expect(limiter.limit() == 4, "latency within tolerance keeps the limit");
+        limiter.onSuccess(limiter.ticket(), 30ms, 1);
+        expect(limiter.limit() == 2 && limiter.stats().latencySpikes == 1,
+               "latency above twice the baseline halves the limit");
+    }
+
+    // Closed loop against a server that answers 429 above 20 concurrent requests:
+    // the limit saw-tooths just below the capacity and rarely overshoots
+    {
+        constexpr int kCapacity = 20;
+        qtgh::AimdLimiter limiter;
+        std::vector<int> limits;
+        int requests = 0;
+        int rejected = 0;
+        for (int round = 0; round < 300; ++round) {
+            const int window = limiter.limit();
+            const auto ticket = limiter.ticket();
+            for (int i = 0; i < window; ++i) {
+                ++requests;
+                if (i >= kCapacity) {
+                    ++rejected;
+                    limiter.onOverload(ticket);
+                } else {
+                    limiter.onSuccess(ticket, 10ms, window);
+                }
+            }
+            if (round >= 100)
+                limits.push_back(window);
+        }
+
+        int low = kCapacity;
+        int high = 0;
+        double mean = 0;
+        for (int limit : limits) {
+            low = std::min(low, limit);
+            high = std::max(high, limit);
+            mean += limit;
+        }
+        mean /= static_cast<double>(limits.size());
+        std::cout << "Simulated capacity " << kCapacity << ": limit " << low << ".." << high
+                  << ", mean " << mean << ", " << rejected << "/" << requests << " rejected\n";
+        expect(low >= kCapacity / 2 && high <= kCapacity + 1, "limit stays around the capacity");
+        expect(mean >= 0.6 * kCapacity, "mean limit uses most of the capacity");
+        expect(rejected * 50 < requests, "fewer than 2% of the requests are rejected");
+    }
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,94 @@
+#include <iostream>
+#include <string>
+#include "qt_gh-core.hpp"
+
+using namespace qtgh::core;
+
+int main() {
+    bool ok = true;
+    auto expect = [&ok](bool condition, const char* what) {
+        if (!condition) {
+            std::cerr << "FAILED: " << what << "\n";
+            ok = false;
+        }
+    };
+
+    // Versions
+    expect(parseVersion("1.2.3") == Version{1, 2, 3}, "plain version");
+    expect(parseVersion("release-v1.2") == Version{1, 2, 0}, "prefix, patch defaults to 0");
+    expect(parseVersion("build 7, version 10.20.30-rc1") == Version{10, 20, 30},
+           "first dotted number wins");
+    expect(parseVersion("99999999999.1.0").major == 0, "overflowing numbers read as 0");
+    expect(!findVersion(std::string_view("nightly")) && !findVersion(std::string_view("1.")),
+           "no version");
+    expect(findVersion(std::u16string_view(u"v2.0.1")) == Version{2, 0, 1}, "UTF-16 input");
+    expect(Version{1, 10, 0} > Version{1, 9, 9}, "numeric comparison");
+    expect(isNewer("v2.0.0", "1.9.9") && !isNewer("v1.0.0", "1.0.0"), "isNewer");
+    bool threw = false;
+    try {
+        parseVersion("latest");
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    expect(threw, "parseVersion throws without a version");
+
+    // Repository URLs
+    expect(repoSlug("https://github.com/NLohmann/JSON.git") == "nlohmann/json", "web URL slug");
+    expect(repoSlug("git@github.com:owner/repo.git") == "owner/repo", "SSH URL slug");
+    expect(repoSlug("https://api.github.com/repos/Owner/Repo/releases/latest") == "owner/repo",
+           "API URL slug");
+    expect(repoSlug("https://github.com/owner/repo?tab=readme#top") == "owner/repo",
+           "query and fragment are not part of the slug");
+    expect(!repoSlug("https://gitlab.com/owner/repo") && !repoSlug("https://github.com/owner"),
+           "no repository");
+    expect(findRepoSlug(std::u16string_view(u"github.com/o\u00a0x/r")) == std::nullopt,
+           "Unicode spaces end a name in UTF-16 input");
+    expect(apiUrl("https://github.com/owner/repo.git")
+               == "https://api.github.com/repos/owner/repo/releases/latest",
+           "API URL of a web URL");
+    expect(apiUrl("https://github.com/owner/repo", "http://127.0.0.1:8080")
+               == "http://127.0.0.1:8080/repos/owner/repo/releases/latest",
+           "API URL against another base");
+    expect(apiUrl("https://api.github.com/repos/o/r") == "https://api.github.com/repos/o/r",
+           "API URLs are returned unchanged");
+    expect(!apiUrl("git@github.com:owner/repo.git"), "only web URLs map to API URLs");
+
+    // Release JSON
+    const auto release = extractRelease(R"({
+        "url": "https://api.github.com/repos/o/r/releases/1",
+        "assets": [{"name": "a.tar.gz", "size": 1024, "draft": false, "x": null}],
+        "tag_name": "v1.2.3",
+        "body": "Fixes \"quoting\" \\ and \u00e9\ud83d\ude00",
+        "prerelease": false,
+        "id": -12.5e+3,
+        "published_at": "2026-01-01T00:00:00Z"
+    })");
+    expect(release && release->tag == "v1.2.3"
+               && release->publishedAt == "2026-01-01T00:00:00Z" && !release->message,
+           "release fields");
+    const auto escaped = extractRelease(R"({"tag\u005fname":"v\u00e9\ud83d\ude00\n"})");
+    expect(escaped && escaped->tag == "v\xc3\xa9\xf0\x9f\x98\x80\n", "escapes decoded to UTF-8");
+    const auto error = extractRelease(R"({"message":"Not Found","documentation_url":"x"})");
+    expect(error && !error->tag && error->message == "Not Found", "API error message");
+    const auto repeated = extractRelease(R"({"tag_name":"v1","tag_name":2})");
+    expect(repeated && !repeated->tag, "last occurrence counts, non-strings are absent");
+    expect(extractRelease("{}") && extractRelease(" \n{ } \t"), "empty object");
+    for (const char* invalid : {"", "[]", "\"v1\"", "{", "{\"a\":}", "{\"a\":1,}", "{} x",
+                                "{\"a\":01}", "{\"a\":1.}", "{\"a\":tru}", "{\"a\":\"\x01\"}",
+                                "{\"a\":\"\\x\"}", "{\"a\":\"\xc3\"}", "{\"a\":\"\xed\xa0\x80\"}",
+                                "{'a':1}"}) {
+        if (extractRelease(invalid)) {
+            std::cerr << "FAILED: accepted invalid JSON: " << invalid << "\n";
+            ok = false;
+        }
+    }
+    std::string deep = "{\"a\":";
+    for (int i = 0; i < 2000; ++i)
+        deep += '[';
+    for (int i = 0; i < 2000; ++i)
+        deep += ']';
+    deep += '}';
+    expect(!extractRelease(deep), "nesting is limited");
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,226 @@
+#include <QCoreApplication>
+#include <QEventLoop>
+#include <QRandomGenerator>
+#include <QTemporaryDir>
+#include <iostream>
+#include "qt_gh-delta-download.hpp"
+#include "qt_gh-http-server.hpp"
+
+static QByteArray randomBytes(qsizetype size, quint32 seed) {
+    QByteArray data(size, Qt::Uninitialized);
+    QRandomGenerator rng(seed);
+    for (qsizetype i = 0; i < size; ++i)
+        data[i] = static_cast<char>(rng.bounded(256));
+    return data;
+}
+
+static const uchar* bytes(const QByteArray& data) { return reinterpret_cast<const uchar*>(data.constData()); }
+
+static bool writeFile(const QString& path, const QByteArray& data) {
+    QFile file(path);
+    return file.open(QIODevice::WriteOnly) && file.write(data) == data.size();
+}
+
+static QByteArray readFile(const QString& path) {
+    QFile file(path);
+    return file.open(QIODevice::ReadOnly) ? file.readAll() : QByteArray();
+}
+
+/// Run the event loop until `done` is set (at most 20 s)
+static void waitFor(const bool& done) {
+    QEventLoop loop;
+    QTimer poll;
+    QObject::connect(&poll, &QTimer::timeout, &loop, [&] {
+        if (done)
+            loop.quit();
+    });
+    poll.start(5);
+    QTimer::singleShot(20000, &loop, &QEventLoop::quit);
+    loop.exec();
+}
+
+int main(int argc, char** argv) {
+    QCoreApplication app(argc, argv);
+    bool ok = true;
+    auto expect = [&ok](bool condition, const char* what) {
+        if (!condition) {
+            std::cerr << "FAILED: " << what << "\n";
+            ok = false;
+        }
+    };
+    constexpr int kBlock = qtgh::BlockManifest::kDefaultBlockSize;
+
+    // Two versions: 10 bytes patched at 100 KiB, 777 bytes inserted at 500 KiB,
+    // 3000 bytes removed at 800 KiB; the short last block is unchanged
+    const QByteArray v1 = randomBytes(1024 * 1024 + 1000, 1);
+    QByteArray v2 = v1;
+    v2.replace(800 * 1024, 3000, QByteArray());
+    v2.insert(500 * 1024, randomBytes(777, 2));
+    v2.replace(100 * 1024, 10, randomBytes(10, 3));
+
+    // Rolling checksum
+    {
+        const QByteArray data = randomBytes(3 * kBlock, 4);
+        qtgh::RollingChecksum sum(bytes(data), kBlock);
+        bool same = true;
+        for (qsizetype pos = 1; pos + kBlock <= data.size(); ++pos) {
+            sum.roll(bytes(data)[pos - 1], bytes(data)[pos + kBlock - 1]);
+            same = same && sum.value() == qtgh::RollingChecksum(bytes(data) + pos, kBlock).value();
+        }
+        expect(same, "rolled checksum equals the checksum of the window");
+    }
+
+    // Manifest
+    const auto manifest = qtgh::buildBlockManifest(bytes(v2), v2.size());
+    {
+        expect(manifest.length == v2.size() && manifest.blockCount() == (v2.size() + kBlock - 1) / kBlock,
+               "manifest covers the file");
+        expect(manifest.sha256 == QCryptographicHash::hash(v2, QCryptographicHash::Sha256),
+               "manifest has the file's SHA-256");
+        const auto single = qtgh::buildBlockManifest(bytes(v2), v2.size(), kBlock, 1);
+        expect(single.weak == manifest.weak && single.strong == manifest.strong,
+               "hashing in parallel gives the same checksums");
+        const auto parsed = qtgh::BlockManifest::fromCbor(manifest.toCbor());
+        expect(parsed.length == manifest.length && parsed.weak == manifest.weak
+                   && parsed.strong == manifest.strong && parsed.sha256 == manifest.sha256,
+               "manifest survives CBOR");
+        bool threw = false;
+        try {
+            qtgh::BlockManifest::fromCbor("not cbor");
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        expect(threw, "garbage is not a manifest");
+    }
+
+    // Plan: only the blocks around the three edits are missing
+    {
+        const auto plan = qtgh::planDelta(manifest, bytes(v1), v1.size());
+        const auto ranges = plan.missingRanges(manifest);
+        qint64 missing = 0;
+        for (const auto& range : ranges)
+            missing += range.length;
+        std::cerr << "plan: " << ranges.size() << " ranges, " << missing << " bytes missing\n";
+        expect(ranges.size() == 3 && missing <= 6 * kBlock, "only edited blocks are missing");
+        expect(plan.reusedBytes + missing == v2.size(), "reused and missing bytes add up");
+        expect(plan.source.back() == v1.size() - manifest.blockLength(manifest.blockCount() - 1),
+               "unchanged short last block is reused");
+        const auto single = qtgh::planDelta(manifest, bytes(v1), v1.size(), 1);
+        expect(single.source == plan.source, "scanning in parallel finds the same blocks");
+        expect(plan.missingRanges(manifest, 2 * kBlock).size() >= ranges.size()
+                   && plan.missingRanges(manifest, kBlock).size() == missing / kBlock + (missing % kBlock != 0),
+               "ranges are split at the length limit");
+        const auto none = qtgh::planDelta(manifest, nullptr, 0);
+        expect(none.reusedBytes == 0 && none.missingRanges(manifest) == QList<qtgh::ByteRange>{{0, v2.size()}},
+               "without an old file everything is missing");
+    }
+
+    // Local server: /v2.bin with Range support and its manifest; /plain.bin ignores
+    // Range; /broken.bin answers ranges with the wrong data
+    const QByteArray manifestData = manifest.toCbor();
+    int requests = 0;
+    qtgh::HttpServer server([&](const qtgh::HttpRequest& req, qtgh::HttpServer::Responder respond) {
+        ++requests;
+        if (req.path == "/v2.bin.blocksums") {
+            respond({200, "application/cbor", {}, manifestData});
+            return;
+        }
+        if (req.path != "/v2.bin" && req.path != "/plain.bin" && req.path != "/broken.bin") {
+            respond({404, "text/plain", {}, "not found"});
+            return;
+        }
+        const QByteArray range = req.header("range");
+        if (req.path == "/plain.bin" || !range.startsWith("bytes=")) {
+            respond({200, "application/octet-stream", {}, v2});
+            return;
+        }
+        const auto bounds = range.mid(6).split('-');
+        const qint64 first = bounds.value(0).toLongLong();
+        const qint64 last = std::min<qint64>(bounds.value(1).toLongLong(), v2.size() - 1);
+        QByteArray body = v2.mid(first, last - first + 1);
+        if (req.path == "/broken.bin")
+            body[0] = static_cast<char>(body[0] ^ 1);
+        respond({206, "application/octet-stream",
+                 {{"Content-Range", "bytes " + QByteArray::number(first) + "-" + QByteArray::number(last)
+                                        + "/" + QByteArray::number(v2.size())}},
+                 body});
+    });
+    if (!server.listen()) {
+        std::cerr << "listen failed\n";
+        return 1;
+    }
+    const QString base = QStringLiteral("http://127.0.0.1:%1").arg(server.serverPort());
+
+    QTemporaryDir dir;
+    const QString installed = dir.filePath("app.bin");
+    writeFile(installed, v1);
+
+    qtgh::DeltaDownloader delta;
+    qtgh::DeltaResult result;
+    bool done = false;
+    auto handler = [&](const qtgh::DeltaResult& r) {
+        result = r;
+        done = true;
+    };
+
+    // Update in place from v1
+    {
+        requests = 0;
+        delta.update({base + "/v2.bin.blocksums", base + "/v2.bin", installed, installed}, handler);
+        waitFor(done);
+        std::cerr << "delta: " << result.rangeRequests << " ranges, " << result.fetchedBytes << " of "
+                  << result.length << " bytes fetched, " << result.manifestBytes << " manifest bytes\n";
+        expect(done && result.error.isEmpty(), "delta update succeeds");
+        expect(readFile(installed) == v2, "rebuilt file is the new version");
+        expect(result.rangeRequests == 3 && requests == 4, "one request per missing range");
+        expect(result.fetchedBytes <= 6 * kBlock && result.reusedBytes + result.fetchedBytes == v2.size(),
+               "only the missing blocks are fetched");
+        expect(!QFile::exists(installed + ".part"), "part file is renamed");
+    }
+
+    // No old file, small ranges: every block is fetched
+    {
+        done = false;
+        delta.setMaxRangeLength(256 * 1024);
+        delta.setParallelRanges(2);
+        const QString target = dir.filePath("fresh.bin");
+        delta.update({base + "/v2.bin.blocksums", base + "/v2.bin", dir.filePath("missing.bin"), target},
+                     handler);
+        waitFor(done);
+        expect(done && result.error.isEmpty() && readFile(target) == v2, "update without an old file succeeds");
+        expect(result.fetchedBytes == v2.size() && result.rangeRequests == 4, "all blocks are fetched in ranges");
+        delta.setMaxRangeLength(qtgh::DeltaDownloader::kMaxRangeLength);
+    }
+
+    // Known manifest, old file already up to date: nothing is fetched
+    {
+        done = false;
+        requests = 0;
+        delta.update({{}, base + "/v2.bin", installed, installed}, manifest, handler);
+        waitFor(done);
+        expect(done && result.error.isEmpty() && result.rangeRequests == 0 && requests == 0,
+               "up-to-date file needs no requests");
+    }
+
+    // Errors leave the target untouched
+    {
+        writeFile(installed, v1);
+        for (const char* path : {"/plain.bin", "/broken.bin", "/missing.bin"}) {
+            done = false;
+            delta.update({base + "/v2.bin.blocksums", base + path, installed, installed}, handler);
+            waitFor(done);
+            std::cerr << path << ": " << result.error.toStdString() << "\n";
+            expect(done && !result.error.isEmpty(), "failed update reports an error");
+            expect(readFile(installed) == v1 && !QFile::exists(installed + ".part"),
+                   "failed update leaves the old file");
+        }
+        expect(result.error.contains("404") || result.error.contains("Network error"), "HTTP errors are reported");
+        done = false;
+        delta.update({base + "/missing.blocksums", base + "/v2.bin", installed, installed}, handler);
+        waitFor(done);
+        expect(done && result.error.startsWith("Block manifest"), "missing manifest is reported");
+        expect(delta.active() == 0, "no updates left");
+    }
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,96 @@
+#include <QCoreApplication>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QTemporaryDir>
+#include <iostream>
+#include <mutex>
+#include "qt_gh-manifest-scanner.hpp"
+
+static void writeFile(const QString& path, const QByteArray& content) {
+    QDir().mkpath(QFileInfo(path).absolutePath());
+    QFile f(path);
+    f.open(QIODevice::WriteOnly);
+    f.write(content);
+}
+
+int main(int argc, char** argv) {
+    QCoreApplication app(argc, argv);
+
+    QTemporaryDir dir;
+    if (!dir.isValid())
+        return 1;
+
+    writeFile(dir.filePath("CMakeLists.txt"),
+              "# FetchContent_Declare(old GIT_REPOSITORY https://github.com/no/no GIT_TAG 0.1)\n"
+              "FetchContent_Declare(\n"
+              "    json\n"
+              "    GIT_REPOSITORY https://github.com/nlohmann/json.git\n"
+              "    GIT_TAG v3.11.2\n"
+              ")\n"
+              "CPMAddPackage(\"gh:gabime/spdlog@1.12.0\")\n");
+    writeFile(dir.filePath("ports/catch2/portfile.cmake"),
+              "vcpkg_from_github(OUT_SOURCE_PATH SOURCE_PATH REPO catchorg/Catch2 REF v3.4.0)\n");
+    writeFile(dir.filePath("ports/x/vcpkg.json"),
+              R"({"name": "x", "version": "2.0.1", "homepage": "https://github.com/owner/x"})");
+    writeFile(dir.filePath("recipes/zlib/conanfile.py"),
+              "class Zlib(ConanFile):\n    version = \"1.3.0\"\n    url = \"https://github.com/madler/zlib\"\n");
+    writeFile(dir.filePath(".gitmodules"),
+              "[submodule \"gtest\"]\n\tpath = ext/gtest\n\turl = git@github.com:google/googletest.git\n");
+    // Malformed owner/repo slugs are skipped instead of producing invalid URLs
+    writeFile(dir.filePath("ports/bad/portfile.cmake"),
+              "vcpkg_from_github(OUT_SOURCE_PATH SOURCE_PATH REPO /x REF v1.0)\n"
+              "vcpkg_from_github(OUT_SOURCE_PATH SOURCE_PATH REPO owner/ REF v1.0)\n");
+    writeFile(dir.filePath("cmake/bad.cmake"),
+              "CPMAddPackage(\"gh:owner/@1.0\")\n"
+              "CPMAddPackage(NAME y GITHUB_REPOSITORY \"own er/y\" VERSION 1.0)\n");
+    writeFile(dir.filePath(".git/modules/CMakeLists.txt"),
+              "FetchContent_Declare(x GIT_REPOSITORY https://github.com/hidden/x GIT_TAG 1.0)\n");
+
+    std::mutex mutex;
+    QHash<QString, qtgh::ManifestEntry> found;
+    qtgh::ManifestScanner scanner(4);
+    const auto stats = scanner.scan(dir.path(), [&](const qtgh::ManifestEntry& e) {
+        std::lock_guard lock(mutex);
+        found.insert(e.repoUrl, e);
+    });
+
+    const QList<QPair<QString, QString>> expected = {
+        {"https://github.com/nlohmann/json", "v3.11.2"},
+        {"https://github.com/gabime/spdlog", "1.12.0"},
+        {"https://github.com/catchorg/Catch2", "v3.4.0"},
+        {"https://github.com/owner/x", "2.0.1"},
+        {"https://github.com/madler/zlib", "1.3.0"},
+        {"https://github.com/google/googletest", ""},
+    };
+
+    bool ok = found.size() == expected.size() && stats.entries == std::size_t(expected.size());
+    for (const auto& [repo, version] : expected) {
+        if (!found.contains(repo) || found.value(repo).version != version) {
+            std::cerr << "Missing or wrong entry: " << repo.toStdString() << "\n";
+            ok = false;
+        }
+    }
+    if (found.value("https://github.com/nlohmann/json").line != 2) {
+        std::cerr << "Wrong line number for nlohmann/json\n";
+        ok = false;
+    }
+
+    // An exception from the sink stops the walk and is rethrown by scan()
+    bool rethrown = false;
+    try {
+        qtgh::ManifestScanner(4).scan(dir.path(), [](const qtgh::ManifestEntry&) {
+            throw std::runtime_error("sink failed");
+        });
+    } catch (const std::runtime_error& e) {
+        rethrown = std::string(e.what()) == "sink failed";
+    }
+    if (!rethrown) {
+        std::cerr << "Sink exception was not rethrown by scan()\n";
+        ok = false;
+    }
+
+    std::cout << "Scanned " << stats.files << " files, " << stats.entries << " entries\n";
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,178 @@
+#include <QCoreApplication>
+#include <QTemporaryDir>
+#include <iostream>
+#include "qt_gh-batch-checker.hpp"
+#include "qt_gh-http-server.hpp"
+
+using namespace std::chrono_literals;
+
+int main(int argc, char** argv) {
+    QCoreApplication app(argc, argv);
+    bool ok = true;
+    auto expect = [&ok](bool condition, const char* what) {
+        if (!condition) {
+            std::cerr << "FAILED: " << what << "\n";
+            ok = false;
+        }
+    };
+
+    // Backoff per repository: base delay of the kind, doubled per failure
+    {
+        qtgh::ReleaseCache cache;
+        const QDateTime t0 = QDateTime::fromString("2026-01-01T00:00:00Z", Qt::ISODate);
+        auto first = cache.recordFailure("o/gone", qtgh::FailureKind::NotFound, "Not Found", t0);
+        expect(first.failures == 1 && first.retryAt == t0.addSecs(6 * 3600),
+               "first 404 is cached for 6 hours");
+        expect(cache.lookupFailure("o/gone", t0.addSecs(3600)).has_value(),
+               "failure is served before retryAt");
+        expect(!cache.lookupFailure("o/gone", t0.addSecs(6 * 3600)).has_value(),
+               "failure expires at retryAt");
+        auto second = cache.recordFailure("o/gone", qtgh::FailureKind::NotFound, "Not Found",
+                                          first.retryAt);
+        expect(second.failures == 2 && second.retryAt == first.retryAt.addSecs(12 * 3600),
+               "second failure doubles the delay");
+
+        qtgh::FailureBackoff backoff;
+        expect(backoff.delay(qtgh::FailureKind::NoRelease, 1) == 1h
+                   && backoff.delay(qtgh::FailureKind::Unavailable, 100) == backoff.maxDelay,
+               "delay per kind, capped at maxDelay");
+
+        qtgh::ReleaseRecord release;
+        release.tag = "v1.0.0";
+        release.expiresAt = t0.addDays(1);
+        cache.store("o/gone", release);
+        expect(cache.failureCount() == 0, "a release clears the failure");
+        expect(cache.recordFailure("o/gone", qtgh::FailureKind::NotFound, "x", t0).failures == 1,
+               "consecutive count restarts after a success");
+
+        backoff.enabled = false;
+        cache.setFailureBackoff(backoff);
+        cache.recordFailure("o/other", qtgh::FailureKind::NotFound, "x", t0);
+        expect(!cache.lookupFailure("o/other", t0).has_value(), "disabled backoff caches nothing");
+    }
+
+    // Local API with one repository per failure kind; requests are counted
+    int requests = 0;
+    qtgh::HttpServer api([&](const qtgh::HttpRequest& req, qtgh::HttpServer::Responder respond) {
+        ++requests;
+        if (req.path.contains("/gone/"))
+            respond({404, "application/json", {}, R"({"message":"Not Found"})"});
+        else if (req.path.contains("/blocked/"))
+            respond({451, "application/json", {}, R"({"message":"Repository access blocked"})"});
+        else if (req.path.contains("/notag/"))
+            respond({200, "application/json", {}, R"({"message":"Moved Permanently"})"});
+        else if (req.path.contains("/nightly/"))
+            respond({200, "application/json", {}, R"({"tag_name":"nightly"})"});
+        else if (req.path.contains("/flaky/"))
+            respond({500, "application/json", {}, R"({"message":"Server Error"})"});
+        else
+            respond({200, "application/json", {},
+                     R"({"tag_name":"v2.0.0","published_at":"2026-01-01T00:00:00Z"})"});
+    });
+    if (!api.listen()) {
+        std::cerr << "listen failed\n";
+        return 1;
+    }
+
+    qtgh::ReleaseCache cache;
+    qtgh::CheckOptions options;
+    options.apiBaseUrl = QStringLiteral("http://127.0.0.1:%1").arg(api.serverPort());
+    options.cache = &cache;
+
+    // Synchronous path: the second call throws the same error without a request
+    const QHash<QString, qtgh::FailureKind> kinds{
+        {"gone", qtgh::FailureKind::NotFound},
+        {"blocked", qtgh::FailureKind::Unavailable},
+        {"notag", qtgh::FailureKind::NoRelease},
+        {"nightly", qtgh::FailureKind::UnparsableTag},
+    };
+    for (auto it = kinds.cbegin(); it != kinds.cend(); ++it) {
+        const QString url = "https://github.com/" + it.key() + "/repo";
+        QString messages[2];
+        bool cached[2] = {};
+        bool rightKind = true;
+        const int before = requests;
+        for (int call = 0; call < 2; ++call) {
+            try {
+                qtgh::check_github_update(url, "1.0.0", options);
+            } catch (const qtgh::CheckFailure& e) {
+                messages[call] = QString::fromUtf8(e.what());
+                cached[call] = e.fromCache();
+                rightKind = rightKind && e.kind() == it.value();
+            } catch (const std::exception& e) {
+                std::cerr << it.key().toStdString() << ": " << e.what() << "\n";
+            }
+        }
+        if (!rightKind || messages[0].isEmpty() || messages[0] != messages[1] || cached[0]
+            || !cached[1] || requests - before != 1) {
+            std::cerr << "FAILED: " << it.key().toStdString() << " is not negatively cached\n";
+            ok = false;
+        }
+    }
+
+    // Transient errors are not cached
+    for (int call = 0; call < 2; ++call) {
+        try {
+            qtgh::check_github_update("https://github.com/flaky/repo", "1.0.0", options);
+        } catch (const std::exception&) {
+        }
+    }
+    expect(!cache.lookupFailure("flaky/repo").has_value(), "a 500 is not cached");
+
+    // Once retryAt has passed the repository is tried again and backs off further
+    {
+        auto record = *cache.lookupFailure("gone/repo");
+        record.retryAt = QDateTime::currentDateTimeUtc().addSecs(-1);
+        cache.storeFailure("gone/repo", record);
+        const int before = requests;
+        try {
+            qtgh::check_github_update("https://github.com/gone/repo", "1.0.0", options);
+        } catch (const qtgh::CheckFailure&) {
+        }
+        const auto retried = cache.lookupFailure("gone/repo");
+        expect(requests - before == 1 && retried && retried->failures == 2,
+               "expired failure is retried and counted");
+    }
+
+    // Batch path: a second sweep over the same repositories sends no request
+    // for the known failures and reports them as cached
+    auto sweep = [&](qtgh::ReleaseCache& sweepCache, quint64* avoided) {
+        qtgh::CheckOptions sweepOptions = options;
+        sweepOptions.cache = &sweepCache;
+        qtgh::BatchChecker checker(4);
+        checker.setOptions(sweepOptions);
+        int cachedResults = 0;
+        checker.setResultHandler([&](const qtgh::BatchResult& r) {
+            cachedResults += r.cached && r.status == qtgh::BatchStatus::Failed ? 1 : 0;
+        });
+        for (const QString& owner : {"b-gone", "b-blocked", "b-notag", "b-nightly"}) {
+            const QString repo = owner.mid(2);
+            checker.enqueue({"https://github.com/" + repo + "/batch-" + owner, "1.0.0", {}});
+        }
+        checker.closeInput();
+        checker.waitForFinished();
+        *avoided = checker.cachedFailures();
+        return cachedResults;
+    };
+    qtgh::ReleaseCache batchCache;
+    quint64 avoided = 0;
+    int before = requests;
+    sweep(batchCache, &avoided);
+    expect(requests - before == 4 && avoided == 0 && batchCache.failureCount() == 4,
+           "first sweep checks and caches every failure");
+
+    // Persisted between runs like "scan --failure-cache"
+    QTemporaryDir dir;
+    const QString path = dir.filePath("failures.json");
+    QString error;
+    expect(batchCache.saveFailures(path, &error), "failures are saved");
+    qtgh::ReleaseCache reloaded;
+    expect(reloaded.loadFailures(path, &error) && reloaded.failureCount() == 4,
+           "failures are loaded");
+    before = requests;
+    const int cachedResults = sweep(reloaded, &avoided);
+    expect(requests == before && avoided == 4 && cachedResults == 4,
+           "second sweep avoids all requests for known failures");
+
+    return ok ? 0 : 1;
+}
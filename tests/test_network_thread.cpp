@@ -0,0 +1,212 @@
+#include <QAbstractEventDispatcher>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QThread>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include "qt_gh-http-server.hpp"
+#include "qt_gh-update-checker.hpp"
+
+namespace {
+
+constexpr int kThreads = 64;
+constexpr int kChecksPerThread = 20;
+
+/// Plain threads without a QCoreApplication: the network thread creates its
+/// own. Nothing listens on the port, so every request fails, through the
+/// future, with a network error.
+int runWithoutApplication() {
+    std::atomic<int> networkErrors{0};
+    std::atomic<int> unexpected{0};
+    std::vector<std::thread> callers;
+    for (int t = 0; t < kThreads; ++t) {
+        callers.emplace_back([&] {
+            for (int i = 0; i < 4; ++i) {
+                try {
+                    if (i % 2 == 0)
+                        qtgh::http_get("http://127.0.0.1:1/repos/o/r/releases/latest");
+                    else
+                        qtgh::NetworkThread::instance()
+                            .get("http://127.0.0.1:1/repos/o/r/releases/latest")
+                            .get();
+                    ++unexpected;
+                } catch (const std::runtime_error& e) {
+                    ++(std::strncmp(e.what(), "Network error", 13) == 0 ? networkErrors
+                                                                        : unexpected);
+                }
+            }
+        });
+    }
+    for (std::thread& caller : callers)
+        caller.join();
+
+    bool ok = true;
+    if (networkErrors != kThreads * 4 || unexpected != 0) {
+        std::cerr << "FAILED: " << networkErrors << " network errors, " << unexpected
+                  << " unexpected results without an application object\n";
+        ok = false;
+    }
+    if (!QCoreApplication::instance()) {
+        std::cerr << "FAILED: the network thread did not create an application object\n";
+        ok = false;
+    }
+    qtgh::NetworkThread::instance().shutdown();
+    return ok ? 0 : 1;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc > 1 && std::strcmp(argv[1], "--no-app") == 0)
+        return runWithoutApplication();
+
+    QCoreApplication app(argc, argv);
+    bool ok = true;
+    auto expect = [&ok](bool condition, const char* what) {
+        if (!condition) {
+            std::cerr << "FAILED: " << what << "\n";
+            ok = false;
+        }
+    };
+
+    // Local API on the main thread: the tag names the repository, so every
+    // caller can tell its own answer apart; "slow-*" never answers
+    QList<qtgh::HttpServer::Responder> hung;
+    qtgh::HttpServer api([&](const qtgh::HttpRequest& req, qtgh::HttpServer::Responder respond) {
+        const QString repo = QString::fromUtf8(req.path).section(QLatin1Char('/'), 3, 3);
+        if (repo.startsWith(QLatin1String("slow-"))) {
+            hung.append(std::move(respond));
+            return;
+        }
+        respond({200, "application/json", {},
+                 QStringLiteral(R"({"tag_name":"v2.%1","published_at":"2026-01-01T00:00:00Z"})")
+                     .arg(repo.section(QLatin1Char('-'), 1))
+                     .toUtf8()});
+    });
+    if (!api.listen()) {
+        std::cerr << "listen failed\n";
+        return 1;
+    }
+    const QString base = QStringLiteral("http://127.0.0.1:%1").arg(api.serverPort());
+    qtgh::ReleaseCache cache;
+    qtgh::CheckOptions options;
+    options.apiBaseUrl = base;
+    options.cache = &cache;
+
+    // 64 caller threads mixing blocking http_get() with futures
+    std::atomic<int> correct{0};
+    std::atomic<int> wrong{0};
+    std::atomic<int> eventLoops{0};
+    QElapsedTimer timer;
+    timer.start();
+    std::vector<std::thread> callers;
+    for (int t = 0; t < kThreads; ++t) {
+        callers.emplace_back([&, t] {
+            try {
+                std::vector<std::pair<QString, std::future<qtgh::UpdateInfo>>> pending;
+                for (int i = 0; i < kChecksPerThread; ++i) {
+                    const QString id = QStringLiteral("%1.%2").arg(t).arg(i);
+                    const QString expected = "v2." + id;
+                    if (i % 2 == 0) {
+                        const QByteArray body =
+                            qtgh::http_get(base + "/repos/o/r-" + id + "/releases/latest");
+                        ++(body.contains(expected.toUtf8()) ? correct : wrong);
+                    } else {
+                        pending.emplace_back(expected, qtgh::check_github_update_async(
+                                                           "https://github.com/o/r-" + id,
+                                                           "1.0.0", options));
+                    }
+                }
+                for (auto& [expected, future] : pending)
+                    ++(future.get().latestVersion == expected ? correct : wrong);
+            } catch (const std::exception& e) {
+                std::cerr << "caller " << t << ": " << e.what() << "\n";
+                ++wrong;
+            }
+            // The caller never ran an event loop of its own
+            if (QAbstractEventDispatcher::instance(QThread::currentThread()))
+                ++eventLoops;
+        });
+    }
+    std::thread joiner([&] {
+        for (std::thread& caller : callers)
+            caller.join();
+        QMetaObject::invokeMethod(&app, &QCoreApplication::quit, Qt::QueuedConnection);
+    });
+    app.exec();
+    joiner.join();
+
+    const int total = kThreads * kChecksPerThread;
+    std::cout << total << " checks from " << kThreads << " threads in " << timer.elapsed()
+              << " ms (" << total * 1000LL / std::max<qint64>(1, timer.elapsed())
+              << " checks/s)\n";
+    expect(correct == total && wrong == 0, "every caller receives its own response");
+    expect(eventLoops == 0, "no event loop is created on caller threads");
+    expect(cache.size() == total / 2, "asynchronous checks fill the cache");
+
+    // Cache hits complete the future at once
+    {
+        auto hit = qtgh::check_github_update_async("https://github.com/o/r-0.1", "1.0.0", options);
+        expect(hit.wait_for(std::chrono::seconds(0)) == std::future_status::ready
+                   && hit.get().latestVersion == "v2.0.1",
+               "cache hit is ready immediately");
+    }
+
+    // A stop from another thread cancels a request on the network thread
+    {
+        std::stop_source source;
+        auto future = qtgh::NetworkThread::instance().get(base + "/repos/o/slow-1/releases/latest",
+                                                          std::chrono::milliseconds(0),
+                                                          source.get_token());
+        std::thread stopper([source]() mutable {
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            source.request_stop();
+        });
+        bool cancelled = false;
+        QElapsedTimer waited;
+        waited.start();
+        while (future.wait_for(std::chrono::milliseconds(1)) != std::future_status::ready
+               && waited.elapsed() < 5000)
+            app.processEvents();
+        try {
+            if (future.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+                future.get();
+        } catch (const qtgh::CancelledError&) {
+            cancelled = true;
+        } catch (const std::exception&) {
+        }
+        stopper.join();
+        expect(cancelled, "stop token cancels a request on the network thread");
+    }
+
+    // shutdown() fails requests still running; the next request restarts the thread
+    {
+        auto stuck = qtgh::NetworkThread::instance().get(base + "/repos/o/slow-2/releases/latest");
+        QElapsedTimer waited;
+        waited.start();
+        while (hung.size() < 2 && waited.elapsed() < 5000)
+            app.processEvents();
+        qtgh::NetworkThread::instance().shutdown();
+        bool stopped = false;
+        try {
+            stuck.get();
+        } catch (const std::runtime_error& e) {
+            stopped = std::strstr(e.what(), "network thread stopped") != nullptr;
+        }
+        expect(stopped, "shutdown fails running requests");
+
+        auto again = qtgh::NetworkThread::instance().get(base + "/repos/o/r-9.9/releases/latest");
+        while (again.wait_for(std::chrono::milliseconds(1)) != std::future_status::ready
+               && waited.elapsed() < 10000)
+            app.processEvents();
+        expect(again.wait_for(std::chrono::seconds(0)) == std::future_status::ready
+                   && again.get().contains("v2.9.9"),
+               "network thread restarts after shutdown");
+    }
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,148 @@
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QTimer>
+#include <iostream>
+#include "qt_gh-batch-checker.hpp"
+#include "qt_gh-http-server.hpp"
+
+int main(int argc, char** argv) {
+    QCoreApplication app(argc, argv);
+    bool ok = true;
+    auto expect = [&ok](bool condition, const char* what) {
+        if (!condition) {
+            std::cerr << "FAILED: " << what << "\n";
+            ok = false;
+        }
+    };
+    using State = qtgh::NetworkStatus::State;
+    using R = QNetworkInformation::Reachability;
+
+    // Reachability policy
+    {
+        const QUrl github("https://api.github.com/repos/o/r/releases/latest");
+        const QUrl loopback("http://127.0.0.1:8080/repos/o/r/releases/latest");
+        const QUrl lanProxy("http://192.168.1.20:8080/repos/o/r/releases/latest");
+        const QUrl lanName("http://ghproxy.local/repos/o/r/releases/latest");
+        expect(qtgh::NetworkStatus::classify(R::Disconnected, github) == State::Offline,
+               "disconnected host is offline");
+        expect(qtgh::NetworkStatus::classify(R::Disconnected, loopback) == State::Online,
+               "loopback proxy stays reachable while disconnected");
+        expect(qtgh::NetworkStatus::classify(R::Local, github) == State::Unknown
+                   && qtgh::NetworkStatus::classify(R::Site, github) == State::Unknown,
+               "local-only connectivity does not fail fast (GitHub may be behind a proxy)");
+        expect(qtgh::NetworkStatus::classify(R::Local, lanProxy) == State::Online
+                   && qtgh::NetworkStatus::classify(R::Local, lanName) == State::Online,
+               "local-only connectivity reaches a proxy on the LAN");
+        expect(qtgh::NetworkStatus::classify(R::Online, github) == State::Online,
+               "online host is online");
+        expect(qtgh::NetworkStatus::classify(R::Unknown, github) == State::Unknown,
+               "unknown reachability is not treated as offline");
+    }
+
+    int requests = 0;
+    qtgh::HttpServer api([&](const qtgh::HttpRequest&, qtgh::HttpServer::Responder respond) {
+        ++requests;
+        respond({200, "application/json", {},
+                 R"({"tag_name":"v2.0.0","published_at":"2026-01-01T00:00:00Z"})"});
+    });
+    if (!api.listen()) {
+        std::cerr << "listen failed\n";
+        return 1;
+    }
+    qtgh::ReleaseCache cache;
+    qtgh::CheckOptions options;
+    options.apiBaseUrl = QStringLiteral("http://127.0.0.1:%1").arg(api.serverPort());
+    options.cache = &cache;
+
+    // Time to failure against an unroutable address (TEST-NET-1): the
+    // request waits for its timeout, the offline check fails at once
+    {
+        qtgh::CheckOptions blackhole;
+        blackhole.apiBaseUrl = QStringLiteral("http://192.0.2.1");
+        blackhole.timeout = std::chrono::milliseconds(1000);
+        blackhole.offlineFastFail = false;
+        QElapsedTimer timer;
+        timer.start();
+        try {
+            qtgh::check_github_update("https://github.com/o/r", "1.0.0", blackhole);
+        } catch (const std::exception&) {
+        }
+        const qint64 waited = timer.elapsed();
+
+        qtgh::NetworkStatus::setOverride(State::Offline);
+        blackhole.offlineFastFail = true;
+        timer.restart();
+        bool offline = false;
+        try {
+            qtgh::check_github_update("https://github.com/o/r", "1.0.0", blackhole);
+        } catch (const qtgh::OfflineError&) {
+            offline = true;
+        }
+        const qint64 fastFail = timer.nsecsElapsed() / 1000;
+        std::cout << "Time to failure: " << waited << " ms waiting for the network, " << fastFail
+                  << " us with offline detection\n";
+        expect(offline && fastFail < 50'000, "offline check fails within 50 ms");
+    }
+
+    // Offline: cached results are still served, uncached checks fail without a request
+    {
+        qtgh::ReleaseRecord cached;
+        cached.tag = "v1.5.0";
+        cached.fetchedAt = QDateTime::currentDateTimeUtc();
+        cached.expiresAt = cached.fetchedAt.addSecs(3600);
+        cache.store("o/cached", cached);
+        expect(qtgh::check_github_update("https://github.com/o/cached", "1.0.0", options)
+                       .latestVersion == "v1.5.0",
+               "cached result is served while offline");
+        bool offline = false;
+        try {
+            qtgh::check_github_update("https://github.com/o/uncached", "1.0.0", options);
+        } catch (const qtgh::OfflineError&) {
+            offline = true;
+        }
+        expect(offline && requests == 0, "uncached check fails without a request");
+    }
+
+    // Batch, OfflinePolicy::Fail: every job fails at once
+    {
+        qtgh::BatchChecker checker(4);
+        checker.setOptions(options);
+        int failed = 0;
+        checker.setResultHandler([&](const qtgh::BatchResult& r) {
+            failed += r.status == qtgh::BatchStatus::Failed && r.error.contains("offline");
+        });
+        for (int i = 0; i < 20; ++i)
+            checker.enqueue({QStringLiteral("https://github.com/o/fail-%1").arg(i), "1.0.0", {}});
+        expect(failed == 20 && checker.inFlight() == 0 && requests == 0,
+               "offline batch jobs fail immediately without requests");
+    }
+
+    // Batch, OfflinePolicy::Wait: jobs stay queued and resume when online
+    {
+        qtgh::BatchChecker checker(4);
+        checker.setOptions(options);
+        checker.setOfflinePolicy(qtgh::OfflinePolicy::Wait);
+        int succeeded = 0;
+        checker.setResultHandler([&](const qtgh::BatchResult& r) {
+            succeeded += r.status == qtgh::BatchStatus::Ok ? 1 : 0;
+        });
+        for (int i = 0; i < 10; ++i)
+            checker.enqueue({QStringLiteral("https://github.com/o/wait-%1").arg(i), "1.0.0", {}});
+        checker.closeInput();
+
+        qsizetype heldBack = -1;
+        QTimer::singleShot(300, [&] {
+            heldBack = checker.pending();
+            qtgh::NetworkStatus::setOverride(std::nullopt);  // loopback is reachable again
+        });
+        QElapsedTimer timer;
+        timer.start();
+        checker.waitForFinished();
+        expect(heldBack == 10 && requests == 10 && succeeded == 10,
+               "queued jobs wait while offline and run once online");
+        expect(timer.elapsed() < 3000, "checks resume within the retry interval");
+    }
+
+    qtgh::NetworkStatus::setOverride(std::nullopt);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,239 @@
+#include <QCoreApplication>
+#include <QEventLoop>
+#include <QTemporaryDir>
+#include <QUrlQuery>
+#include <iostream>
+#include "qt_gh-http-server.hpp"
+#include "qt_gh-release-index.hpp"
+
+/// Fake releases API: one repository whose releases are listed newest first
+struct FakeReleases {
+    struct Release {
+        qint64 id;
+        QString tag;
+        bool prerelease;
+        bool draft;
+    };
+    QList<Release> releases;    // oldest first
+    int revision = 0;           // bumped when a release is edited
+    int requests = 0;
+    int notModified = 0;
+
+    void publish(const QString& tag, bool prerelease = false, bool draft = false) {
+        releases.append({releases.size() + 1000, tag, prerelease, draft});
+    }
+
+    void handle(const qtgh::HttpRequest& req, qtgh::HttpServer::Responder respond) {
+        ++requests;
+        const QUrl url(QString::fromUtf8(req.path));
+        if (url.path() != "/repos/owner/repo/releases") {
+            respond({404, "application/json", {}, R"({"message":"Not Found"})"});
+            return;
+        }
+        const QUrlQuery query(url);
+        const int perPage = query.queryItemValue("per_page").toInt();
+        const int page = query.queryItemValue("page").toInt();
+        const QByteArray etag = QStringLiteral("\"%1.%2-%3-%4\"")
+                                    .arg(releases.size()).arg(revision).arg(perPage).arg(page).toUtf8();
+        if (req.header("if-none-match") == etag) {
+            ++notModified;
+            respond({304, {}, {{"ETag", etag}}, {}});
+            return;
+        }
+        QJsonArray list;
+        const qsizetype first = qsizetype(page - 1) * perPage;
+        for (qsizetype k = first; k < first + perPage && k < releases.size(); ++k) {
+            const Release& r = releases.at(releases.size() - 1 - k);
+            list.append(QJsonObject{{"id", r.id}, {"tag_name", r.tag}, {"prerelease", r.prerelease},
+                                    {"draft", r.draft},
+                                    {"published_at", "2026-01-01T00:00:00Z"}});
+        }
+        QList<QPair<QByteArray, QByteArray>> headers{{"ETag", etag}};
+        if (first + perPage < releases.size())
+            headers.append({"Link", QStringLiteral("<%1?per_page=%2&page=%3>; rel=\"next\"")
+                                        .arg(url.path()).arg(perPage).arg(page + 1).toUtf8()});
+        respond({200, "application/json", headers, QJsonDocument(list).toJson(QJsonDocument::Compact)});
+    }
+};
+
+static qtgh::ReleaseIndexRefresh refresh(qtgh::ReleaseIndex& index, const QString& url) {
+    qtgh::ReleaseIndexRefresh result;
+    QEventLoop loop;
+    index.refresh(url, [&](const qtgh::ReleaseIndexRefresh& r) {
+        result = r;
+        loop.quit();
+    });
+    loop.exec();
+    return result;
+}
+
+int main(int argc, char** argv) {
+    QCoreApplication app(argc, argv);
+    bool ok = true;
+    auto expect = [&ok](bool condition, const char* what) {
+        if (!condition) {
+            std::cerr << "FAILED: " << what << "\n";
+            ok = false;
+        }
+    };
+
+    FakeReleases fake;
+    for (int major = 1; major <= 3; ++major)
+        for (int minor = 0; minor < 10; ++minor)
+            for (int patch = 0; patch < 8; ++patch)
+                fake.publish(QStringLiteral("v%1.%2.%3").arg(major).arg(minor).arg(patch));
+    fake.publish("v4.0.0-rc1", true);
+    fake.publish("nightly");
+    qtgh::HttpServer server([&fake](const qtgh::HttpRequest& req, qtgh::HttpServer::Responder respond) {
+        fake.handle(req, std::move(respond));
+    });
+    if (!server.listen()) {
+        std::cerr << "listen failed\n";
+        return 1;
+    }
+
+    const QString repo = "https://github.com/Owner/Repo";
+    qtgh::ReleaseIndex index;
+    index.setApiBaseUrl(QStringLiteral("http://127.0.0.1:%1/").arg(server.serverPort()));
+
+    // Empty index: all 242 releases in full pages
+    {
+        const auto r = refresh(index, repo);
+        expect(r.error.isEmpty() && r.slug == "owner/repo", "initial refresh succeeds");
+        expect(r.requests == 3 && r.added == 242, "initial refresh lists three pages of 100");
+        const auto history = index.history("owner/repo");
+        expect(history && history->size() == 241 && history->unversioned().size() == 1,
+               "unversioned tags are kept apart");
+    }
+
+    // Queries
+    {
+        const auto history = *index.history("owner/repo");
+        expect(history.countNewerThan(qtgh::SemVer::parse("3.9.7")) == 0, "nothing newer than the latest");
+        expect(history.countNewerThan(qtgh::SemVer::parse("3.9.5")) == 2, "two newer patch releases");
+        expect(history.countNewerThan(qtgh::SemVer::parse("2.9.7")) == 80, "one major behind");
+        expect(history.countNewerThan(qtgh::SemVer::parse("3.9.7"), true) == 1,
+               "pre-releases counted on request");
+        expect(history.latest()->tag == "v3.9.7" && history.latest(true)->tag == "v4.0.0-rc1",
+               "latest with and without pre-releases");
+        expect(history.latestInSeries(2)->tag == "v2.9.7", "best 2.x release");
+        expect(history.latestInSeries(2, 4)->tag == "v2.4.7", "best 2.4.x release");
+        expect(!history.latestInSeries(5) && !history.latestInSeries(0), "missing series");
+        const auto& all = history.releases();
+        expect(std::is_sorted(all.cbegin(), all.cend(),
+                              [](const auto& a, const auto& b) { return a.version < b.version; }),
+               "releases are sorted by version");
+    }
+
+    // Nothing new: one conditional request answered 304
+    {
+        const int before = fake.requests;
+        auto r = refresh(index, repo);      // no ETag of the probe page yet
+        expect(r.error.isEmpty() && r.requests == 1 && r.added == 0 && !r.notModified,
+               "first incremental refresh reads one probe page");
+        r = refresh(index, repo);
+        expect(r.requests == 1 && r.notModified && fake.notModified == 1
+                   && fake.requests == before + 2,
+               "unchanged repository costs one 304");
+    }
+
+    // A few new releases: found on the probe page; drafts are skipped
+    {
+        fake.publish("v4.0.0");
+        fake.publish("v4.0.1");
+        fake.publish("v4.1.0", false, true);
+        const auto r = refresh(index, repo);
+        expect(r.requests == 1 && r.added == 2 && !r.notModified, "new releases on the probe page");
+        expect(index.history("owner/repo")->latest()->tag == "v4.0.1", "new latest release");
+    }
+
+    // Many new releases: continues with full pages until a known one
+    {
+        for (int patch = 2; patch < 152; ++patch)
+            fake.publish(QStringLiteral("v4.0.%1").arg(patch));
+        const auto r = refresh(index, repo);
+        expect(r.requests == 3 && r.added == 150, "probe, then two full pages");
+        const auto history = *index.history("owner/repo");
+        expect(history.countNewerThan(qtgh::SemVer::parse("4.0.0")) == 151
+                   && history.latestInSeries(4)->tag == "v4.0.151",
+               "merged into sort order");
+    }
+
+    // Concurrent refreshes of one repository share the requests
+    {
+        fake.publish("v4.2.0");
+        const int before = fake.requests;
+        int calls = 0;
+        QEventLoop loop;
+        auto done = [&](const qtgh::ReleaseIndexRefresh& r) {
+            expect(r.added == 1, "both callers see the new release");
+            if (++calls == 2)
+                loop.quit();
+        };
+        index.refresh(repo, done);
+        index.refresh("git@github.com:owner/repo.git", done);
+        loop.exec();
+        expect(fake.requests == before + 1, "one request for concurrent refreshes");
+    }
+
+    // Errors leave the history unchanged
+    {
+        const auto r = refresh(index, "https://github.com/owner/missing");
+        expect(!r.error.isEmpty() && !index.history("owner/missing"), "404 is reported");
+    }
+
+    // Persistence
+    {
+        QTemporaryDir dir;
+        const QString path = dir.filePath("releases.json");
+        QString error;
+        expect(index.save(path, &error), "save succeeds");
+        qtgh::ReleaseIndex loaded;
+        loaded.setApiBaseUrl(QStringLiteral("http://127.0.0.1:%1").arg(server.serverPort()));
+        expect(loaded.load(path, &error) && loaded.size() == 1, "load succeeds");
+        const auto a = *index.history("owner/repo");
+        const auto b = *loaded.history("owner/repo");
+        expect(a.size() == b.size() && a.unversioned().size() == b.unversioned().size()
+                   && a.etag() == b.etag() && a.latest(true)->tag == b.latest(true)->tag
+                   && b.latest(true)->publishedAt.isValid(),
+               "history round-trips");
+        const auto r = refresh(loaded, repo);
+        expect(r.notModified && r.requests == 1, "loaded index refreshes with its ETag");
+        expect(loaded.load(dir.filePath("absent.json")), "missing file is empty");
+    }
+
+    // Histories are snapshots
+    {
+        auto snapshot = *index.history("owner/repo");
+        const auto size = snapshot.size();
+        fake.publish("v5.0.0");
+        refresh(index, repo);
+        expect(snapshot.size() == size && index.history("owner/repo")->size() == size + 1,
+               "refresh does not change earlier snapshots");
+    }
+
+    // Pre-release promoted to stable and re-tagged: the known entry is replaced
+    {
+        fake.publish("v5.1.0-rc1", true);
+        auto r = refresh(index, repo);
+        expect(r.added == 1 && r.updated == 0, "pre-release is added");
+        const auto size = index.history("owner/repo")->size();
+        fake.releases.last().tag = "v5.1.0";
+        fake.releases.last().prerelease = false;
+        ++fake.revision;
+        r = refresh(index, repo);
+        expect(r.error.isEmpty() && r.requests == 1 && r.added == 0 && r.updated == 1,
+               "promoted release is refreshed from the probe page");
+        const auto history = *index.history("owner/repo");
+        expect(history.size() == size && history.latest()->tag == "v5.1.0"
+                   && history.countNewerThan(qtgh::SemVer::parse("5.0.0")) == 1,
+               "promoted release counts as stable");
+        expect(std::none_of(history.releases().cbegin(), history.releases().cend(),
+                            [](const auto& release) { return release.tag == "v5.1.0-rc1"; }),
+               "old tag is gone");
+        r = refresh(index, repo);
+        expect(r.notModified && r.updated == 0, "unchanged releases are not rewritten");
+    }
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,93 @@
+#include <cmath>
+#include <iostream>
+#include "qt_gh-release-scheduler.hpp"
+
+int main() {
+    bool ok = true;
+    auto expect = [&ok](bool condition, const char* what) {
+        if (!condition) {
+            std::cerr << "FAILED: " << what << "\n";
+            ok = false;
+        }
+    };
+    using namespace std::chrono_literals;
+    using Scheduler = qtgh::ReleaseScheduler;
+    const Scheduler::TimePoint t0{std::chrono::sys_days{std::chrono::year{2026} / 1 / 1}};
+
+    // New repositories are due at once and handed out only once
+    {
+        Scheduler scheduler;
+        scheduler.addRepo("owner/a", t0);
+        scheduler.addRepo("owner/a", t0);
+        expect(scheduler.size() == 1, "adding twice keeps one repository");
+        expect(scheduler.nextDueTime() == t0, "first check is due immediately");
+        expect(scheduler.takeDue(t0) == QStringList{"owner/a"}, "due repository is taken");
+        expect(scheduler.takeDue(t0).isEmpty() && !scheduler.nextDueTime(),
+               "pending repository is not handed out again");
+        expect(scheduler.state("owner/a")->checkPending, "taken repository awaits its result");
+
+        // Unknown cadence: initial interval, backing off while the tag stays the same
+        scheduler.recordCheck("owner/a", "v1.0.0", t0);
+        expect(scheduler.state("owner/a")->interval == Scheduler::Duration(6h)
+                   && scheduler.nextDueTime() == t0 + 6h,
+               "unknown cadence uses the initial interval");
+        expect(scheduler.takeDue(t0 + 5h).isEmpty(), "nothing is due before the interval");
+        const auto later = t0 + std::chrono::days(30);
+        expect(scheduler.takeDue(later).size() == 1, "repository is due after the interval");
+        scheduler.recordCheck("owner/a", "v1.0.0", later);
+        expect(scheduler.state("owner/a")->interval == Scheduler::Duration(std::chrono::days(3)),
+               "quiet repository backs off to a fraction of the time since its release");
+
+        // Failures retry after the current interval
+        scheduler.takeDue(later + std::chrono::days(3));
+        scheduler.recordFailure("owner/a", later + std::chrono::days(3));
+        expect(scheduler.nextDueTime() == later + std::chrono::days(6), "failure retries after the interval");
+    }
+
+    // Daily releases: polled every tenth of a day
+    {
+        Scheduler scheduler;
+        scheduler.addRepo("owner/daily", t0);
+        for (int day = 0; day < 5; ++day) {
+            const auto now = t0 + std::chrono::days(day);
+            expect(scheduler.takeDue(now) == QStringList{"owner/daily"}, "daily repository is due");
+            scheduler.recordCheck("owner/daily", QStringLiteral("v1.0.%1").arg(day), now, now);
+        }
+        const auto* st = scheduler.state("owner/daily");
+        expect(st->releasesObserved == 4 && std::abs(st->meanIntervalSec - 86400.0) < 1.0,
+               "cadence is learned from release times");
+        expect(st->interval == Scheduler::Duration(8640), "interval is pollFraction of the cadence");
+    }
+
+    // Dormant repository: clamped to maxInterval; frequent releases: to minInterval
+    {
+        Scheduler scheduler;
+        scheduler.addRepo("owner/dormant", t0);
+        scheduler.addRepo("owner/busy", t0);
+        expect(scheduler.takeDue(t0, 1).size() == 1 && scheduler.takeDue(t0).size() == 1,
+               "takeDue() honours its limit");
+        scheduler.recordCheck("owner/dormant", "v0.1", t0, t0 - std::chrono::days(365));
+        scheduler.recordCheck("owner/busy", "v1", t0, t0);
+        expect(scheduler.state("owner/dormant")->interval == Scheduler::Duration(std::chrono::days(7)),
+               "dormant repository is polled at the maximum interval");
+        expect(scheduler.state("owner/busy")->interval == Scheduler::Duration(15min),
+               "interval is at least the minimum");
+        expect(scheduler.nextDueTime() == t0 + 15min, "earliest repository comes first");
+
+        // Removed repositories leave no stale queue entries behind
+        scheduler.removeRepo("owner/busy");
+        expect(!scheduler.contains("owner/busy") && scheduler.nextDueTime() == t0 + std::chrono::days(7),
+               "removed repository is no longer scheduled");
+        expect(scheduler.takeDue(t0 + std::chrono::days(7)) == QStringList{"owner/dormant"},
+               "only the remaining repository is due");
+    }
+
+    // Release times from the API
+    {
+        const QDateTime published = QDateTime::fromString("2026-01-01T00:00:00Z", Qt::ISODate);
+        expect(Scheduler::fromQDateTime(published) == t0, "QDateTime converts to a time point");
+        expect(!Scheduler::fromQDateTime(QDateTime()), "invalid QDateTime has no time point");
+    }
+
+    return ok ? 0 : 1;
+}
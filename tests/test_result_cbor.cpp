@@ -0,0 +1,177 @@
+#include <QBuffer>
+#include <QCoreApplication>
+#include <QTimeZone>
+#include <iostream>
+#include "qt_gh-result-cbor.hpp"
+
+static qtgh::BatchResult makeResult(int i) {
+    qtgh::BatchResult r;
+    r.job = {QStringLiteral("https://github.com/owner/repo-%1").arg(i), "1.0.0",
+             i % 2 ? QStringLiteral("CMakeLists.txt:%1").arg(i) : QString()};
+    switch (i % 5) {
+    case 0:
+    case 1:
+        r.status = qtgh::BatchStatus::Ok;
+        r.info.latestVersion = QStringLiteral("1.%1.0").arg(i);
+        r.info.hasUpdate = i % 2 == 0;
+        if (i % 5 == 0)
+            r.info.publishedAt = QDateTime(QDate(2026, 1, 1), QTime(12, 0), QTimeZone::UTC).addDays(i);
+        break;
+    case 2:
+        r.status = qtgh::BatchStatus::Failed;
+        r.error = "Network error: \"quoted\" \\ ü\n";
+        r.cached = true;
+        break;
+    case 3:
+        r.status = qtgh::BatchStatus::TimedOut;
+        r.error = "deadline reached";
+        break;
+    default:
+        r.status = qtgh::BatchStatus::Cancelled;
+        r.error = "Cancelled";
+        break;
+    }
+    return r;
+}
+
+static bool same(const qtgh::BatchResult& a, const qtgh::BatchResult& b) {
+    return a.job.repoUrl == b.job.repoUrl && a.job.localVersion == b.job.localVersion
+           && a.job.origin == b.job.origin && a.status == b.status
+           && a.info.latestVersion == b.info.latestVersion && a.info.hasUpdate == b.info.hasUpdate
+           && a.info.publishedAt == b.info.publishedAt && a.error == b.error
+           && a.cached == b.cached;
+}
+
+int main(int argc, char** argv) {
+    QCoreApplication app(argc, argv);
+    bool ok = true;
+    auto expect = [&ok](bool condition, const char* what) {
+        if (!condition) {
+            std::cerr << "FAILED: " << what << "\n";
+            ok = false;
+        }
+    };
+
+    // Streamed to a device, one map per result
+    QBuffer buffer;
+    buffer.open(QIODevice::WriteOnly);
+    {
+        QCborStreamWriter writer(&buffer);
+        for (int i = 0; i < 20; ++i)
+            qtgh::writeCborResult(writer, makeResult(i));
+    }
+    const QByteArray data = buffer.data();
+
+    {
+        qtgh::CborResultReader reader(data);
+        int decoded = 0;
+        bool equal = true;
+        while (auto result = reader.next())
+            equal = equal && same(*result, makeResult(decoded++));
+        expect(decoded == 20 && equal, "every status round-trips");
+        expect(!reader.truncated() && reader.offset() == data.size(), "clean end of data");
+    }
+
+    // Records are self-contained: concatenating encodings is the same sequence
+    {
+        QByteArray joined;
+        for (int i = 0; i < 20; ++i)
+            joined += qtgh::encodeCborResult(makeResult(i));
+        expect(joined == data, "encodeCborResult() matches the streamed encoding");
+    }
+
+    // Sub-second publication times use a floating-point epoch
+    {
+        qtgh::BatchResult r = makeResult(0);
+        r.info.publishedAt = r.info.publishedAt.addMSecs(250);
+        qtgh::CborResultReader reader(qtgh::encodeCborResult(r));
+        const auto back = reader.next();
+        expect(back && back->info.publishedAt == r.info.publishedAt, "millisecond timestamps");
+    }
+
+    // A producer killed mid-record: everything before it is returned
+    {
+        const QByteArray last = qtgh::encodeCborResult(makeResult(19));
+        const qsizetype prefix = data.size() - last.size();
+        bool allCuts = true;
+        for (qsizetype cut = 1; cut < last.size(); ++cut) {
+            qtgh::CborResultReader reader(data.left(prefix + cut));
+            int decoded = 0;
+            try {
+                while (reader.next())
+                    ++decoded;
+            } catch (const std::exception& e) {
+                std::cerr << "cut " << cut << ": " << e.what() << "\n";
+                allCuts = false;
+            }
+            allCuts = allCuts && decoded == 19 && reader.truncated() && reader.offset() == prefix;
+        }
+        expect(allCuts, "truncated last record is reported, not thrown");
+    }
+
+    // Unknown keys from newer writers are skipped
+    {
+        QByteArray extended;
+        QCborStreamWriter writer(&extended);
+        writer.startMap(3);
+        writer.append(QLatin1StringView("repo"));
+        writer.append(QLatin1StringView("https://github.com/o/r"));
+        writer.append(QLatin1StringView("assets"));
+        writer.startArray(2);
+        writer.append(qint64(1));
+        writer.append(QLatin1StringView("two"));
+        writer.endArray();
+        writer.append(QLatin1StringView("remote"));
+        writer.append(QLatin1StringView("v2.0.0"));
+        writer.endMap();
+        qtgh::CborResultReader reader(extended);
+        const auto result = reader.next();
+        expect(result && result->info.latestVersion == "v2.0.0"
+                   && result->status == qtgh::BatchStatus::Ok && !reader.next(),
+               "unknown keys are skipped");
+    }
+
+    // Malformed input throws
+    {
+        auto throws = [](const QByteArray& bytes) {
+            try {
+                qtgh::CborResultReader reader(bytes);
+                while (reader.next()) {
+                }
+            } catch (const std::runtime_error&) {
+                return true;
+            }
+            return false;
+        };
+        QByteArray noRepo;
+        {
+            QCborStreamWriter writer(&noRepo);
+            writer.startMap(1);
+            writer.append(QLatin1StringView("local"));
+            writer.append(QLatin1StringView("1.0.0"));
+            writer.endMap();
+        }
+        QByteArray wrongType;
+        {
+            QCborStreamWriter writer(&wrongType);
+            writer.startMap(2);
+            writer.append(QLatin1StringView("repo"));
+            writer.append(QLatin1StringView("https://github.com/o/r"));
+            writer.append(QLatin1StringView("update"));
+            writer.append(QLatin1StringView("yes"));
+            writer.endMap();
+        }
+        expect(throws(QByteArray("\x01", 1)), "top-level integer is rejected");
+        expect(throws(QByteArray("\x82\x01\x02", 3)), "top-level array is rejected");
+        expect(throws(noRepo), "map without repo is rejected");
+        expect(throws(wrongType), "value of the wrong type is rejected");
+    }
+
+    // Empty input is an empty sequence
+    {
+        qtgh::CborResultReader reader(QByteArray{});
+        expect(!reader.next() && !reader.truncated(), "empty input has no records");
+    }
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,155 @@
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <iostream>
+#include <thread>
+#include "qt_gh-result-model.hpp"
+
+static qtgh::BatchResult makeResult(int i, const QString& latest) {
+    qtgh::BatchResult r;
+    r.job = {QStringLiteral("https://github.com/owner/repo-%1").arg(i), "1.0.0", {}};
+    r.status = qtgh::BatchStatus::Ok;
+    r.info.latestVersion = latest;
+    r.info.hasUpdate = true;
+    return r;
+}
+
+/// Run the event loop until the model's flush timer has fired
+static void waitForFlush(const qtgh::ResultTableModel& model, int rows) {
+    QElapsedTimer timer;
+    timer.start();
+    while (model.rowCount() < rows && timer.elapsed() < 2000)
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 20);
+}
+
+int main(int argc, char** argv) {
+    QCoreApplication app(argc, argv);
+    bool ok = true;
+    auto expect = [&ok](bool condition, const char* what) {
+        if (!condition) {
+            std::cerr << "FAILED: " << what << "\n";
+            ok = false;
+        }
+    };
+
+    // A burst of results becomes one insert
+    {
+        qtgh::ResultTableModel model;
+        int inserts = 0, inserted = 0;
+        QObject::connect(&model, &QAbstractItemModel::rowsInserted,
+                         [&](const QModelIndex&, int first, int last) {
+                             ++inserts;
+                             inserted += last - first + 1;
+                         });
+        for (int i = 0; i < 1000; ++i)
+            model.append(makeResult(i, "v2.0.0"));
+        expect(model.rowCount() == 0, "nothing is inserted before the flush");
+        waitForFlush(model, 1000);
+        expect(model.rowCount() == 1000 && inserts == 1 && inserted == 1000,
+               "1000 results arrive as one rowsInserted");
+        expect(model.data(model.index(5, qtgh::ResultTableModel::Repository)).toString()
+                       == "https://github.com/owner/repo-5"
+                   && model.data(model.index(5, qtgh::ResultTableModel::Status)).toString()
+                          == "Update available",
+               "display text");
+
+        // Re-checks replace their rows and are reported as one range
+        int changes = 0, firstRow = -1, lastRow = -1;
+        QObject::connect(&model, &QAbstractItemModel::dataChanged,
+                         [&](const QModelIndex& topLeft, const QModelIndex& bottomRight) {
+                             ++changes;
+                             firstRow = topLeft.row();
+                             lastRow = bottomRight.row();
+                         });
+        for (int i : {40, 10, 700}) {
+            auto r = makeResult(i, "v2.0.0");
+            r.status = qtgh::BatchStatus::Failed;
+            r.error = "Network error";
+            model.append(r);
+        }
+        model.append(makeResult(1000, "v2.0.0"));
+        model.flush();
+        expect(model.rowCount() == 1001 && inserts == 2, "new key in the same flush is inserted");
+        expect(changes == 1 && firstRow == 10 && lastRow == 700, "one dataChanged over the re-checked rows");
+        expect(model.data(model.index(40, qtgh::ResultTableModel::Status)).toString() == "Failed"
+                   && model.data(model.index(40, 0), Qt::ToolTipRole).toString() == "Network error",
+               "re-checked row shows the new result");
+
+        // Same repository spelled differently is the same row
+        auto respelled = makeResult(3, "v2.0.0");
+        respelled.job.repoUrl = "git@github.com:owner/repo-3.git";
+        model.append(respelled);
+        model.flush();
+        expect(model.rowCount() == 1001, "rows are keyed by normalized slug");
+
+        model.clear();
+        expect(model.rowCount() == 0, "clear() removes all rows");
+    }
+
+    // Sorting compares parsed versions, not strings
+    {
+        qtgh::ResultTableModel model;
+        const QStringList tags = {"v9.0.0", "v10.0.0", "nightly", "v1.2.10", "v1.2.9", "2.0"};
+        for (int i = 0; i < tags.size(); ++i)
+            model.append(makeResult(i, tags.at(i)));
+        model.flush();
+        const QPersistentModelIndex tracked = model.index(0, qtgh::ResultTableModel::Latest);
+        model.sort(qtgh::ResultTableModel::Latest, Qt::AscendingOrder);
+        QStringList sorted;
+        for (int row = 0; row < model.rowCount(); ++row)
+            sorted << model.data(model.index(row, qtgh::ResultTableModel::Latest)).toString();
+        expect(sorted == QStringList({"nightly", "v1.2.9", "v1.2.10", "2.0", "v9.0.0", "v10.0.0"}),
+               "ascending SemVer order, unparsable first");
+        expect(tracked.row() == 4 && tracked.data().toString() == "v9.0.0",
+               "persistent indexes follow their rows");
+        expect(model.data(model.index(5, qtgh::ResultTableModel::Latest),
+                          qtgh::ResultTableModel::SortRole).toULongLong()
+                   > model.data(model.index(4, qtgh::ResultTableModel::Latest),
+                                qtgh::ResultTableModel::SortRole).toULongLong(),
+               "SortRole exposes the parsed order");
+
+        // Later batches are merged into place
+        model.sort(qtgh::ResultTableModel::Latest, Qt::DescendingOrder);
+        model.append(makeResult(10, "v9.5.0"));
+        model.append(makeResult(11, "v0.1.0"));
+        model.append(makeResult(12, "v11.0.0"));
+        model.flush();
+        sorted.clear();
+        for (int row = 0; row < model.rowCount(); ++row)
+            sorted << model.data(model.index(row, qtgh::ResultTableModel::Latest)).toString();
+        expect(sorted == QStringList({"v11.0.0", "v10.0.0", "v9.5.0", "v9.0.0", "2.0", "v1.2.10",
+                                      "v1.2.9", "v0.1.0", "nightly"}),
+               "new rows are merged into the sort order");
+
+        // A re-check that changes the version moves the row
+        model.append(makeResult(11, "v12.0.0"));
+        model.flush();
+        expect(model.data(model.index(0, qtgh::ResultTableModel::Latest)).toString() == "v12.0.0",
+               "re-checked row is re-sorted");
+
+        // Invalid column turns sorting off; new rows are appended
+        model.sort(-1);
+        model.append(makeResult(20, "v99.0.0"));
+        model.flush();
+        expect(model.data(model.index(model.rowCount() - 1, qtgh::ResultTableModel::Latest)).toString()
+                   == "v99.0.0",
+               "unsorted model appends");
+    }
+
+    // append() from worker threads
+    {
+        qtgh::ResultTableModel model;
+        model.setFlushInterval(std::chrono::milliseconds(0));
+        std::vector<std::thread> workers;
+        for (int t = 0; t < 4; ++t)
+            workers.emplace_back([&model, t] {
+                for (int i = 0; i < 250; ++i)
+                    model.append(makeResult(t * 250 + i, "v1.0.0"));
+            });
+        for (auto& worker : workers)
+            worker.join();
+        waitForFlush(model, 1000);
+        expect(model.rowCount() == 1000, "results appended from other threads arrive");
+    }
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,72 @@
+#include <QCoreApplication>
+#include <iostream>
+#include <vector>
+#include "qt_gh-batch-checker.hpp"
+
+int main(int argc, char** argv) {
+    QCoreApplication app(argc, argv);
+    bool ok = true;
+
+    // Specification parsing: one-based on the command line, zero-based inside
+    const auto shard = qtgh::Shard::parse("3/8");
+    if (shard.index != 2 || shard.count != 8) {
+        std::cerr << "Shard::parse(\"3/8\") returned " << shard.index << "/" << shard.count << "\n";
+        ok = false;
+    }
+    for (const char* bad : {"0/4", "5/4", "1/0", "1", "a/b", "1/2/3"}) {
+        try {
+            qtgh::Shard::parse(bad);
+            std::cerr << "Invalid specification accepted: " << bad << "\n";
+            ok = false;
+        } catch (const std::runtime_error&) {
+        }
+    }
+
+    // Assignments are fixed across processes, platforms and releases
+    if (qtgh::stableSlugHash("nlohmann/json") != 0x52276e78158f4361ULL
+        || qtgh::jumpConsistentHash(qtgh::stableSlugHash("nlohmann/json"), 8) != 6
+        || qtgh::jumpConsistentHash(qtgh::stableSlugHash("qt/qtbase"), 16) != 15) {
+        std::cerr << "Shard assignment changed\n";
+        ok = false;
+    }
+
+    // Every URL spelling of a repository lands on the same shard
+    const auto a = qtgh::toRepoSlug("https://github.com/NLohmann/json.git");
+    const auto b = qtgh::toRepoSlug("git@github.com:nlohmann/json");
+    if (a != b) {
+        std::cerr << "Slug normalization differs: " << a.toStdString() << " vs "
+                  << b.toStdString() << "\n";
+        ok = false;
+    }
+
+    // Balanced distribution, and growing 8 -> 9 shards only moves keys to the new shard
+    constexpr int kRepos = 20000;
+    std::vector<int> perShard(8, 0);
+    int moved = 0;
+    for (int i = 0; i < kRepos; ++i) {
+        const quint64 key = qtgh::stableSlugHash(QStringLiteral("owner%1/repo%2").arg(i % 97).arg(i));
+        const int before = qtgh::jumpConsistentHash(key, 8);
+        const int after = qtgh::jumpConsistentHash(key, 9);
+        ++perShard[static_cast<std::size_t>(before)];
+        if (before != after) {
+            ++moved;
+            if (after != 8) {
+                std::cerr << "Key moved between existing shards\n";
+                ok = false;
+                break;
+            }
+        }
+    }
+    for (int count : perShard) {
+        if (count < kRepos / 8 * 9 / 10 || count > kRepos / 8 * 11 / 10) {
+            std::cerr << "Unbalanced shard with " << count << " repositories\n";
+            ok = false;
+        }
+    }
+    if (moved < kRepos / 9 * 8 / 10 || moved > kRepos / 9 * 12 / 10) {
+        std::cerr << "Unexpected number of moved keys: " << moved << "\n";
+        ok = false;
+    }
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,137 @@
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include "qt_gh-http-server.hpp"
+#include "qt_gh-subscription-service.hpp"
+
+/// Run the event loop until pred() holds or timeoutMs elapsed
+template <typename Pred>
+static bool waitUntil(Pred pred, int timeoutMs = 10000) {
+    QElapsedTimer timer;
+    timer.start();
+    while (!pred()) {
+        if (timer.elapsed() > timeoutMs)
+            return false;
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    QCoreApplication app(argc, argv);
+    bool ok = true;
+    auto expect = [&ok](bool condition, const char* what) {
+        if (!condition) {
+            std::cerr << "FAILED: " << what << "\n";
+            ok = false;
+        }
+    };
+
+    // Local API: latest tag per repository, request count per repository
+    QHash<QString, QString> latest{{"owner/app", "v1.0.0"}, {"owner/lib", "v0.9.0"}};
+    QHash<QString, int> requests;
+    qtgh::HttpServer api([&](const qtgh::HttpRequest& req, qtgh::HttpServer::Responder respond) {
+        const QString slug = QString::fromUtf8(req.path).section(QLatin1Char('/'), 2, 3);
+        ++requests[slug];
+        respond({200, "application/json", {},
+                 R"({"tag_name":")" + latest.value(slug).toUtf8()
+                     + R"(","published_at":"2026-01-01T00:00:00Z"})"});
+    });
+    if (!api.listen()) {
+        std::cerr << "listen failed\n";
+        return 1;
+    }
+    qtgh::CheckOptions options;
+    options.apiBaseUrl = QStringLiteral("http://127.0.0.1:%1").arg(api.serverPort());
+
+    // Poll every second so that a new tag is picked up during the test
+    qtgh::ReleaseScheduler::Config schedule;
+    schedule.initialInterval = schedule.minInterval = schedule.maxInterval = std::chrono::seconds(1);
+    auto service = std::make_unique<qtgh::SubscriptionService>(schedule);
+    service->setOptions(options);
+    const QString name = QStringLiteral("qtgh-test-%1").arg(QCoreApplication::applicationPid());
+    if (!service->listen(name)) {
+        std::cerr << "listen failed: " << service->errorString().toStdString() << "\n";
+        return 1;
+    }
+
+    struct Received {
+        int subscribed = 0;
+        QStringList releases;   ///< "repo tag"
+    };
+    auto attach = [&](qtgh::SubscriptionClient& client, Received& received) {
+        client.setMessageHandler([&received](const QJsonObject& msg) {
+            if (msg["event"].toString() == "subscribed")
+                ++received.subscribed;
+        });
+        client.setReleaseHandler([&received](const QString& repo, const QString& tag) {
+            received.releases.append(repo + ' ' + tag);
+        });
+        return client.connectToService(name);
+    };
+
+    // Two clients subscribe to the same repository: one poll for both
+    qtgh::SubscriptionClient first;
+    Received firstReceived;
+    auto second = std::make_unique<qtgh::SubscriptionClient>();
+    Received secondReceived;
+    expect(attach(first, firstReceived) && attach(*second, secondReceived), "clients connect");
+    first.subscribe({"https://github.com/owner/app"});
+    second->subscribe({"git@github.com:Owner/App.git", "https://github.com/owner/lib"});
+    expect(waitUntil([&] { return firstReceived.subscribed == 1 && secondReceived.subscribed == 1; }),
+           "subscriptions are acknowledged");
+    expect(service->clientCount() == 2 && service->repoCount() == 2, "repositories are tracked once");
+    expect(waitUntil([&] {
+               return service->latestTag("owner/app") == "v1.0.0" && service->latestTag("owner/lib") == "v0.9.0";
+           }),
+           "first poll sets the baseline");
+    expect(requests.value("owner/app") == 1 && requests.value("owner/lib") == 1,
+           "each repository is polled once per round");
+    expect(firstReceived.releases.isEmpty() && secondReceived.releases.isEmpty(), "baseline is not pushed");
+
+    // New tag upstream: pushed to the subscribers of that repository only
+    latest["owner/lib"] = "v1.0.0";
+    expect(waitUntil([&] { return !secondReceived.releases.isEmpty(); }), "new tag is pushed");
+    expect(secondReceived.releases == QStringList{"owner/lib v1.0.0"}, "subscriber receives the new tag");
+    expect(firstReceived.releases.isEmpty(), "other clients are not notified");
+    expect(service->stats().notifications == 1 && service->stats().messagesSent == 1, "one message sent");
+    const int appPolls = requests.value("owner/app");
+    const int libPolls = requests.value("owner/lib");
+    expect(std::abs(appPolls - libPolls) <= 1, "shared repository is not polled per subscriber");
+
+    // Injected release: fanned out to both subscribers of owner/app
+    service->notifyRelease("owner/app", {"v1.1.0", QDateTime::currentDateTimeUtc(), {}, {}});
+    expect(waitUntil([&] { return !firstReceived.releases.isEmpty() && secondReceived.releases.size() == 2; }),
+           "injected release reaches every subscriber");
+    expect(firstReceived.releases == QStringList{"owner/app v1.1.0"}, "injected tag is pushed");
+
+    // Disconnect: repositories without subscribers are dropped
+    second.reset();
+    expect(waitUntil([&] { return service->clientCount() == 1; }), "disconnected client is dropped");
+    expect(service->repoCount() == 1 && service->latestTag("owner/lib").isEmpty(),
+           "repository without subscribers is no longer polled");
+
+    // A line without '\n' beyond the limit: error, then disconnect
+    {
+        QLocalSocket flood;
+        flood.connectToServer(name);
+        expect(waitUntil([&] { return flood.state() == QLocalSocket::ConnectedState; }), "flooding client connects");
+        bool closed = false;
+        QObject::connect(&flood, &QLocalSocket::disconnected, [&] { closed = true; });
+        flood.write(QByteArray(qtgh::SubscriptionService::kMaxLineLength + 1024, 'x'));
+        expect(waitUntil([&] { return closed; }), "client with an oversized line is disconnected");
+        expect(flood.readAll().contains("Line too long"), "oversized line is reported");
+        expect(waitUntil([&] { return service->clientCount() == 1; }), "rejected client is dropped");
+    }
+
+    // Shutdown with a connected client
+    bool disconnected = false;
+    QObject::connect(&first.socket(), &QLocalSocket::disconnected, [&] { disconnected = true; });
+    service.reset();
+    expect(waitUntil([&] { return disconnected; }), "clients are disconnected on shutdown");
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,112 @@
+#include <QCoreApplication>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSet>
+#include <QTemporaryDir>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include "qt_gh-trace.hpp"
+
+int main(int argc, char** argv) {
+    QCoreApplication app(argc, argv);
+
+    QTemporaryDir dir;
+    if (!dir.isValid())
+        return 1;
+    bool ok = true;
+
+    // Nothing is recorded unless a recorder is installed
+    if (qtgh::TraceRecorder::active()) {
+        std::cerr << "Recorder active by default\n";
+        ok = false;
+    }
+
+    qtgh::TraceRecorder trace(16);
+    trace.install();
+    if (qtgh::TraceRecorder::active() != &trace)
+        ok = false;
+
+    // Four threads, 10 spans each; one async check with two phases
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([] {
+            for (int i = 0; i < 10; ++i) {
+                const qint64 begin = qtgh::TraceRecorder::now();
+                qtgh::TraceRecorder::active()->complete("parse", begin, begin + 1000);
+            }
+        });
+    }
+    for (auto& t : threads)
+        t.join();
+
+    // Ring buffer: 23 events on this thread, capacity 16 -> 7 oldest dropped
+    const qint64 t0 = qtgh::TraceRecorder::now();
+    for (int i = 0; i < 20; ++i)
+        trace.complete("compare", t0, t0 + 10);
+
+    const quint64 id = trace.nextId();
+    trace.async("queue", id, t0, t0 + 5000);
+    trace.async("request", id, t0 + 5000, t0 + 9000);
+    trace.async("check", id, t0, t0 + 9000, "https://github.com/owner/\"quoted\"");
+    if (trace.dropped() != 7) {
+        std::cerr << "Expected 7 dropped events, got " << trace.dropped() << "\n";
+        ok = false;
+    }
+
+    trace.uninstall();
+    if (qtgh::TraceRecorder::active()) {
+        std::cerr << "Recorder still active after uninstall\n";
+        ok = false;
+    }
+
+    const QString path = dir.filePath("trace.json");
+    QString error;
+    if (!trace.writeChromeTrace(path, &error)) {
+        std::cerr << "writeChromeTrace failed: " << error.toStdString() << "\n";
+        return 1;
+    }
+
+    // The output is valid JSON in the Chrome trace event format
+    QFile file(path);
+    file.open(QIODevice::ReadOnly);
+    QJsonParseError parseError{};
+    const auto doc = QJsonDocument::fromJson(file.readAll(), &parseError);
+    if (parseError.error != QJsonParseError::NoError) {
+        std::cerr << "Invalid trace JSON: " << parseError.errorString().toStdString() << "\n";
+        return 1;
+    }
+
+    int complete = 0, begins = 0, ends = 0, metadata = 0;
+    QSet<int> tids;
+    bool quotedDetail = false;
+    for (const auto& value : doc["traceEvents"].toArray()) {
+        const auto ev = value.toObject();
+        const QString ph = ev["ph"].toString();
+        tids.insert(ev["tid"].toInt());
+        if (ph == "X")
+            ++complete;
+        else if (ph == "b")
+            ++begins;
+        else if (ph == "e")
+            ++ends;
+        else if (ph == "M")
+            ++metadata;
+        if (ev["args"].toObject()["detail"].toString() == "https://github.com/owner/\"quoted\"")
+            quotedDetail = true;
+        if (ev["ts"].toDouble() < 0)
+            ok = false;
+    }
+
+    // 40 parse spans + 16 kept on the main thread (3 async + 13 compare)
+    if (complete != 40 + 13 || begins != 3 || ends != 3 || metadata != 5 || tids.size() != 5
+        || !quotedDetail) {
+        std::cerr << "Unexpected trace contents: X=" << complete << " b=" << begins
+                  << " e=" << ends << " M=" << metadata << " tids=" << tids.size() << "\n";
+        ok = false;
+    }
+
+    return ok ? 0 : 1;
+}
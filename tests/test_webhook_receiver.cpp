@@ -0,0 +1,108 @@
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QNetworkProxy>
+#include <QTimer>
+#include <iostream>
+#include "qt_gh-webhook-receiver.hpp"
+
+static const QByteArray kSecret = "test-secret";
+
+static QByteArray releasePayload(const char* action, const char* tag) {
+    return QByteArray(R"({"action":")") + action + R"(","release":{"tag_name":")" + tag
+         + R"(","published_at":"2026-03-01T12:00:00Z","draft":false,"prerelease":false},)"
+           R"("repository":{"full_name":"Owner/Repo"}})";
+}
+
+/// Send a webhook delivery and return the HTTP status code
+static int deliver(QNetworkAccessManager& mgr, quint16 port, const QByteArray& body,
+                   const QByteArray& secret) {
+    QNetworkRequest req(QUrl(QStringLiteral("http://127.0.0.1:%1/webhook").arg(port)));
+    req.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
+    req.setRawHeader("X-GitHub-Event", "release");
+    req.setRawHeader("X-Hub-Signature-256", "sha256=" + QMessageAuthenticationCode::hash(
+        body, secret, QCryptographicHash::Sha256).toHex());
+
+    QNetworkReply* reply = mgr.post(req, body);
+    QEventLoop loop;
+    QObject::connect(reply, &QNetworkReply::finished, &loop, &QEventLoop::quit);
+    loop.exec();
+    reply->deleteLater();
+    return reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+}
+
+int main(int argc, char** argv) {
+    QCoreApplication app(argc, argv);
+
+    qtgh::ReleaseCache cache;
+    qtgh::WebhookReceiver receiver(cache, kSecret);
+    if (!receiver.listen()) {
+        std::cerr << "listen failed: " << receiver.errorString().toStdString() << "\n";
+        return 1;
+    }
+
+    QElapsedTimer timer;
+    qint64 eventToCacheNs = -1;
+    receiver.setReleaseHandler([&](const QString&, const qtgh::ReleaseRecord&) {
+        eventToCacheNs = timer.nsecsElapsed();
+    });
+
+    QNetworkAccessManager mgr;
+    mgr.setProxy(QNetworkProxy::NoProxy);
+    bool ok = true;
+
+    // Wrong secret: rejected, cache untouched
+    if (deliver(mgr, receiver.serverPort(), releasePayload("published", "v1.0.0"), "wrong") != 401
+        || cache.lookup("owner/repo")) {
+        std::cerr << "Delivery with invalid signature was accepted\n";
+        ok = false;
+    }
+
+    // Valid delivery: cache updated
+    timer.start();
+    const int status = deliver(mgr, receiver.serverPort(), releasePayload("published", "v2.1.0"), kSecret);
+    const auto cached = cache.lookup("owner/repo");
+    if (status != 204 || !cached || cached->tag != "v2.1.0") {
+        std::cerr << "Valid delivery did not update the cache (status " << status << ")\n";
+        ok = false;
+    }
+    if (cached && !qtgh::compareRelease(*cached, "2.0.0").hasUpdate) {
+        std::cerr << "Cached release not reported as update\n";
+        ok = false;
+    }
+
+    // Deleted release: entry invalidated
+    if (deliver(mgr, receiver.serverPort(), releasePayload("deleted", "v2.1.0"), kSecret) != 204
+        || cache.lookup("owner/repo")) {
+        std::cerr << "Deleted release was not invalidated\n";
+        ok = false;
+    }
+
+    // Malformed request: one error response, later input is discarded
+    {
+        QTcpSocket socket;
+        socket.setProxy(QNetworkProxy::NoProxy);
+        QByteArray received;
+        QEventLoop loop;
+        QObject::connect(&socket, &QTcpSocket::connected, &loop, [&] {
+            socket.write("GARBAGE\r\n\r\n");
+            socket.write("more garbage\r\n\r\n");
+        });
+        QObject::connect(&socket, &QTcpSocket::readyRead, &loop, [&] {
+            received += socket.readAll();
+            socket.write("GET /webhook HTTP/1.1\r\n\r\n");
+        });
+        QObject::connect(&socket, &QTcpSocket::disconnected, &loop, &QEventLoop::quit);
+        QTimer::singleShot(5000, &loop, &QEventLoop::quit);
+        socket.connectToHost(QHostAddress::LocalHost, receiver.serverPort());
+        loop.exec();
+        if (!received.startsWith("HTTP/1.1 400 ") || received.count("HTTP/1.1 ") != 1
+            || socket.state() != QAbstractSocket::UnconnectedState) {
+            std::cerr << "Malformed request was not answered once and closed:\n" << received.toStdString() << "\n";
+            ok = false;
+        }
+    }
+
+    std::cout << "Event to cache update: " << eventToCacheNs / 1000 << " us\n";
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,68 @@
+#!/usr/bin/env bash
+# SPDX-License-Identifier: MIT
+# SPDX-FileCopyrightText: 2026 Zheng-Bote
+#
+# measure-include-cost.sh - Compile time of a TU including qt_gh-update-checker.hpp
+#
+# Compiles a small translation unit that calls check_github_update()
+# `runs` times in each mode and prints the best wall time:
+#   header-only   everything inline, as before the compiled variant
+#   compiled      -DQTGH_COMPILED_LIBRARY (declarations only)
+#   header + PCH  header-only, with the header precompiled (GCC/Clang)
+# Qt's compile flags come from pkg-config (Qt6Network).
+#
+# Usage:
+#   tools/measure-include-cost.sh [runs] [compiler]
+#   CXXFLAGS=-O2 tools/measure-include-cost.sh 10 clang++
+
+set -euo pipefail
+
+runs=${1:-5}
+cxx=${2:-${CXX:-c++}}
+root=$(cd "$(dirname "$0")/.." && pwd)
+qtflags=$(pkg-config --cflags Qt6Network)
+work=$(mktemp -d)
+trap 'rm -rf "$work"' EXIT
+
+cat >"$work/tu.cpp" <<'TU'
+#include "qt_gh-update-checker.hpp"
+
+bool hasUpdate(const QString& repo) {
+    return qtgh::check_github_update(repo, QStringLiteral("1.0.0")).hasUpdate;
+}
+TU
+
+flags=(-std=c++23 -fPIC -I"$root/include" ${CXXFLAGS:-} $qtflags)
+
+# Best of `runs` compiles of tu.cpp, in ms
+best() {
+    local best_ms=
+    for ((i = 0; i < runs; ++i)); do
+        local start end ms
+        start=$(date +%s%N)
+        "$cxx" "$@" "${flags[@]}" -c "$work/tu.cpp" -o "$work/tu.o"
+        end=$(date +%s%N)
+        ms=$(((end - start) / 1000000))
+        if [[ -z $best_ms || $ms -lt $best_ms ]]; then best_ms=$ms; fi
+    done
+    echo "$best_ms"
+}
+
+printf '%s, best of %d\n\n' "$("$cxx" --version | head -n1)" "$runs"
+header=$(best)
+compiled=$(best -DQTGH_COMPILED_LIBRARY)
+printf '%-14s %6d ms\n' "header-only" "$header" "compiled" "$compiled"
+
+# Clang takes -include-pch; GCC uses "<header>.gch" from an include
+# directory searched before the one holding the header
+mkdir -p "$work/pch"
+if "$cxx" --version | grep -qi clang; then
+    "$cxx" "${flags[@]}" -x c++-header "$root/include/qt_gh-update-checker.hpp" \
+        -o "$work/pch/qt_gh-update-checker.hpp.pch"
+    pch=$(best -include-pch "$work/pch/qt_gh-update-checker.hpp.pch")
+else
+    "$cxx" "${flags[@]}" -x c++-header "$root/include/qt_gh-update-checker.hpp" \
+        -o "$work/pch/qt_gh-update-checker.hpp.gch"
+    pch=$(best -Winvalid-pch -I"$work/pch")
+fi
+printf '%-14s %6d ms\n' "header + PCH" "$pch"